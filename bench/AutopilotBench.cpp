@@ -0,0 +1,167 @@
+// Autopilot decisions per second on synthetic square boards: 3% wall cells, eight items and a snake half
+// as long as the board is wide. "reuse" follows planned paths as the game does; "replan" forces a full
+// search on every move to show what path reuse saves. Build the autopilot_bench target in Release.
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <vector>
+#include "utils/GameRandom.hpp"
+#include "utils/autopilot/Autopilot.hpp"
+
+namespace {
+constexpr int DECISIONS = 20'000;
+constexpr int ITEM_COUNT = 8;
+
+struct BenchResult {
+  double decisionsPerSecond = 0.0;
+  double searchesPerDecision = 0.0;
+  int itemsEaten = 0;
+  int crashes = 0;
+};
+
+class Board {
+public:
+  Board(int size, uint64_t seed) : size(size), occupied(static_cast<size_t>(size * size), 0), random(seed) {
+    for (int i = 0; i < size * size * 3 / 100; ++i) {
+      occupied[cell(randomPosition())] = WALL;
+    }
+  }
+
+  BenchResult run(bool replanEveryMove) {
+    Autopilot autopilot(size, size);
+    for (int i = 0; i < size * size; ++i) {
+      if (occupied[i] == WALL) {
+        autopilot.setBlocked(sf::Vector2i(i % size, i / size));
+      }
+    }
+    respawnSnake(autopilot);
+    while (static_cast<int>(items.size()) < ITEM_COUNT) {
+      spawnItem();
+    }
+    autopilot.setTargets(items);
+
+    BenchResult result;
+    Snake::Direction direction = Snake::Direction::Right;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < DECISIONS; ++i) {
+      if (replanEveryMove) {
+        autopilot.setTargets(items);
+      }
+      direction = autopilot.decide(direction).value_or(direction);
+
+      const sf::Vector2i head = body.front() + offset(direction);
+      const bool leavesTail = head != body.back();
+      if (!inside(head) || occupied[cell(head)] == WALL || (occupied[cell(head)] == BODY && leavesTail)) {
+        result.crashes++;
+        respawnSnake(autopilot);
+        direction = Snake::Direction::Right;
+        continue;
+      }
+
+      bool ate = false;
+      for (auto& item : items) {
+        if (item.cell == head) {
+          ate = true;
+          item.cell = sf::Vector2i(-1, -1);
+        }
+      }
+      if (!ate) {
+        occupied[cell(body.back())] = EMPTY;
+        body.pop_back();
+      }
+      body.push_front(head);
+      occupied[cell(head)] = BODY;
+      autopilot.advanceHead(head, static_cast<int>(body.size()));
+
+      if (ate) {
+        result.itemsEaten++;
+        std::erase_if(items, [](const AutopilotTarget& item) { return item.cell.x < 0; });
+        spawnItem();
+        autopilot.setTargets(items);
+      }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    result.decisionsPerSecond = DECISIONS / elapsed.count();
+    result.searchesPerDecision = static_cast<double>(autopilot.getSearchCount()) / DECISIONS;
+    return result;
+  }
+
+private:
+  static constexpr uint8_t EMPTY = 0;
+  static constexpr uint8_t WALL = 1;
+  static constexpr uint8_t BODY = 2;
+
+  int size;
+  std::vector<uint8_t> occupied;
+  std::deque<sf::Vector2i> body;
+  std::vector<AutopilotTarget> items;
+  Xoshiro256 random;
+
+  [[nodiscard]] int cell(sf::Vector2i position) const { return position.y * size + position.x; }
+  [[nodiscard]] bool inside(sf::Vector2i position) const {
+    return position.x >= 0 && position.y >= 0 && position.x < size && position.y < size;
+  }
+  sf::Vector2i randomPosition() {
+    const auto bound = static_cast<uint32_t>(size);
+    return sf::Vector2i(static_cast<int>(boundedRandom(random, bound)), static_cast<int>(boundedRandom(random, bound)));
+  }
+
+  static sf::Vector2i offset(Snake::Direction direction) {
+    switch (direction) {
+      case Snake::Direction::Up:
+        return sf::Vector2i(0, -1);
+      case Snake::Direction::Down:
+        return sf::Vector2i(0, 1);
+      case Snake::Direction::Left:
+        return sf::Vector2i(-1, 0);
+      case Snake::Direction::Right:
+        return sf::Vector2i(1, 0);
+    }
+    return sf::Vector2i(0, 0);
+  }
+
+  void spawnItem() {
+    sf::Vector2i position = randomPosition();
+    while (occupied[cell(position)] != EMPTY) {
+      position = randomPosition();
+    }
+    items.push_back(AutopilotTarget{position, static_cast<float>(10 + boundedRandom(random, 90))});
+  }
+
+  // a straight snake along a free stretch of a random row, head to the right
+  void respawnSnake(Autopilot& autopilot) {
+    for (const auto& segment : body) {
+      occupied[cell(segment)] = EMPTY;
+    }
+    body.clear();
+
+    const int length = size;
+    while (body.empty()) {
+      const int row = static_cast<int>(boundedRandom(random, static_cast<uint32_t>(size)));
+      int run = 0;
+      for (int x = 0; x < size && run < length; ++x) {
+        run = occupied[row * size + x] == EMPTY ? run + 1 : 0;
+        if (run == length / 2) {
+          for (int i = 0; i < run; ++i) {
+            body.push_back(sf::Vector2i(x - i, row));
+            occupied[row * size + x - i] = BODY;
+          }
+        }
+      }
+    }
+    autopilot.resetBody(std::vector<sf::Vector2i>(body.begin(), body.end()));
+  }
+};
+}  // namespace
+
+int main() {
+  std::printf("%-8s %-7s %14s %14s %8s %8s\n", "board", "mode", "decisions/s", "searches/dec", "eaten", "crashes");
+  for (const int size : {32, 64, 128, 256, 512}) {
+    for (const bool replan : {false, true}) {
+      Board board(size, 42);
+      const BenchResult result = board.run(replan);
+      std::printf("%3dx%-4d %-7s %14.0f %14.3f %8d %8d\n", size, size, replan ? "replan" : "reuse",
+                  result.decisionsPerSecond, result.searchesPerDecision, result.itemsEaten, result.crashes);
+    }
+  }
+}
@@ -0,0 +1,216 @@
+#pragma once
+// Minimal benchmark harness: warmup, a batch size calibrated so one sample outlasts the clock's resolution,
+// a fixed number of samples, and the median and percentiles of time per call. Results print as a table
+// and optionally go to a JSON file for comparing runs.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace bench {
+
+// keeps the compiler from proving a benchmarked result unused
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+struct Options {
+  int samples = 31;
+  std::chrono::milliseconds warmup{50};
+  std::chrono::microseconds minSampleTime{2000};
+  std::string filter;
+  std::string jsonPath;
+};
+
+struct Result {
+  std::string name;
+  uint64_t iterationsPerSample = 0;
+  int samples = 0;
+  double minNs = 0.0;
+  double medianNs = 0.0;
+  double p90Ns = 0.0;
+  double p99Ns = 0.0;
+  double maxNs = 0.0;
+  double meanNs = 0.0;
+  // every sample in ns per call, in the order taken; bench_compare tests these against a baseline run
+  std::vector<double> samplesNs;
+};
+
+class Harness {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit Harness(Options options) : options(std::move(options)) {
+    std::printf("%-48s %10s %10s %10s %10s %10s\n", "benchmark", "min ns", "median ns", "p90 ns", "p99 ns", "iters");
+  }
+
+  // --samples N, --warmup-ms N, --min-sample-us N, --filter substring, --json path; nullopt on bad arguments
+  static std::optional<Options> parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+      const std::string argument = argv[i];
+      if (i + 1 >= argc) {
+        return std::nullopt;
+      }
+      const std::string value = argv[++i];
+      if (argument == "--samples") {
+        options.samples = std::max(1, std::stoi(value));
+      } else if (argument == "--warmup-ms") {
+        options.warmup = std::chrono::milliseconds(std::stoi(value));
+      } else if (argument == "--min-sample-us") {
+        options.minSampleTime = std::chrono::microseconds(std::stoi(value));
+      } else if (argument == "--filter") {
+        options.filter = value;
+      } else if (argument == "--json") {
+        options.jsonPath = value;
+      } else {
+        return std::nullopt;
+      }
+    }
+    return options;
+  }
+
+  [[nodiscard]] bool isSelected(const std::string& name) const {
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+  }
+
+  // For calls that leave the state as they found it (or close enough): fn runs in calibrated batches.
+  template <typename Fn>
+  void run(const std::string& name, Fn&& fn) {
+    if (!isSelected(name)) {
+      return;
+    }
+
+    const auto warmupEnd = Clock::now() + options.warmup;
+    uint64_t batch = 1;
+    while (true) {
+      const auto start = Clock::now();
+      for (uint64_t i = 0; i < batch; ++i) {
+        fn();
+      }
+      const auto elapsed = Clock::now() - start;
+      if (elapsed >= options.minSampleTime && Clock::now() >= warmupEnd) {
+        break;
+      }
+      if (elapsed < options.minSampleTime) {
+        batch *= 2;
+      }
+    }
+
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(options.samples));
+    for (int sample = 0; sample < options.samples; ++sample) {
+      const auto start = Clock::now();
+      for (uint64_t i = 0; i < batch; ++i) {
+        fn();
+      }
+      samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() /
+                        static_cast<double>(batch));
+    }
+    record(name, batch, std::move(samples));
+  }
+
+  // For calls that change what they measure (a spawn fills the board): setup restores the state, untimed,
+  // before every single timed call, so each sample is one call and many more samples are taken.
+  template <typename Setup, typename Fn>
+  void runWithSetup(const std::string& name, Setup&& setup, Fn&& fn, int samplesPerRun = 2000) {
+    if (!isSelected(name)) {
+      return;
+    }
+
+    const auto warmupEnd = Clock::now() + options.warmup;
+    do {
+      setup();
+      fn();
+    } while (Clock::now() < warmupEnd);
+
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(samplesPerRun));
+    for (int sample = 0; sample < samplesPerRun; ++sample) {
+      setup();
+      const auto start = Clock::now();
+      fn();
+      samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+    }
+    record(name, 1, std::move(samples));
+  }
+
+  [[nodiscard]] const std::vector<Result>& getResults() const { return results; }
+
+  bool writeJson() const {
+    if (options.jsonPath.empty()) {
+      return true;
+    }
+
+    nlohmann::json benchmarks = nlohmann::json::array();
+    for (const Result& result : results) {
+      benchmarks.push_back({{"name", result.name},
+                            {"iterations_per_sample", result.iterationsPerSample},
+                            {"samples", result.samples},
+                            {"min_ns", result.minNs},
+                            {"median_ns", result.medianNs},
+                            {"p90_ns", result.p90Ns},
+                            {"p99_ns", result.p99Ns},
+                            {"max_ns", result.maxNs},
+                            {"mean_ns", result.meanNs},
+                            {"samples_ns", result.samplesNs}});
+    }
+
+    std::ofstream file(options.jsonPath, std::ios::trunc);
+    file << nlohmann::json{{"benchmarks", benchmarks}}.dump(2) << '\n';
+    if (!file) {
+      std::fprintf(stderr, "Failed to write %s\n", options.jsonPath.c_str());
+      return false;
+    }
+    return true;
+  }
+
+private:
+  Options options;
+  std::vector<Result> results;
+
+  // nearest-rank percentile of sorted samples
+  static double percentile(const std::vector<double>& sorted, double fraction) {
+    const auto rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size()) + 0.999999);
+    return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+  }
+
+  void record(const std::string& name, uint64_t iterationsPerSample, std::vector<double> samples) {
+    Result result;
+    result.samplesNs = samples;
+    std::sort(samples.begin(), samples.end());
+    result.name = name;
+    result.iterationsPerSample = iterationsPerSample;
+    result.samples = static_cast<int>(samples.size());
+    result.minNs = samples.front();
+    result.medianNs = percentile(samples, 0.5);
+    result.p90Ns = percentile(samples, 0.9);
+    result.p99Ns = percentile(samples, 0.99);
+    result.maxNs = samples.back();
+    double sum = 0.0;
+    for (const double sample : samples) {
+      sum += sample;
+    }
+    result.meanNs = sum / static_cast<double>(samples.size());
+
+    std::printf("%-48s %10.1f %10.1f %10.1f %10.1f %10llu\n", name.c_str(), result.minNs, result.medianNs, result.p90Ns,
+                result.p99Ns, static_cast<unsigned long long>(iterationsPerSample));
+    std::fflush(stdout);
+    results.push_back(std::move(result));
+  }
+};
+
+}  // namespace bench
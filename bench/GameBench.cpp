@@ -0,0 +1,365 @@
+// Micro-benchmarks of the simulation hot paths and a few helpers the screens call every frame. Nothing opens
+// a window or loads a texture, so it runs headless. Build the game_bench target in Release; see
+// BenchHarness.hpp for the options (--filter, --samples, --json ...).
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include "BenchHarness.hpp"
+#include "MultiplayerSimulation.hpp"
+#include "PackedSnakeBody.hpp"
+#include "Snake.hpp"
+#include "utils/Digits.hpp"
+#include "utils/GameGrid.hpp"
+#include "utils/GameItemManager.hpp"
+#include "utils/GameSnapshot.hpp"
+#include "utils/Logger.hpp"
+#include "utils/SettingStorage.hpp"
+#include "utils/WallManager.hpp"
+#include "utils/difficulty/DifficultyPresets.hpp"
+#include "utils/net/NetProtocol.hpp"
+
+namespace {
+constexpr int GRID_SIZE = 32;
+const sf::Vector2i CENTRE(GRID_SIZE / 2, GRID_SIZE / 2);
+
+// the Hard preset with the wall and item caps lifted, so fill levels are limited only by the board
+DifficultySettings makeUncappedSettings() {
+  DifficultyPreset preset = DIFFICULTY_PRESETS[static_cast<size_t>(GameDifficultyLevel::Hard)];
+  preset.wallCount = 255;
+  preset.maxItemsOnBoard = 255;
+  DifficultySettings settings;
+  settings.applyPreset(preset);
+  return settings;
+}
+
+struct World {
+  GameGrid grid{GRID_SIZE, GRID_SIZE, 824.0f, sf::Vector2f(0, 0), 1.0f, 912.0f};
+  DifficultySettings settings = makeUncappedSettings();
+  GameRandom random{42};
+  WallManager walls{grid, settings, random};
+  GameItemManager items{grid, settings, random, walls};
+  Snake snake{CENTRE, 4};
+
+  void addWalls(int count) {
+    for (int attempt = 0; walls.getWallCount() < count && attempt < count * 50; ++attempt) {
+      walls.tryGenerateWall(snake);
+    }
+  }
+};
+
+void benchSnake(bench::Harness& harness) {
+  for (const int length : {4, 32, 256, 1024}) {
+    Snake snake(CENTRE, length);
+    int step = 0;
+    // turns every eight moves, so the head circles a small square instead of running off forever
+    harness.run("Snake::move/length=" + std::to_string(length), [&] {
+      if (++step % 8 == 0) {
+        constexpr Snake::Direction TURNS[] = {Snake::Direction::Down, Snake::Direction::Left, Snake::Direction::Up,
+                                              Snake::Direction::Right};
+        snake.setDirection(TURNS[(step / 8) % 4]);
+      }
+      snake.move();
+      bench::doNotOptimize(snake.getHead());
+    });
+  }
+
+  // render preparation: the sprite type and rotation of every segment, worked out from the neighbours as
+  // render used to and read from the cache move() keeps
+  {
+    constexpr int LENGTH = 10000;
+    Snake snake(CENTRE, LENGTH);
+    constexpr Snake::Direction TURNS[] = {Snake::Direction::Down, Snake::Direction::Left, Snake::Direction::Up,
+                                          Snake::Direction::Right};
+    for (int step = 1; step <= LENGTH; ++step) {
+      if (step % 8 == 0) {
+        snake.setDirection(TURNS[(step / 8) % 4]);
+      }
+      snake.move();
+    }
+
+    harness.run("Snake::segmentOrientations/recompute/length=" + std::to_string(LENGTH), [&] {
+      float sum = 0.0f;
+      for (int i = 0; i < snake.getLength(); ++i) {
+        sum += snake.computeSegmentOrientation(i).rotation;
+      }
+      bench::doNotOptimize(sum);
+    });
+    harness.run("Snake::segmentOrientations/cached/length=" + std::to_string(LENGTH), [&] {
+      float sum = 0.0f;
+      for (const Snake::SegmentOrientation& orientation : snake.getSegmentOrientations()) {
+        sum += orientation.rotation;
+      }
+      bench::doNotOptimize(sum);
+    });
+  }
+
+  // a straight snake never hits itself, so every check scans the whole body
+  for (const int length : {4, 32, 256, 1024}) {
+    const Snake snake(CENTRE, length);
+    harness.run("Snake::checkSelfCollision/length=" + std::to_string(length),
+                [&] { bench::doNotOptimize(snake.checkSelfCollision()); });
+  }
+}
+
+// a snake of any length coiled into a square spiral around the centre, head on the outside
+std::vector<sf::Vector2i> makeSpiral(int length) {
+  std::vector<sf::Vector2i> cells;
+  cells.reserve(static_cast<size_t>(length));
+  sf::Vector2i cell(0, 0);
+  constexpr sf::Vector2i TURNS[] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+  for (int run = 1, turn = 0; static_cast<int>(cells.size()) < length; ++turn) {
+    for (int i = 0; i < run && static_cast<int>(cells.size()) < length; ++i) {
+      cells.push_back(cell);
+      cell += TURNS[turn % 4];
+    }
+    run += turn % 2;
+  }
+  std::reverse(cells.begin(), cells.end());
+  return cells;
+}
+
+void benchPackedSnake(bench::Harness& harness) {
+  constexpr int GIANT = 1 << 20;
+  for (const int length : {1024, GIANT}) {
+    const std::string name = "PackedSnakeBody::move/length=" + std::to_string(length);
+    if (!harness.isSelected(name)) {
+      continue;
+    }
+    const std::vector<sf::Vector2i> cells = makeSpiral(length);
+    auto body = PackedSnakeBody::fromCells(cells);
+    if (length == GIANT) {
+      std::printf("%d segments: %zu bytes packed, %zu as std::vector<sf::Vector2i>\n", length, body->getMemoryBytes(),
+                  cells.size() * sizeof(sf::Vector2i));
+    }
+
+    int step = 0;
+    harness.run(name, [&] {
+      constexpr PackedSnakeBody::Step TURNS[] = {PackedSnakeBody::Step::Down, PackedSnakeBody::Step::Left,
+                                                 PackedSnakeBody::Step::Up, PackedSnakeBody::Step::Right};
+      body->move(TURNS[(++step / 8) % 4], false);
+      bench::doNotOptimize(body->getTail());
+    });
+  }
+
+  const auto body = PackedSnakeBody::fromCells(makeSpiral(1024));
+  harness.run("PackedSnakeBody::cells/length=1024", [&] {
+    sf::Vector2i sum(0, 0);
+    for (const sf::Vector2i cell : *body) {
+      sum += cell;
+    }
+    bench::doNotOptimize(sum);
+  });
+  harness.run("PackedSnakeBody::segmentRotations/length=1024", [&] {
+    float sum = 0.0f;
+    for (size_t i = 1; i < body->getLength(); ++i) {
+      sum += body->getSegmentRotation(i);
+    }
+    bench::doNotOptimize(sum);
+  });
+}
+
+void benchItems(bench::Harness& harness) {
+  for (const int itemCount : {0, 8, 32}) {
+    World world;
+    world.addWalls(8);
+    const auto fill = [&] {
+      world.items.clear();
+      while (world.items.getItemCount() < itemCount) {
+        world.items.spawnRandomItem(world.snake);
+      }
+    };
+    harness.runWithSetup("GameItemManager::spawnRandomItem/items=" + std::to_string(itemCount), fill,
+                         [&] { bench::doNotOptimize(world.items.spawnRandomItem(world.snake)); });
+
+    fill();
+    int cell = 0;
+    harness.run("GameItemManager::checkCollision/items=" + std::to_string(itemCount), [&] {
+      cell = (cell + 7) % (GRID_SIZE * GRID_SIZE);
+      bench::doNotOptimize(world.items.checkCollision(sf::Vector2i(cell % GRID_SIZE, cell / GRID_SIZE)));
+    });
+  }
+}
+
+void benchWalls(bench::Harness& harness) {
+  for (const int wallCount : {0, 8, 16, 32}) {
+    World world;
+    world.addWalls(wallCount);
+    GameSnapshot snapshot;
+    SnapshotWriter writer(snapshot);
+    world.walls.saveState(writer);
+
+    harness.runWithSetup(
+        "WallManager::tryGenerateWall/walls=" + std::to_string(world.walls.getWallCount()),
+        [&] {
+          SnapshotReader reader(snapshot);
+          world.walls.restoreState(reader);
+        },
+        [&] { bench::doNotOptimize(world.walls.tryGenerateWall(world.snake)); });
+  }
+}
+
+void benchGrid(bench::Harness& harness) {
+  GameGrid grid(GRID_SIZE, GRID_SIZE, 824.0f, sf::Vector2f(0, 0), 1.0f, 912.0f);
+  float scale = 1.0f;
+  harness.run("GameGrid::updateGrid", [&] {
+    scale = scale > 1.5f ? 1.0f : scale + 0.01f;
+    grid.updateGrid(sf::Vector2f(10.0f, 20.0f), scale);
+    bench::doNotOptimize(grid.getCellPosition(GRID_SIZE - 1, GRID_SIZE - 1));
+  });
+}
+
+void benchDigits(bench::Harness& harness) {
+  int number = 0;
+  Digits::NumberBuffer buffer;
+  harness.run("Digits::formatNumber", [&] {
+    number = (number + 37) % 100000;
+    bench::doNotOptimize(Digits::formatNumber(number, 0, buffer));
+  });
+  harness.run("Digits::formatNumber/padded", [&] {
+    number = (number + 37) % 100000;
+    bench::doNotOptimize(Digits::formatNumber(number, 6, buffer));
+  });
+}
+
+// eight players turning at random on a 128x128 board, a minute into the game so the snakes have grown and
+// walls and items are out; prints the bytes a state takes whole and as deltas, then times encode and decode
+void benchStateDelta(bench::Harness& harness) {
+  constexpr int PLAYERS = 8;
+  constexpr int BOARD = 128;
+  const std::string suffix = "/players=" + std::to_string(PLAYERS) + ",board=" + std::to_string(BOARD);
+  const std::string captureName = "NetProtocol::captureState" + suffix;
+  const std::string encodeName = "StateDelta::encode" + suffix;
+  const std::string encodeWholeName = "StateDelta::encode/whole" + suffix;
+  const std::string decodeName = "StateDelta::decode" + suffix;
+  if (!harness.isSelected(captureName) && !harness.isSelected(encodeName) && !harness.isSelected(encodeWholeName) &&
+      !harness.isSelected(decodeName)) {
+    return;
+  }
+
+  MultiplayerConfig config;
+  config.seed = 7;
+  config.cols = BOARD;
+  config.rows = BOARD;
+  config.maxPlayers = PLAYERS;
+  MultiplayerSimulation simulation(config);
+  for (int i = 0; i < PLAYERS; ++i) {
+    simulation.addPlayer();
+  }
+  Xoshiro256 steering(7);
+  const auto tick = [&] {
+    for (uint16_t id = 0; id < PLAYERS; ++id) {
+      if (boundedRandom(steering, 20) == 0) {
+        simulation.setDirection(id, static_cast<Snake::Direction>(boundedRandom(steering, 4)));
+      }
+    }
+    simulation.tick();
+  };
+  constexpr int MINUTE = 60 * MultiplayerSimulation::TICKS_PER_SECOND;
+  for (int i = 0; i < MINUTE; ++i) {
+    tick();
+  }
+
+  // the last four ticks, so a state has both the tick before and the one three back (a 20 Hz broadcast)
+  std::vector<NetBoardState> states(4);
+  std::vector<uint8_t> bytes;
+  uint64_t wholeBytes = 0;
+  uint64_t tickDeltaBytes = 0;
+  uint64_t broadcastDeltaBytes = 0;
+  int broadcasts = 0;
+  for (int i = 0; i < MINUTE; ++i) {
+    tick();
+    NetBoardState& state = states[static_cast<size_t>(i) % states.size()];
+    NetProtocol::captureState(simulation, state);
+    PacketWriter writer(bytes);
+    NetProtocol::writeState(writer, nullptr, state);
+    wholeBytes += bytes.size();
+    if (i >= 3) {
+      PacketWriter tickWriter(bytes);
+      NetProtocol::writeState(tickWriter, &states[static_cast<size_t>(i - 1) % states.size()], state);
+      tickDeltaBytes += bytes.size();
+    }
+    if (i >= 3 && i % 3 == 0) {
+      PacketWriter broadcastWriter(bytes);
+      NetProtocol::writeState(broadcastWriter, &states[static_cast<size_t>(i - 3) % states.size()], state);
+      broadcastDeltaBytes += bytes.size();
+      broadcasts++;
+    }
+  }
+  std::printf("%d snakes on %dx%d, bytes per state: %.1f whole, %.1f as a delta from the tick before, "
+              "%.1f from three ticks before\n",
+              PLAYERS, BOARD, BOARD, static_cast<double>(wholeBytes) / MINUTE,
+              static_cast<double>(tickDeltaBytes) / (MINUTE - 3),
+              static_cast<double>(broadcastDeltaBytes) / broadcasts);
+
+  // a move apart, the common case for a 20 Hz broadcast
+  const NetBoardState& current = states[(MINUTE - 1) % states.size()];
+  const NetBoardState& baseline = states[(MINUTE - 4) % states.size()];
+  NetBoardState captured;
+  harness.run(captureName, [&] {
+    NetProtocol::captureState(simulation, captured);
+    bench::doNotOptimize(captured.players.size());
+  });
+  harness.run(encodeName, [&] {
+    PacketWriter writer(bytes);
+    NetProtocol::writeState(writer, &baseline, current);
+    bench::doNotOptimize(bytes.size());
+  });
+  harness.run(encodeWholeName, [&] {
+    PacketWriter writer(bytes);
+    NetProtocol::writeState(writer, nullptr, current);
+    bench::doNotOptimize(bytes.size());
+  });
+
+  PacketWriter writer(bytes);
+  NetProtocol::writeState(writer, &baseline, current);
+  NetBoardState decoded;
+  harness.run(decodeName, [&] {
+    PacketReader reader(bytes);
+    NetProtocol::readType(reader);
+    const auto header = NetProtocol::readStateHeader(reader);
+    bench::doNotOptimize(NetProtocol::readState(reader, *header, &baseline, decoded));
+  });
+}
+
+// loads from a scratch directory, so the bench never touches the settings.json next to the game
+void benchSettings(bench::Harness& harness) {
+  if (!harness.isSelected("SettingStorage::loadSettings")) {
+    return;
+  }
+
+  const std::filesystem::path previousDirectory = std::filesystem::current_path();
+  const std::filesystem::path scratch = std::filesystem::temp_directory_path() / "game_bench";
+  std::filesystem::create_directories(scratch);
+  std::filesystem::current_path(scratch);
+  {
+    SettingStorage storage;
+    storage.loadSettings();
+    harness.run("SettingStorage::loadSettings", [&] { bench::doNotOptimize(storage.loadSettings()); });
+  }
+  std::filesystem::current_path(previousDirectory);
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto options = bench::Harness::parseOptions(argc, argv);
+  if (!options) {
+    std::fprintf(stderr,
+                 "usage: game_bench [--filter substring] [--samples N] [--warmup-ms N] [--min-sample-us N] "
+                 "[--json path]\n");
+    return 2;
+  }
+
+  bench::Harness harness(*options);
+  benchSnake(harness);
+  benchPackedSnake(harness);
+  benchItems(harness);
+  benchWalls(harness);
+  benchGrid(harness);
+  benchDigits(harness);
+  benchStateDelta(harness);
+  benchSettings(harness);
+
+  const bool written = harness.writeJson();
+  Logger::getInstance().shutdown();
+  return written ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+// Search throughput of the MCTS bot by thread count. Each run plays the same seeded game for a fixed number of
+// decisions at the default per-tick budget and reports rollouts and tree nodes per second, with the speed-up
+// over one thread. Build the mcts_bench target in Release.
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "utils/autopilot/MctsBot.hpp"
+#include "utils/replay/ReplayPlayer.hpp"
+
+namespace {
+constexpr int DECISIONS = 1'000;
+constexpr uint64_t SEED = 42;
+
+MctsSearchStats run(unsigned threads, int& score) {
+  SimulationConfig config;
+  config.seed = SEED;
+  config.difficulty = GameDifficultyLevel::Middle;
+  config.countdownSeconds = 0;
+
+  GameSimulation simulation(config);
+  MctsBot bot(threads);
+  int decisions = 0;
+  while (decisions < DECISIONS && !simulation.isGameOver()) {
+    if (const auto input = bot.update(simulation)) {
+      ReplayPlayer::applyInput(simulation, *input);
+    }
+    decisions++;
+    simulation.tick();
+  }
+  score = simulation.getScore();
+  return bot.getTotalStats();
+}
+}  // namespace
+
+int main() {
+  const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<unsigned> threadCounts;
+  for (unsigned threads = 1; threads < hardwareThreads; threads *= 2) {
+    threadCounts.push_back(threads);
+  }
+  threadCounts.push_back(hardwareThreads);
+
+  std::printf("%-8s %14s %14s %10s %8s\n", "threads", "iterations/s", "nodes/s", "speed-up", "score");
+  double baseline = 0.0;
+  for (const unsigned threads : threadCounts) {
+    int score = 0;
+    const MctsSearchStats stats = run(threads, score);
+    const double iterationsPerSecond = static_cast<double>(stats.iterations) / stats.seconds;
+    if (baseline == 0.0) {
+      baseline = iterationsPerSecond;
+    }
+    std::printf("%-8u %14.0f %14.0f %9.2fx %8d\n", threads, iterationsPerSecond,
+                static_cast<double>(stats.nodes) / stats.seconds, iterationsPerSecond / baseline, score);
+  }
+}
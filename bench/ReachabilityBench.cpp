@@ -0,0 +1,53 @@
+// Time of one BitGrid::floodFill from the board centre for a few board sizes and wall densities, plus a
+// serpentine corridor that forces one sweep per bend. Build the reachability_bench target in Release.
+#include <chrono>
+#include <cstdio>
+#include "utils/BitGrid.hpp"
+#include "utils/GameRandom.hpp"
+
+namespace {
+volatile int sink = 0;
+
+double measure(const BitGrid& open, sf::Vector2i start, int iterations) {
+  BitGrid reachable(open.getCols(), open.getRows());
+  const auto begin = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    BitGrid::floodFill(open, start, reachable);
+  }
+  const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+  sink = sink + reachable.count();
+  return elapsed.count() / iterations;
+}
+}  // namespace
+
+int main() {
+  std::printf("%-10s %-14s %10s\n", "board", "walls", "us/fill");
+  for (const int size : {32, 128, 256, 512}) {
+    for (const int density : {0, 5, 15, 30}) {
+      BitGrid open(size, size);
+      open.fill();
+      Xoshiro256 random(static_cast<uint64_t>(size * 100 + density));
+      for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+          if (boundedRandom(random, 100) < static_cast<uint32_t>(density)) {
+            open.reset(sf::Vector2i(x, y));
+          }
+        }
+      }
+      const sf::Vector2i centre(size / 2, size / 2);
+      open.set(centre);
+      std::printf("%4dx%-5d %3d%% random    %10.2f\n", size, size, density, measure(open, centre, 200'000 / size));
+    }
+  }
+
+  BitGrid corridor(128, 128);
+  corridor.fill();
+  for (int y = 1; y < 128; y += 2) {
+    for (int x = 0; x < 128; ++x) {
+      if (x != ((y / 2) % 2 == 0 ? 127 : 0)) {
+        corridor.reset(sf::Vector2i(x, y));
+      }
+    }
+  }
+  std::printf("%4dx%-5d %-14s %10.2f\n", 128, 128, "serpentine", measure(corridor, sf::Vector2i(0, 0), 2000));
+}
@@ -0,0 +1,59 @@
+// Compares the gameplay RNG against the std::mt19937 + distribution pattern it replaced.
+// Build the rng_bench target in Release and run it; every case draws the same number of values.
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include "utils/GameRandom.hpp"
+
+namespace {
+constexpr int DRAWS = 20'000'000;
+volatile int64_t sink = 0;
+
+template <typename Body>
+void measure(const char* name, Body&& body) {
+  int64_t sum = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < DRAWS; ++i) {
+    sum += body(i);
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  sink = sink + sum;
+  const double nanos = std::chrono::duration<double, std::nano>(elapsed).count() / DRAWS;
+  std::printf("%-44s %6.2f ns/draw\n", name, nanos);
+}
+}  // namespace
+
+int main() {
+  std::printf("state size: mt19937 %zu bytes, Xoshiro256 %zu bytes, GameRandom %zu bytes\n\n",
+              sizeof(std::mt19937), sizeof(Xoshiro256), sizeof(GameRandom));
+
+  std::mt19937 legacy(12345);
+  GameRandom random(12345);
+  Xoshiro256 xoshiro(12345);
+
+  // WallManager: a fresh uniform_int_distribution per call over a varying candidate count
+  measure("mt19937 + uniform_int_distribution", [&](int i) {
+    std::uniform_int_distribution<int> distribution(0, 900 + (i & 63));
+    return distribution(legacy);
+  });
+  measure("GameRandom::nextInt", [&](int i) { return random.nextInt(RandomStream::Walls, 0, 900 + (i & 63)); });
+  measure("Xoshiro256 + uniform_int_distribution", [&](int i) {
+    std::uniform_int_distribution<int> distribution(0, 900 + (i & 63));
+    return distribution(xoshiro);
+  });
+
+  // GameItemManager: a fresh uniform_real_distribution per spawn roll
+  measure("mt19937 + uniform_real_distribution", [&](int) {
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    return static_cast<int64_t>(distribution(legacy) * 1000.0f);
+  });
+  measure("GameRandom::nextFloat", [&](int) {
+    return static_cast<int64_t>(random.nextFloat(RandomStream::Items, 0.0f, 1.0f) * 1000.0f);
+  });
+
+  // raw engine throughput
+  measure("mt19937 raw", [&](int) { return static_cast<int64_t>(legacy() & 0xFF); });
+  measure("Xoshiro256 raw", [&](int) { return static_cast<int64_t>(xoshiro() & 0xFF); });
+
+  return 0;
+}
@@ -0,0 +1,200 @@
+// Load generator for the multiplayer server: one GameServer and many simulated clients in this process,
+// talking over the in-process transport, loopback UDP or both in turn. Every client joins, then turns its
+// snake at random every second or so, the way a crowd of players keeps a server busy; spectators only
+// watch. The server is ticked as fast as it goes rather than in real time, and the run reports its tick
+// times against the 60 Hz budget and the bandwidth each client would use at the real tick rate.
+//
+//   server_load [--clients N] [--spectators N] [--seconds S] [--board N] [--transport inprocess|udp|both]
+//               [--broadcast-interval N] [--seed S]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "MultiplayerSimulation.hpp"
+#include "utils/GameRandom.hpp"
+#include "utils/Logger.hpp"
+#include "utils/net/GameClient.hpp"
+#include "utils/net/GameServer.hpp"
+#include "utils/net/InProcessTransport.hpp"
+#include "utils/net/UdpTransport.hpp"
+
+namespace {
+struct Options {
+  int clients = 500;
+  int spectators = 0;
+  double seconds = 30.0;
+  int board = 128;
+  std::string transport = "both";
+  int broadcastInterval = GameServer::DEFAULT_BROADCAST_INTERVAL;
+  uint64_t seed = 1;
+};
+
+// ticks a client leaves between random turns, on average
+constexpr uint32_t TURN_EVERY_TICKS = 60;
+
+struct SimulatedClient {
+  std::unique_ptr<Transport> transport;
+  std::unique_ptr<GameClient> client;
+  Xoshiro256 random;
+};
+
+double percentile(std::vector<double> samples, double fraction) {
+  if (samples.empty()) {
+    return 0.0;
+  }
+  const auto index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1));
+  std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+  return samples[index];
+}
+
+void steer(SimulatedClient& simulated) {
+  if (!simulated.client->isConnected() || simulated.client->isSpectator() ||
+      boundedRandom(simulated.random, TURN_EVERY_TICKS) != 0) {
+    return;
+  }
+  constexpr Snake::Direction DIRECTIONS[] = {Snake::Direction::Up, Snake::Direction::Down, Snake::Direction::Left,
+                                             Snake::Direction::Right};
+  simulated.client->sendInput(DIRECTIONS[boundedRandom(simulated.random, 4)]);
+}
+
+// nullopt when the transport could not be set up
+std::optional<int> runLoad(const std::string& transportName, const Options& options) {
+  InProcessNetwork network;
+  std::unique_ptr<Transport> serverTransport;
+  if (transportName == "udp") {
+    serverTransport = UdpTransport::open(0);
+  } else {
+    // every client may have an input and a keep-alive in flight in the same tick
+    serverTransport = network.createEndpoint(static_cast<size_t>(options.clients + options.spectators) * 4);
+  }
+  if (!serverTransport) {
+    return std::nullopt;
+  }
+
+  MultiplayerConfig config;
+  config.seed = options.seed;
+  config.cols = options.board;
+  config.rows = options.board;
+  config.maxPlayers = options.clients;
+  GameServer server(config, *serverTransport, options.broadcastInterval);
+
+  std::vector<SimulatedClient> clients(static_cast<size_t>(options.clients + options.spectators));
+  for (size_t i = 0; i < clients.size(); ++i) {
+    SimulatedClient& simulated = clients[i];
+    simulated.transport = transportName == "udp" ? UdpTransport::open(0) : network.createEndpoint(64);
+    if (!simulated.transport) {
+      return std::nullopt;
+    }
+    simulated.client = std::make_unique<GameClient>(*simulated.transport, serverTransport->getLocalEndpoint(),
+                                                    i >= static_cast<size_t>(options.clients));
+    simulated.random.seed(options.seed * 1000003 + i);
+  }
+
+  const auto ticks = static_cast<uint64_t>(options.seconds * MultiplayerSimulation::TICKS_PER_SECOND);
+  std::vector<double> tickMs;
+  tickMs.reserve(ticks);
+  const auto start = std::chrono::steady_clock::now();
+  for (uint64_t tick = 0; tick < ticks; ++tick) {
+    for (SimulatedClient& simulated : clients) {
+      simulated.client->update();
+      steer(simulated);
+    }
+    server.tick();
+    tickMs.push_back(server.getStats().lastTickMs);
+  }
+  const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  int connected = 0;
+  uint64_t statesReceived = 0;
+  uint64_t statesDropped = 0;
+  for (const SimulatedClient& simulated : clients) {
+    connected += simulated.client->isConnected() ? 1 : 0;
+    statesReceived += simulated.client->getStatesReceived();
+    statesDropped += simulated.client->getStatesDropped();
+  }
+
+  int deaths = 0;
+  for (const auto& player : server.getSimulation().getPlayers()) {
+    deaths += player ? player->deaths : 0;
+  }
+
+  const ServerStats& stats = server.getStats();
+  const double clientSeconds = static_cast<double>(clients.size()) * options.seconds;
+  const double budgetMs = 1000.0 / MultiplayerSimulation::TICKS_PER_SECOND;
+  const double meanMs = stats.totalTickMs / static_cast<double>(stats.ticks);
+  std::printf("%s: %d/%zu clients connected, %d players on a %dx%d board died %d times, %d spectators, "
+              "%llu ticks in %.2f s\n",
+              transportName.c_str(), connected, clients.size(), server.getSimulation().getPlayerCount(), options.board,
+              options.board, deaths, server.getSpectatorCount(), static_cast<unsigned long long>(stats.ticks),
+              wallSeconds);
+  std::printf("  server tick: mean %.3f ms, median %.3f, p99 %.3f, max %.3f (%.1f%% of the %.2f ms budget)\n", meanMs,
+              percentile(tickMs, 0.5), percentile(tickMs, 0.99), stats.maxTickMs, meanMs / budgetMs * 100.0,
+              budgetMs);
+  std::printf("  per client: %.1f KB/s down, %.2f KB/s up, %.1f states/s; %llu datagrams refused\n",
+              static_cast<double>(stats.bytesSent) / clientSeconds / 1024.0,
+              static_cast<double>(stats.bytesReceived) / clientSeconds / 1024.0,
+              static_cast<double>(statesReceived) / clientSeconds,
+              static_cast<unsigned long long>(stats.sendFailures));
+  std::printf("  states: %llu as deltas, %llu whole, %llu dropped by clients\n",
+              static_cast<unsigned long long>(stats.deltaStatesSent),
+              static_cast<unsigned long long>(stats.fullStatesSent), static_cast<unsigned long long>(statesDropped));
+  return connected == static_cast<int>(clients.size()) ? 0 : 1;
+}
+
+std::optional<Options> parseOptions(int argc, char* argv[]) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string argument = argv[i];
+    const std::string value = argv[i + 1];
+    if (argument == "--clients") {
+      options.clients = std::clamp(std::stoi(value), 1, MultiplayerSimulation::MAX_PLAYERS);
+    } else if (argument == "--spectators") {
+      options.spectators = std::clamp(std::stoi(value), 0, GameServer::MAX_SPECTATORS);
+    } else if (argument == "--seconds") {
+      options.seconds = std::stod(value);
+    } else if (argument == "--board") {
+      options.board = std::clamp(std::stoi(value), 16, MultiplayerSimulation::MAX_BOARD_SIDE);
+    } else if (argument == "--transport" && (value == "inprocess" || value == "udp" || value == "both")) {
+      options.transport = value;
+    } else if (argument == "--broadcast-interval") {
+      options.broadcastInterval = std::max(1, std::stoi(value));
+    } else if (argument == "--seed") {
+      options.seed = std::stoull(value);
+    } else {
+      return std::nullopt;
+    }
+  }
+  if (argc % 2 == 0) {
+    return std::nullopt;
+  }
+  return options;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto options = parseOptions(argc, argv);
+  if (!options) {
+    std::fprintf(stderr, "usage: server_load [--clients N] [--spectators N] [--seconds S] [--board N] "
+                         "[--transport inprocess|udp|both] [--broadcast-interval N] [--seed S]\n");
+    return 2;
+  }
+
+  int status = 0;
+  for (const char* transport : {"inprocess", "udp"}) {
+    if (options->transport != "both" && options->transport != transport) {
+      continue;
+    }
+    const auto result = runLoad(transport, *options);
+    if (!result) {
+      std::fprintf(stderr, "%s: could not open the transport\n", transport);
+      status = 2;
+      continue;
+    }
+    status = std::max(status, *result);
+  }
+  Logger::getInstance().shutdown();
+  return status;
+}
@@ -0,0 +1,171 @@
+// Soak test for game-session memory: the path-following autopilot plays games back to back until the given
+// amount of gameplay time has passed, once with walls and items on the heap and once with every game in its
+// own SessionArena, the way GameScreen runs it. For each mode it reports the heap allocations made by the
+// simulation, split into setup (construction and teardown) and play (ticks), and how fragmented the memory
+// is: for the heap the free share of what malloc holds (glibc only), for the arena the share of its reserved
+// bytes that the game never used at its peak.
+//
+//   session_soak [--minutes N] [--mode heap|arena|both] [--seed S]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include "GameSimulation.hpp"
+#include "utils/AllocationTracker.hpp"
+#include "utils/Logger.hpp"
+#include "utils/SessionArena.hpp"
+#include "utils/autopilot/Autopilot.hpp"
+#include "utils/replay/ReplayPlayer.hpp"
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace {
+struct Options {
+  double minutes = 60.0;
+  std::string mode = "both";
+  uint64_t seed = 1;
+};
+
+struct SoakResult {
+  int games = 0;
+  uint64_t ticks = 0;
+  double gameplaySeconds = 0.0;
+  uint64_t setupAllocations = 0;
+  uint64_t playAllocations = 0;
+  uint64_t worstTickAllocations = 0;
+  double maxHeapFragmentation = 0.0;
+  size_t maxArenaReserved = 0;
+  size_t maxArenaPeakLive = 0;
+  double maxArenaUnused = 0.0;
+  uint64_t arenaUpstreamAllocations = 0;
+};
+
+// free share of the memory malloc holds, or nullopt where the allocator does not say
+std::optional<double> measureHeapFragmentation() {
+#ifdef __GLIBC__
+  const struct mallinfo2 info = mallinfo2();
+  const double held = static_cast<double>(info.arena + info.hblkhd);
+  return held > 0.0 ? static_cast<double>(info.fordblks) / held : 0.0;
+#else
+  return std::nullopt;
+#endif
+}
+
+// one game; the arena, when there is one, is created and released with it as GameScreen does
+void playGame(uint64_t seed, bool useArena, SoakResult& result) {
+  SimulationConfig config;
+  config.seed = seed;
+  config.difficulty = static_cast<GameDifficultyLevel>(seed % 5);
+  config.countdownSeconds = 0;
+  Autopilot autopilot(GameSimulation::GRID_COLS, GameSimulation::GRID_ROWS);
+
+  AllocationScope setup;
+  auto arena = useArena ? std::make_unique<SessionArena>() : nullptr;
+  auto simulation = std::make_unique<GameSimulation>(
+      config, arena ? arena->getResource() : std::pmr::get_default_resource());
+  uint64_t setupAllocations = setup.getCounts().allocations;
+
+  while (!simulation->isGameOver()) {
+    if (const auto input = autopilot.update(*simulation)) {
+      ReplayPlayer::applyInput(*simulation, *input);
+    }
+    const AllocationScope tick;
+    simulation->tick();
+    const uint64_t allocations = tick.getCounts().allocations;
+    result.playAllocations += allocations;
+    result.worstTickAllocations = std::max(result.worstTickAllocations, allocations);
+  }
+
+  result.games++;
+  result.ticks += simulation->getTick();
+  result.gameplaySeconds += simulation->getGameplaySeconds();
+  if (const auto fragmentation = measureHeapFragmentation()) {
+    result.maxHeapFragmentation = std::max(result.maxHeapFragmentation, *fragmentation);
+  }
+  if (arena) {
+    const SessionArenaStats stats = arena->getStats();
+    result.maxArenaReserved = std::max(result.maxArenaReserved, stats.reservedBytes);
+    result.maxArenaPeakLive = std::max(result.maxArenaPeakLive, stats.peakLiveBytes);
+    result.maxArenaUnused = std::max(result.maxArenaUnused, 1.0 - static_cast<double>(stats.peakLiveBytes) /
+                                                                      static_cast<double>(stats.reservedBytes));
+    result.arenaUpstreamAllocations += stats.upstreamAllocations;
+  }
+
+  const AllocationScope teardown;
+  simulation.reset();
+  arena.reset();
+  setupAllocations += teardown.getCounts().allocations;
+  result.setupAllocations += setupAllocations;
+}
+
+void report(const char* mode, const SoakResult& result, double wallSeconds) {
+  const double gameplayMinutes = result.gameplaySeconds / 60.0;
+  std::printf("%s: %d games, %.1f gameplay minutes, %llu ticks in %.2f s\n", mode, result.games, gameplayMinutes,
+              static_cast<unsigned long long>(result.ticks), wallSeconds);
+  std::printf("  heap allocations: %llu in setup, %llu while playing (%.1f per gameplay minute, worst tick %llu)\n",
+              static_cast<unsigned long long>(result.setupAllocations),
+              static_cast<unsigned long long>(result.playAllocations),
+              gameplayMinutes > 0.0 ? static_cast<double>(result.playAllocations) / gameplayMinutes : 0.0,
+              static_cast<unsigned long long>(result.worstTickAllocations));
+  if (result.maxArenaReserved == 0 && measureHeapFragmentation()) {
+    std::printf("  heap fragmentation: at most %.1f%% of what malloc holds was free at a game's end\n",
+                result.maxHeapFragmentation * 100.0);
+  }
+  if (result.maxArenaReserved > 0) {
+    std::printf("  arena: at most %zu bytes reserved and %zu live, %.1f%% never used, %llu chunk allocations\n",
+                result.maxArenaReserved, result.maxArenaPeakLive, result.maxArenaUnused * 100.0,
+                static_cast<unsigned long long>(result.arenaUpstreamAllocations));
+  }
+}
+
+void soak(const char* mode, bool useArena, const Options& options) {
+  const auto start = std::chrono::steady_clock::now();
+  SoakResult result;
+  for (uint64_t seed = options.seed; result.gameplaySeconds < options.minutes * 60.0; ++seed) {
+    playGame(seed, useArena, result);
+  }
+  report(mode, result, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+std::optional<Options> parseOptions(int argc, char* argv[]) {
+  Options options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string argument = argv[i];
+    const std::string value = argv[i + 1];
+    if (argument == "--minutes") {
+      options.minutes = std::stod(value);
+    } else if (argument == "--mode" && (value == "heap" || value == "arena" || value == "both")) {
+      options.mode = value;
+    } else if (argument == "--seed") {
+      options.seed = std::stoull(value);
+    } else {
+      return std::nullopt;
+    }
+  }
+  if (argc % 2 == 0) {
+    return std::nullopt;
+  }
+  return options;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  const auto options = parseOptions(argc, argv);
+  if (!options) {
+    std::fprintf(stderr, "usage: session_soak [--minutes N] [--mode heap|arena|both] [--seed S]\n");
+    return 2;
+  }
+
+  // both modes play the same games, the heap first so the arena run starts on a heap the other has warmed
+  if (options->mode != "arena") {
+    soak("heap", false, *options);
+  }
+  if (options->mode != "heap") {
+    soak("arena", true, *options);
+  }
+  Logger::getInstance().shutdown();
+  return 0;
+}
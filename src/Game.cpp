@@ -1,17 +1,28 @@
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
+#include <iostream>
 
 #include "Game.hpp"
 #include "screens/GameScreen.hpp"
 #include "screens/MainMenu.hpp"
 #include "utils/DebugUI.hpp"
 #include "utils/EventLogger.hpp"
+#include "utils/FrameProfiler.hpp"
+#include "utils/ResourceLoader.hpp"
+#include "utils/TraceRecorder.hpp"
 
-Game::Game(sf::RenderWindow& win) : window(win), isRunning(true), previousScreen(nullptr) {
+Game::Game(sf::RenderWindow& win)
+    : window(win), isRunning(true), currentScreen(nullptr), previousScreen(nullptr), scoreLog(SCORE_LOG_PATH) {
   if (!settingStorage.loadSettings()) {
     std::cerr << "Warning: Failed to load settings, using defaults" << std::endl;
   }
 
+  if (scoreLog.open()) {
+    migrateLegacyRecordTable();
+  } else {
+    std::cerr << "Warning: Score log unavailable, scores will not be saved" << std::endl;
+  }
+
   setCurrentScreen(new MainMenu(window, *this));
 
   DebugUI::initialize(window);
@@ -25,24 +36,44 @@ Game::~Game() {
 
 void Game::start() const {
   while (window.isOpen()) {
-    sf::sleep(sf::milliseconds(16));
+    runFrame();
+  }
+}
+
+void Game::runFrame() const {
+  sf::sleep(sf::milliseconds(16));
 
-    window.clear(sf::Color(164, 144, 164));
+  window.clear(sf::Color(164, 144, 164));
 
+  {
+    PROFILE_ZONE(Events);
     while (const auto event = window.pollEvent()) {
       processEvents(*event);
       currentScreen->processEvents(*event);
     }
+  }
 
+  {
+    PROFILE_ZONE(Update);
     currentScreen->update();
+  }
+  {
+    PROFILE_ZONE(Render);
     currentScreen->render();
+  }
 
-    if (DEBUG_UI_TEXT) {
-      DebugUI::render(window);
-    }
+  if (DEBUG_UI_TEXT) {
+    DebugUI::render(window);
+  }
+  FrameProfiler::getInstance().render(window);
 
+  {
+    PROFILE_ZONE(Display);
     window.display();
   }
+
+  ResourceLoader::prefetchNext();
+  FrameProfiler::getInstance().endFrame();
 }
 
 void Game::processEvents(const sf::Event& event) const {
@@ -53,6 +84,14 @@ void Game::processEvents(const sf::Event& event) const {
     window.close();
   }
 
+  if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+    if (keyPressed->code == sf::Keyboard::Key::F3) {
+      FrameProfiler::getInstance().toggle();
+    } else if (keyPressed->code == sf::Keyboard::Key::F4) {
+      TraceRecorder::getInstance().startCapture(TRACE_CAPTURE_DURATION);
+    }
+  }
+
   if (event.is<sf::Event::Resized>()) {
 
     const auto resizedEvent = event.getIf<sf::Event::Resized>();
@@ -62,15 +101,26 @@ void Game::processEvents(const sf::Event& event) const {
   }
 }
 
+void Game::onScreenChanged() const {
+  TRACE_SCOPE("screen change");
+  ResourceLoader::evictUnused();
+
+  if (const ResourceSet* prefetchSet = currentScreen->getPrefetchSet()) {
+    ResourceLoader::prefetch(*prefetchSet);
+  }
+}
+
 void Game::setCurrentScreen(Screen* screen) {
   delete currentScreen;
   currentScreen = screen;
+  onScreenChanged();
 }
 
 void Game::setCurrentScreenWithPrevious(Screen* screen, Screen* previous) {
   delete previousScreen;
   previousScreen = previous;
   currentScreen = screen;
+  onScreenChanged();
 }
 
 void Game::returnToPreviousScreen() {
@@ -78,6 +128,7 @@ void Game::returnToPreviousScreen() {
     delete currentScreen;
     currentScreen = previousScreen;
     previousScreen = nullptr;
+    onScreenChanged();
   }
 }
 
@@ -93,15 +144,44 @@ void Game::returnToGameScreen() {
     delete currentScreen;
     currentScreen = new GameScreen(window, *this);
   }
+  onScreenChanged();
 }
 
-void Game::saveScoreToRecordTable() {
+void Game::recordGameResult(int snakeLength, float durationSeconds) {
+  ScoreRecord record;
+  record.timestamp = ScoreLog::currentTimestamp();
+  record.score = score;
+  record.length = static_cast<uint32_t>(snakeLength);
+  record.durationMillis = static_cast<uint32_t>(durationSeconds * 1000.0f);
+  record.difficulty = settingStorage.getGameDifficultyLevel();
+  record.snakeType = settingStorage.getSnakeType();
 
-  settingStorage.loadSettings();
-  settingStorage.addScoreToRecordTable(score);
+  lastRecordSequence = scoreLog.append(record);
 }
 
-bool Game::isNewHighScore() const {
-  const auto& recordTable = settingStorage.getGameRecordTable();
-  return recordTable.empty() || score > recordTable.back();
+void Game::migrateLegacyRecordTable() {
+  if (scoreLog.getRecordCount() > 0) {
+    return;
+  }
+
+  // the old table only kept bare scores, file them under the difficulty that is currently selected
+  int migrated = 0;
+  for (const int legacyScore : settingStorage.getGameRecordTable()) {
+    if (legacyScore <= 0) {
+      continue;
+    }
+
+    ScoreRecord record;
+    record.score = legacyScore;
+    record.difficulty = settingStorage.getGameDifficultyLevel();
+    record.snakeType = settingStorage.getSnakeType();
+    record.migrated = true;
+    if (scoreLog.append(record)) {
+      migrated++;
+    }
+  }
+
+  if (migrated > 0) {
+    std::cout << "Migrated " << migrated << " score(s) from settings into " << SCORE_LOG_PATH << std::endl;
+  }
 }
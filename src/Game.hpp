@@ -2,6 +2,9 @@
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include "Screen.hpp"
+#include <chrono>
+#include <optional>
+#include "utils/ScoreLog.hpp"
 #include "utils/SettingStorage.hpp"
 
 namespace MenuColors {
@@ -29,6 +32,11 @@ private:
   Screen* currentScreen;
   Screen* previousScreen;
   SettingStorage settingStorage;
+  ScoreLog scoreLog;
+  std::optional<uint64_t> lastRecordSequence;
+
+  static constexpr const char* SCORE_LOG_PATH = "scores.log";
+  static constexpr std::chrono::seconds TRACE_CAPTURE_DURATION{5};
 
   int score = -1;
   int highScore = -1;
@@ -37,12 +45,16 @@ private:
   static constexpr bool DEBUG_UI_TEXT = false;
 
   void processEvents(const sf::Event& event) const;
+  void migrateLegacyRecordTable();
+  void onScreenChanged() const;
 
 public:
   explicit Game(sf::RenderWindow& window);
   ~Game();
 
   void start() const;
+  // one pass of the main loop: events, update, render and display
+  void runFrame() const;
 
   void setCurrentScreen(Screen* screen);
   void setCurrentScreenWithPrevious(Screen* screen, Screen* previous);
@@ -51,14 +63,16 @@ public:
   [[nodiscard]] int getHighScore() const { return highScore; }
   [[nodiscard]] bool getIsPaused() const { return isPaused; }
   [[nodiscard]] sf::RenderWindow& getWindow() const { return window; }
+  [[nodiscard]] const Screen* getCurrentScreen() const { return currentScreen; }
 
   void setScore(int newScore) { score = newScore; }
   void setHighScore(int newHighScore) { highScore = newHighScore; }
   void setIsPaused(bool paused) { isPaused = paused; }
 
   [[nodiscard]] const SettingStorage& getSettingsReader() const { return settingStorage; }
+  [[nodiscard]] SettingStorage& getSettingStorage() { return settingStorage; }
 
-  void loadSettings() { settingStorage.loadSettings(); }
+  void refreshSettings() { settingStorage.reloadIfChanged(); }
 
   void addScore(int points) { score += points; }
   void resetScore() { score = 0; }
@@ -67,8 +81,10 @@ public:
       highScore = score;
   }
 
-  void saveScoreToRecordTable();
-  bool isNewHighScore() const;
+  void recordGameResult(int snakeLength, float durationSeconds);
+
+  [[nodiscard]] const ScoreLog& getScoreLog() const { return scoreLog; }
+  [[nodiscard]] std::optional<uint64_t> getLastRecordSequence() const { return lastRecordSequence; }
 
   void returnToPreviousScreen();
   void returnToGameScreen();
@@ -0,0 +1,246 @@
+#include "GameSimulation.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include "utils/GameItem.hpp"
+#include "utils/TraceRecorder.hpp"
+#include "utils/ZobristHash.hpp"
+#include "utils/difficulty/DifficultyManager.hpp"
+
+GameSimulation::GameSimulation(const SimulationConfig& config, std::pmr::memory_resource* resource)
+    : GameSimulation(config, DifficultyManager::getDifficultySettings(config.difficulty), resource) {}
+
+GameSimulation::GameSimulation(const SimulationConfig& config, const DifficultySettings& settings,
+                               std::pmr::memory_resource* resource)
+    : config(config),
+      difficultySettings(settings),
+      random(config.seed),
+      grid(GRID_ROWS, GRID_COLS, 824.0f, sf::Vector2f(0, 0), 1.0f, 912.0f),
+      snake(sf::Vector2i(GRID_COLS / 2, GRID_ROWS / 2), START_LENGTH),
+      wallManager(grid, difficultySettings, random, resource),
+      gameItemManager(grid, difficultySettings, random, wallManager, resource) {
+  snake.reserveLength(GRID_ROWS * GRID_COLS);
+  snake.setSnakeType(config.snakeType);
+  snake.setSpeed(difficultySettings.getBaseSnakeSpeed());
+  snake.seedCosmetics(random.nextSeed(RandomStream::Cosmetics));
+
+  generateInitialWalls();
+  startCountdown();
+}
+
+void GameSimulation::generateInitialWalls() {
+  TRACE_SCOPE("generate walls");
+  int wallsGenerated = 0;
+  int maxAttempts = difficultySettings.getWallCount() * 3;
+  int attempts = 0;
+
+  while (wallsGenerated < difficultySettings.getWallCount() && attempts < maxAttempts) {
+    if (wallManager.tryGenerateWall(snake)) {
+      wallsGenerated++;
+    }
+    attempts++;
+  }
+}
+
+void GameSimulation::setDirection(Snake::Direction direction) {
+  if (!gameOver) {
+    snake.setDirection(direction);
+  }
+}
+
+void GameSimulation::startCountdown() {
+  countdownTicksLeft = static_cast<uint32_t>(std::max(0, config.countdownSeconds)) * TICKS_PER_SECOND;
+}
+
+TickResult GameSimulation::tick() {
+  TickResult result = advanceTick();
+  assert(verifyZobristHash() && "Incremental Zobrist hash differs from a full recomputation");
+  return result;
+}
+
+TickResult GameSimulation::advanceTick() {
+  TickResult result;
+  if (gameOver) {
+    return result;
+  }
+
+  tickCount++;
+
+  // walls keep fading in while the countdown runs, everything else waits for it
+  wallManager.update(TICK_SECONDS, snake);
+
+  if (countdownTicksLeft > 0) {
+    countdownTicksLeft--;
+    return result;
+  }
+
+  gameplayTicks++;
+  gameItemManager.update(TICK_SECONDS, snake);
+  snake.updateTimers(TICK_SECONDS);
+
+  ticksSinceSpeedIncrease++;
+  if (static_cast<float>(ticksSinceSpeedIncrease) >=
+      difficultySettings.getSpeedIncreaseInterval() * static_cast<float>(TICKS_PER_SECOND)) {
+    snake.setSpeed(snake.getSpeed() + difficultySettings.getSpeedIncreaseRate());
+    ticksSinceSpeedIncrease = 0;
+  }
+
+  ticksSinceMove++;
+  if (static_cast<float>(ticksSinceMove) >= static_cast<float>(TICKS_PER_SECOND) / snake.getSpeed()) {
+    moveSnake(result);
+    ticksSinceMove = 0;
+  }
+
+  return result;
+}
+
+void GameSimulation::moveSnake(TickResult& result) {
+  snake.move();
+
+  if (auto* collidedItem = gameItemManager.checkCollision(snake.getHead())) {
+    collidedItem->applySpecialEffects(snake);
+
+    snake.grow();
+
+    result.ateItem = true;
+    result.points = static_cast<int>(collidedItem->getPoints() * difficultySettings.getScoreMultiplier());
+    score += result.points;
+    applesEaten++;
+
+    gameItemManager.removeItem(collidedItem);
+  }
+
+  bool wallCollision = false;
+  if (!snake.isInvincible()) {
+    wallCollision = wallManager.checkWallCollision(snake.getHead());
+  }
+
+  if (wallCollision || snake.checkWallCollision(grid.getCols(), grid.getRows()) || snake.checkSelfCollision()) {
+    snake.kill();
+    gameOver = true;
+    result.died = true;
+  }
+}
+
+uint64_t GameSimulation::computeStateHash() const {
+  GameSnapshot snapshot;
+  saveSnapshot(snapshot);
+  return snapshot.computeHash();
+}
+
+uint64_t GameSimulation::getZobristHash() const {
+  uint64_t hash = snake.getZobristHash() ^ wallManager.getZobristHash() ^ gameItemManager.getZobristHash();
+  hash = zobrist::combine(hash, tickCount);
+  hash = zobrist::combine(hash, (static_cast<uint64_t>(countdownTicksLeft) << 32) | ticksSinceMove);
+  hash = zobrist::combine(hash, (static_cast<uint64_t>(gameplayTicks) << 32) | ticksSinceSpeedIncrease);
+  hash = zobrist::combine(hash, (static_cast<uint64_t>(static_cast<uint32_t>(score)) << 32) |
+                                    static_cast<uint32_t>(applesEaten));
+  hash = zobrist::combine(hash, (static_cast<uint64_t>(std::bit_cast<uint32_t>(snake.getSpeed())) << 32) |
+                                    (static_cast<uint64_t>(snake.getDirection()) << 8) |
+                                    (static_cast<uint64_t>(snake.isDisoriented()) << 2) |
+                                    (static_cast<uint64_t>(snake.isInvincible()) << 1) | gameOver);
+  uint64_t streams = 0;
+  for (size_t stream = 0; stream < static_cast<size_t>(RandomStream::Count); ++stream) {
+    for (const uint64_t word : random.getEngine(static_cast<RandomStream>(stream)).getState()) {
+      streams = std::rotl(streams, 23) ^ word;
+    }
+  }
+  return zobrist::combine(hash, streams);
+}
+
+bool GameSimulation::verifyZobristHash() const {
+  return snake.getZobristHash() == snake.computeZobristHash() &&
+         wallManager.getZobristHash() == wallManager.computeZobristHash() &&
+         gameItemManager.getZobristHash() == gameItemManager.computeZobristHash();
+}
+
+bool GameSimulation::saveSnapshot(GameSnapshot& snapshot) const {
+  SnapshotWriter writer(snapshot);
+  writer.write(SNAPSHOT_MAGIC);
+  writer.write(GameSnapshot::FORMAT_VERSION);
+  writer.write(config.seed);
+  writer.write(static_cast<uint8_t>(config.difficulty));
+  writer.write(static_cast<uint8_t>(config.snakeType));
+  writer.write(static_cast<int32_t>(config.countdownSeconds));
+
+  writer.write(tickCount);
+  writer.write(gameplayTicks);
+  writer.write(countdownTicksLeft);
+  writer.write(ticksSinceMove);
+  writer.write(ticksSinceSpeedIncrease);
+  writer.write(static_cast<int32_t>(score));
+  writer.write(static_cast<int32_t>(applesEaten));
+  writer.write(gameOver);
+  for (size_t stream = 0; stream < static_cast<size_t>(RandomStream::Count); ++stream) {
+    writer.write(random.getEngine(static_cast<RandomStream>(stream)).getState());
+  }
+
+  snake.saveState(writer);
+  wallManager.saveState(writer);
+  gameItemManager.saveState(writer);
+  return writer.succeeded();
+}
+
+std::optional<SimulationConfig> GameSimulation::readHeader(SnapshotReader& reader) {
+  if (reader.read<uint32_t>() != SNAPSHOT_MAGIC || reader.read<uint16_t>() != GameSnapshot::FORMAT_VERSION) {
+    return std::nullopt;
+  }
+
+  SimulationConfig snapshotConfig;
+  snapshotConfig.seed = reader.read<uint64_t>();
+  const auto difficulty = reader.read<uint8_t>();
+  const auto snakeType = reader.read<uint8_t>();
+  snapshotConfig.countdownSeconds = reader.read<int32_t>();
+  if (!reader.succeeded() || difficulty > static_cast<uint8_t>(GameDifficultyLevel::Hard) ||
+      snakeType > static_cast<uint8_t>(SnakeSprite::SnakeType::Black)) {
+    return std::nullopt;
+  }
+  snapshotConfig.difficulty = static_cast<GameDifficultyLevel>(difficulty);
+  snapshotConfig.snakeType = static_cast<SnakeSprite::SnakeType>(snakeType);
+  return snapshotConfig;
+}
+
+bool GameSimulation::restoreSnapshot(const GameSnapshot& snapshot) {
+  SnapshotReader reader(snapshot);
+  const auto snapshotConfig = readHeader(reader);
+  if (!snapshotConfig || snapshotConfig->difficulty != config.difficulty) {
+    return false;
+  }
+  config = *snapshotConfig;
+
+  tickCount = reader.read<uint32_t>();
+  gameplayTicks = reader.read<uint32_t>();
+  countdownTicksLeft = reader.read<uint32_t>();
+  ticksSinceMove = reader.read<uint32_t>();
+  ticksSinceSpeedIncrease = reader.read<uint32_t>();
+  score = reader.read<int32_t>();
+  applesEaten = reader.read<int32_t>();
+  gameOver = reader.read<uint8_t>() != 0;
+  random.reseed(config.seed);
+  for (size_t stream = 0; stream < static_cast<size_t>(RandomStream::Count); ++stream) {
+    random.getEngine(static_cast<RandomStream>(stream)).setState(reader.read<Xoshiro256::State>());
+  }
+
+  snake.restoreState(reader);
+  wallManager.restoreState(reader);
+  gameItemManager.restoreState(reader);
+  return reader.succeeded() && reader.atEnd();
+}
+
+std::optional<SimulationConfig> GameSimulation::readSnapshotConfig(const GameSnapshot& snapshot) {
+  SnapshotReader reader(snapshot);
+  return readHeader(reader);
+}
+
+std::unique_ptr<GameSimulation> GameSimulation::fromSnapshot(const GameSnapshot& snapshot) {
+  const auto snapshotConfig = readSnapshotConfig(snapshot);
+  if (!snapshotConfig) {
+    return nullptr;
+  }
+
+  auto simulation = std::make_unique<GameSimulation>(*snapshotConfig);
+  if (!simulation->restoreSnapshot(snapshot)) {
+    return nullptr;
+  }
+  return simulation;
+}
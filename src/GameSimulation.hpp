@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include "Snake.hpp"
+#include "utils/GameGrid.hpp"
+#include "utils/GameItemManager.hpp"
+#include "utils/GameRandom.hpp"
+#include "utils/GameSnapshot.hpp"
+#include "utils/SettingStorage.hpp"
+#include "utils/WallManager.hpp"
+
+struct SimulationConfig {
+  uint64_t seed = 0;
+  GameDifficultyLevel difficulty = GameDifficultyLevel::Easy;
+  SnakeSprite::SnakeType snakeType = SnakeSprite::SnakeType::Purple;
+  int countdownSeconds = 3;
+};
+
+struct TickResult {
+  bool ateItem = false;
+  int points = 0;
+  bool died = false;
+};
+
+// The rules of one game, advanced in fixed ticks. It never reads a clock and never draws, so the same
+// config and the same inputs on the same ticks always end in the same state; GameScreen drives it in
+// real time and the replay player drives it as fast as it can.
+class GameSimulation {
+public:
+  static constexpr int TICKS_PER_SECOND = 60;
+  static constexpr float TICK_SECONDS = 1.0f / TICKS_PER_SECOND;
+  static constexpr int GRID_ROWS = 32;
+  static constexpr int GRID_COLS = 32;
+  static constexpr int START_LENGTH = 5;
+
+  // Walls and items are allocated from resource. A screen passes its session arena, which must outlive the
+  // simulation; headless runs keep the default heap.
+  explicit GameSimulation(const SimulationConfig& config,
+                          std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  // plays with settings other than the preset of config.difficulty, as the difficulty tuner does. The settings
+  // must outlive the simulation; snapshots and replays still record only the level.
+  GameSimulation(const SimulationConfig& config, const DifficultySettings& settings,
+                 std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  GameSimulation(const GameSimulation&) = delete;
+  GameSimulation& operator=(const GameSimulation&) = delete;
+
+  void setDirection(Snake::Direction direction);
+  void startCountdown();
+
+  TickResult tick();
+
+  [[nodiscard]] bool isCountdownActive() const { return countdownTicksLeft > 0; }
+  [[nodiscard]] bool isGameOver() const { return gameOver; }
+
+  [[nodiscard]] uint32_t getTick() const { return tickCount; }
+  [[nodiscard]] float getGameplaySeconds() const { return static_cast<float>(gameplayTicks) * TICK_SECONDS; }
+  [[nodiscard]] int getScore() const { return score; }
+  [[nodiscard]] int getApplesEaten() const { return applesEaten; }
+  [[nodiscard]] const SimulationConfig& getConfig() const { return config; }
+
+  [[nodiscard]] Snake& getSnake() { return snake; }
+  [[nodiscard]] const Snake& getSnake() const { return snake; }
+  [[nodiscard]] const WallManager& getWallManager() const { return wallManager; }
+  [[nodiscard]] const GameItemManager& getGameItemManager() const { return gameItemManager; }
+  [[nodiscard]] const GameGrid& getGrid() const { return grid; }
+
+  // hash of the snapshot bytes, so it covers exactly the state a snapshot restores
+  [[nodiscard]] uint64_t computeStateHash() const;
+
+  // Zobrist hash of the board, kept up to date as the snake, walls and items change, folded with the
+  // counters, score, snake direction, speed and effects, and the random streams. Cheap enough to compare
+  // two simulations every tick or to key a search cache; timers are left out, and a divergence in them
+  // reaches the board or the random streams within a few ticks.
+  [[nodiscard]] uint64_t getZobristHash() const;
+
+  // recomputes the board part from scratch and compares; debug builds check it after every tick
+  [[nodiscard]] bool verifyZobristHash() const;
+
+  bool saveSnapshot(GameSnapshot& snapshot) const;
+
+  // Restores a snapshot taken from a simulation with the same difficulty. Header and config are
+  // checked before anything changes; a snapshot that is damaged past that point leaves the state
+  // undefined, so untrusted data should go through fromSnapshot instead.
+  bool restoreSnapshot(const GameSnapshot& snapshot);
+
+  static std::optional<SimulationConfig> readSnapshotConfig(const GameSnapshot& snapshot);
+  static std::unique_ptr<GameSimulation> fromSnapshot(const GameSnapshot& snapshot);
+
+private:
+  static constexpr uint32_t SNAPSHOT_MAGIC = 0x53534E53;  // "SNSS"
+
+  SimulationConfig config;
+  const DifficultySettings& difficultySettings;
+  GameRandom random;
+  GameGrid grid;
+  Snake snake;
+  WallManager wallManager;
+  GameItemManager gameItemManager;
+
+  uint32_t tickCount = 0;
+  uint32_t gameplayTicks = 0;
+  uint32_t countdownTicksLeft = 0;
+  uint32_t ticksSinceMove = 0;
+  uint32_t ticksSinceSpeedIncrease = 0;
+  int score = 0;
+  int applesEaten = 0;
+  bool gameOver = false;
+
+  static std::optional<SimulationConfig> readHeader(SnapshotReader& reader);
+
+  TickResult advanceTick();
+  void generateInitialWalls();
+  void moveSnake(TickResult& result);
+};
@@ -0,0 +1,215 @@
+#include "MultiplayerSimulation.hpp"
+#include <algorithm>
+#include "utils/GameItem.hpp"
+#include "utils/difficulty/DifficultyManager.hpp"
+
+namespace {
+MultiplayerConfig clampConfig(MultiplayerConfig config) {
+  config.cols = std::clamp(config.cols, MultiplayerSimulation::START_LENGTH + 8, MultiplayerSimulation::MAX_BOARD_SIDE);
+  config.rows = std::clamp(config.rows, 8, MultiplayerSimulation::MAX_BOARD_SIDE);
+  config.maxPlayers = std::clamp(config.maxPlayers, 1, MultiplayerSimulation::MAX_PLAYERS);
+  return config;
+}
+}  // namespace
+
+MultiplayerSimulation::MultiplayerSimulation(const MultiplayerConfig& multiplayerConfig,
+                                             std::pmr::memory_resource* resource)
+    : config(clampConfig(multiplayerConfig)),
+      difficultySettings(DifficultyManager::getDifficultySettings(config.difficulty)),
+      random(config.seed),
+      spawnRandom(config.seed ^ 0x5350415745ull),
+      grid(config.rows, config.cols, 824.0f, sf::Vector2f(0, 0), 1.0f, 912.0f),
+      wallManager(grid, difficultySettings, random, resource),
+      gameItemManager(grid, difficultySettings, random, wallManager, resource),
+      players(static_cast<size_t>(config.maxPlayers)),
+      occupancy(static_cast<size_t>(config.rows) * static_cast<size_t>(config.cols), 0) {
+  movedPlayers.reserve(players.size());
+  deadPlayers.reserve(players.size());
+}
+
+std::optional<uint16_t> MultiplayerSimulation::addPlayer() {
+  const auto slot = std::find_if(players.begin(), players.end(), [](const auto& player) { return !player; });
+  if (slot == players.end()) {
+    return std::nullopt;
+  }
+
+  slot->emplace();
+  playerCount++;
+  return static_cast<uint16_t>(slot - players.begin());
+}
+
+void MultiplayerSimulation::removePlayer(uint16_t id) {
+  if (id < players.size() && players[id]) {
+    players[id].reset();
+    playerCount--;
+  }
+}
+
+void MultiplayerSimulation::setDirection(uint16_t id, Snake::Direction direction) {
+  if (id < players.size() && players[id] && players[id]->snake) {
+    players[id]->snake->setDirection(direction);
+  }
+}
+
+void MultiplayerSimulation::tick() {
+  tickCount++;
+  spawnWaitingPlayers();
+
+  // with nobody on the board the walls and items wait too
+  if (const Snake* reference = pickReferenceSnake()) {
+    wallManager.update(TICK_SECONDS, *reference);
+    gameItemManager.update(TICK_SECONDS, *reference);
+  }
+
+  moveSnakes();
+}
+
+const Snake* MultiplayerSimulation::pickReferenceSnake() {
+  for (size_t i = 0; i < players.size(); ++i) {
+    const size_t id = (nextReferencePlayer + i) % players.size();
+    if (players[id] && players[id]->snake) {
+      nextReferencePlayer = id + 1;
+      return &*players[id]->snake;
+    }
+  }
+  return nullptr;
+}
+
+void MultiplayerSimulation::spawnWaitingPlayers() {
+  bool occupancyFresh = false;
+  for (size_t id = 0; id < players.size(); ++id) {
+    auto& player = players[id];
+    if (!player || player->snake) {
+      continue;
+    }
+    if (player->spawnTicksLeft > 0) {
+      player->spawnTicksLeft--;
+      continue;
+    }
+
+    if (!occupancyFresh) {
+      rebuildOccupancy();
+      occupancyFresh = true;
+    }
+    trySpawn(static_cast<uint16_t>(id), *player);
+  }
+}
+
+// a snake starts as a horizontal line heading right, so it needs its own cells and a few ahead of the head
+bool MultiplayerSimulation::trySpawn(uint16_t id, MultiplayerPlayer& player) {
+  const int minX = START_LENGTH - 1;
+  const int maxX = grid.getCols() - 1 - SPAWN_CLEARANCE;
+  for (int attempt = 0; attempt < SPAWN_ATTEMPTS; ++attempt) {
+    const sf::Vector2i head(minX + static_cast<int>(boundedRandom(spawnRandom, static_cast<uint32_t>(maxX - minX + 1))),
+                            static_cast<int>(boundedRandom(spawnRandom, static_cast<uint32_t>(grid.getRows()))));
+    bool free = true;
+    for (int x = head.x - START_LENGTH + 1; x <= head.x + SPAWN_CLEARANCE && free; ++x) {
+      free = isFreeForSpawn(sf::Vector2i(x, head.y));
+    }
+    if (!free) {
+      continue;
+    }
+
+    Snake& snake = player.snake.emplace(head, START_LENGTH);
+    snake.setSnakeType(static_cast<SnakeSprite::SnakeType>(id % (static_cast<int>(SnakeSprite::SnakeType::Black) + 1)));
+    snake.setSpeed(difficultySettings.getBaseSnakeSpeed());
+    snake.seedCosmetics(spawnRandom());
+    player.score = 0;
+    player.ticksSinceMove = 0;
+    player.ticksSinceSpeedIncrease = 0;
+    markOccupied(snake);
+    return true;
+  }
+  return false;
+}
+
+bool MultiplayerSimulation::isFreeForSpawn(sf::Vector2i cell) const {
+  if (!isInside(cell) || occupancy[cellIndex(cell)] > 0) {
+    return false;
+  }
+  // walls that are still fading in count too, they would be solid by the time the snake got there
+  return std::none_of(wallManager.getWalls().begin(), wallManager.getWalls().end(),
+                      [cell](const auto& wall) { return wall->checkCollisionWithPosition(cell); });
+}
+
+void MultiplayerSimulation::moveSnakes() {
+  movedPlayers.clear();
+  for (size_t id = 0; id < players.size(); ++id) {
+    auto& player = players[id];
+    if (!player || !player->snake) {
+      continue;
+    }
+
+    Snake& snake = *player->snake;
+    snake.updateTimers(TICK_SECONDS);
+
+    player->ticksSinceSpeedIncrease++;
+    if (static_cast<float>(player->ticksSinceSpeedIncrease) >=
+        difficultySettings.getSpeedIncreaseInterval() * static_cast<float>(TICKS_PER_SECOND)) {
+      snake.setSpeed(snake.getSpeed() + difficultySettings.getSpeedIncreaseRate());
+      player->ticksSinceSpeedIncrease = 0;
+    }
+
+    player->ticksSinceMove++;
+    if (static_cast<float>(player->ticksSinceMove) >= static_cast<float>(TICKS_PER_SECOND) / snake.getSpeed()) {
+      snake.move();
+      player->ticksSinceMove = 0;
+      movedPlayers.push_back(static_cast<uint16_t>(id));
+      eatItem(*player);
+    }
+  }
+
+  if (movedPlayers.empty()) {
+    return;
+  }
+
+  // every snake moves before any dies, so two heads meeting see each other
+  rebuildOccupancy();
+  deadPlayers.clear();
+  for (const uint16_t id : movedPlayers) {
+    const Snake& snake = *players[id]->snake;
+    const sf::Vector2i head = snake.getHead();
+    const bool outside = !isInside(head);
+    const bool blocked = !outside && (wallManager.checkWallCollision(head) || occupancy[cellIndex(head)] > 1);
+    if (outside || (blocked && !snake.isInvincible())) {
+      deadPlayers.push_back(id);
+    }
+  }
+
+  for (const uint16_t id : deadPlayers) {
+    MultiplayerPlayer& player = *players[id];
+    player.snake.reset();
+    player.deaths++;
+    player.spawnTicksLeft = SPAWN_DELAY_TICKS;
+  }
+}
+
+void MultiplayerSimulation::eatItem(MultiplayerPlayer& player) {
+  Snake& snake = *player.snake;
+  GameItem* item = gameItemManager.checkCollision(snake.getHead());
+  if (!item) {
+    return;
+  }
+
+  item->applySpecialEffects(snake);
+  snake.grow();
+  player.score += static_cast<int>(item->getPoints() * difficultySettings.getScoreMultiplier());
+  gameItemManager.removeItem(item);
+}
+
+void MultiplayerSimulation::rebuildOccupancy() {
+  std::fill(occupancy.begin(), occupancy.end(), 0);
+  for (const auto& player : players) {
+    if (player && player->snake) {
+      markOccupied(*player->snake);
+    }
+  }
+}
+
+void MultiplayerSimulation::markOccupied(const Snake& snake) {
+  for (const sf::Vector2i cell : snake.getBody()) {
+    if (isInside(cell)) {
+      occupancy[cellIndex(cell)]++;
+    }
+  }
+}
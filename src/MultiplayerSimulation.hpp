@@ -0,0 +1,107 @@
+#pragma once
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+#include "GameSimulation.hpp"
+#include "Snake.hpp"
+#include "utils/GameGrid.hpp"
+#include "utils/GameItemManager.hpp"
+#include "utils/GameRandom.hpp"
+#include "utils/WallManager.hpp"
+
+struct MultiplayerConfig {
+  uint64_t seed = 0;
+  GameDifficultyLevel difficulty = GameDifficultyLevel::Easy;
+  int cols = 64;
+  int rows = 64;
+  int maxPlayers = 16;
+};
+
+struct MultiplayerPlayer {
+  // empty while the player waits to spawn
+  std::optional<Snake> snake;
+  // points of the current life
+  int score = 0;
+  int deaths = 0;
+  uint32_t ticksSinceMove = 0;
+  uint32_t ticksSinceSpeedIncrease = 0;
+  uint32_t spawnTicksLeft = 0;
+};
+
+// Several snakes on one board, under the rules GameSimulation plays with one: the same snake movement,
+// speed-up, items and walls, advanced in the same fixed ticks and deterministic in the same way. A head
+// that runs into another snake dies as it would running into itself, and two heads meeting both die.
+// A dead snake leaves the board and its player spawns again a few seconds later on free cells.
+//
+// WallManager and GameItemManager place walls and items around one snake. Each tick they are handed the
+// next live snake in turn, so over a few ticks every snake gets the room they keep clear in front of it.
+// An item may appear under another snake's body; it is eaten when a head reaches it.
+class MultiplayerSimulation {
+public:
+  static constexpr int TICKS_PER_SECOND = GameSimulation::TICKS_PER_SECOND;
+  static constexpr float TICK_SECONDS = GameSimulation::TICK_SECONDS;
+  static constexpr int START_LENGTH = GameSimulation::START_LENGTH;
+  static constexpr uint32_t SPAWN_DELAY_TICKS = 3 * TICKS_PER_SECOND;
+  static constexpr int MAX_PLAYERS = 1024;
+  static constexpr int MAX_BOARD_SIDE = 1024;
+
+  explicit MultiplayerSimulation(const MultiplayerConfig& config,
+                                 std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  MultiplayerSimulation(const MultiplayerSimulation&) = delete;
+  MultiplayerSimulation& operator=(const MultiplayerSimulation&) = delete;
+
+  // the player id, a free slot; the snake appears on the next tick that finds room. nullopt when full
+  std::optional<uint16_t> addPlayer();
+  void removePlayer(uint16_t id);
+  void setDirection(uint16_t id, Snake::Direction direction);
+
+  void tick();
+
+  [[nodiscard]] uint32_t getTick() const { return tickCount; }
+  [[nodiscard]] const MultiplayerConfig& getConfig() const { return config; }
+  [[nodiscard]] const GameGrid& getGrid() const { return grid; }
+  [[nodiscard]] const WallManager& getWallManager() const { return wallManager; }
+  [[nodiscard]] const GameItemManager& getGameItemManager() const { return gameItemManager; }
+  // indexed by player id; empty slots are free
+  [[nodiscard]] const std::vector<std::optional<MultiplayerPlayer>>& getPlayers() const { return players; }
+  [[nodiscard]] int getPlayerCount() const { return playerCount; }
+
+private:
+  static constexpr int SPAWN_ATTEMPTS = 32;
+  // free cells a new snake needs ahead of its head
+  static constexpr int SPAWN_CLEARANCE = 4;
+
+  MultiplayerConfig config;
+  const DifficultySettings& difficultySettings;
+  GameRandom random;
+  Xoshiro256 spawnRandom;
+  GameGrid grid;
+  WallManager wallManager;
+  GameItemManager gameItemManager;
+  std::vector<std::optional<MultiplayerPlayer>> players;
+  int playerCount = 0;
+  size_t nextReferencePlayer = 0;
+
+  // how many snake cells cover each cell, rebuilt whenever snakes have moved
+  std::vector<uint16_t> occupancy;
+  std::vector<uint16_t> movedPlayers;
+  std::vector<uint16_t> deadPlayers;
+
+  uint32_t tickCount = 0;
+
+  const Snake* pickReferenceSnake();
+  void spawnWaitingPlayers();
+  bool trySpawn(uint16_t id, MultiplayerPlayer& player);
+  void moveSnakes();
+  void eatItem(MultiplayerPlayer& player);
+  void rebuildOccupancy();
+  void markOccupied(const Snake& snake);
+
+  [[nodiscard]] size_t cellIndex(sf::Vector2i cell) const {
+    return static_cast<size_t>(cell.y) * static_cast<size_t>(grid.getCols()) + static_cast<size_t>(cell.x);
+  }
+  [[nodiscard]] bool isInside(sf::Vector2i cell) const { return grid.isValidPosition(cell.y, cell.x); }
+  [[nodiscard]] bool isFreeForSpawn(sf::Vector2i cell) const;
+};
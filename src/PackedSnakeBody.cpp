@@ -0,0 +1,144 @@
+#include "PackedSnakeBody.hpp"
+#include <algorithm>
+
+PackedSnakeBody::PackedSnakeBody(sf::Vector2i head) : head(head), tail(head), words(1, 0) {}
+
+std::optional<PackedSnakeBody> PackedSnakeBody::fromCells(std::span<const sf::Vector2i> cells) {
+  if (cells.empty()) {
+    return std::nullopt;
+  }
+
+  PackedSnakeBody body(cells.front());
+  for (size_t i = 1; i < cells.size(); ++i) {
+    const auto step = stepBetween(cells[i - 1], cells[i]);
+    if (!step) {
+      return std::nullopt;
+    }
+    body.pushBackLink(*step);
+  }
+  body.tail = cells.back();
+  return body;
+}
+
+void PackedSnakeBody::move(Step direction, bool grow) {
+  head += offset(direction);
+  pushFrontLink(opposite(direction));
+  if (!grow) {
+    linkCount--;
+    tail -= offset(getLink(linkCount));
+  }
+}
+
+sf::Vector2i PackedSnakeBody::getCell(size_t index) const {
+  if (index >= getLength()) {
+    return tail;
+  }
+
+  if (index <= linkCount - index) {
+    sf::Vector2i cell = head;
+    for (size_t link = 0; link < index; ++link) {
+      cell += offset(getLink(link));
+    }
+    return cell;
+  }
+  sf::Vector2i cell = tail;
+  for (size_t link = linkCount; link > index; --link) {
+    cell -= offset(getLink(link - 1));
+  }
+  return cell;
+}
+
+bool PackedSnakeBody::contains(sf::Vector2i cell) const {
+  return std::find(begin(), end(), cell) != end();
+}
+
+std::vector<sf::Vector2i> PackedSnakeBody::toCells() const {
+  std::vector<sf::Vector2i> cells;
+  cells.reserve(getLength());
+  cells.assign(begin(), end());
+  return cells;
+}
+
+SnakeSprite::SegmentType PackedSnakeBody::getSegmentType(size_t index) const {
+  if (index == 0) {
+    return SnakeSprite::SegmentType::Head;
+  } else if (index + 1 == getLength()) {
+    return SnakeSprite::SegmentType::Tail;
+  } else if (isCorner(index)) {
+    return SnakeSprite::SegmentType::BodyCorner;
+  } else {
+    return SnakeSprite::SegmentType::Body;
+  }
+}
+
+float PackedSnakeBody::getSegmentRotation(size_t index) const {
+  switch (getSegmentType(index)) {
+    case SnakeSprite::SegmentType::Body:
+      return bodyRotation(getLink(index - 1));
+    case SnakeSprite::SegmentType::BodyCorner:
+      return cornerRotation(getLink(index - 1), getLink(index));
+    case SnakeSprite::SegmentType::Tail:
+      return index > 0 ? tailRotation(getLink(index - 1)) : 0.0f;
+    default:
+      return 0.0f;
+  }
+}
+
+std::optional<PackedSnakeBody::Step> PackedSnakeBody::stepBetween(sf::Vector2i from, sf::Vector2i to) {
+  const sf::Vector2i difference = to - from;
+  for (const Step step : {Step::Up, Step::Down, Step::Left, Step::Right}) {
+    if (offset(step) == difference) {
+      return step;
+    }
+  }
+  return std::nullopt;
+}
+
+float PackedSnakeBody::bodyRotation(Step fromHead) {
+  constexpr float ROTATIONS[] = {0.0f, 180.0f, 270.0f, 90.0f};
+  return ROTATIONS[static_cast<int>(fromHead)];
+}
+
+float PackedSnakeBody::cornerRotation(Step fromHead, Step toTail) {
+  // indexed [fromHead][toTail]; straight pairs are not corners and get 0
+  constexpr float ROTATIONS[4][4] = {
+      {0.0f, 0.0f, 90.0f, 0.0f},
+      {0.0f, 0.0f, 180.0f, 270.0f},
+      {270.0f, 0.0f, 0.0f, 0.0f},
+      {180.0f, 90.0f, 0.0f, 0.0f},
+  };
+  return ROTATIONS[static_cast<int>(fromHead)][static_cast<int>(toTail)];
+}
+
+float PackedSnakeBody::tailRotation(Step fromHead) {
+  constexpr float ROTATIONS[] = {180.0f, 0.0f, 90.0f, 270.0f};
+  return ROTATIONS[static_cast<int>(fromHead)];
+}
+
+void PackedSnakeBody::pushFrontLink(Step step) {
+  if (linkCount == slotCapacity()) {
+    grow();
+  }
+  first = (first + slotCapacity() - 1) & (slotCapacity() - 1);
+  setSlot(first, step);
+  linkCount++;
+}
+
+void PackedSnakeBody::pushBackLink(Step step) {
+  if (linkCount == slotCapacity()) {
+    grow();
+  }
+  setSlot((first + linkCount) & (slotCapacity() - 1), step);
+  linkCount++;
+}
+
+// doubles the ring and unrolls it so the links start at slot 0
+void PackedSnakeBody::grow() {
+  PackedSnakeBody grown(head);
+  grown.words.assign(words.size() * 2, 0);
+  for (size_t link = 0; link < linkCount; ++link) {
+    grown.setSlot(link, getLink(link));
+  }
+  words.swap(grown.words);
+  first = 0;
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <vector>
+#include "SnakeSprite.hpp"
+
+// Snake body for giant snakes: the head and tail cells plus, for every pair of neighbouring segments, the
+// 2-bit step from one to the next, packed 32 to a word in a ring buffer. A 1M-segment snake takes 256 KB
+// instead of the 8 MB of a std::vector<sf::Vector2i>. Moving pushes one step at the head end and drops one
+// at the tail end, both O(1). Cells are rebuilt on demand by walking the steps, while segment types and
+// sprite rotations come straight from the steps either side of a segment, with the same results as Snake.
+class PackedSnakeBody {
+public:
+  // same order as Snake::Direction
+  enum class Step : uint8_t { Up, Down, Left, Right };
+
+  explicit PackedSnakeBody(sf::Vector2i head);
+  // nullopt unless every cell is one step from the one before it
+  static std::optional<PackedSnakeBody> fromCells(std::span<const sf::Vector2i> cells);
+
+  // moves the head one cell, dropping the tail unless the snake grows
+  void move(Step direction, bool grow);
+
+  [[nodiscard]] sf::Vector2i getHead() const { return head; }
+  [[nodiscard]] sf::Vector2i getTail() const { return tail; }
+  [[nodiscard]] size_t getLength() const { return linkCount + 1; }
+
+  // step from segment link to segment link + 1, towards the tail
+  [[nodiscard]] Step getLink(size_t link) const {
+    const size_t slot = (first + link) & (slotCapacity() - 1);
+    return static_cast<Step>(words[slot / SLOTS_PER_WORD] >> (slot % SLOTS_PER_WORD * 2) & 3);
+  }
+
+  // walks from whichever end is nearer, so O(min(index, length - index))
+  [[nodiscard]] sf::Vector2i getCell(size_t index) const;
+  [[nodiscard]] bool contains(sf::Vector2i cell) const;
+  [[nodiscard]] std::vector<sf::Vector2i> toCells() const;
+
+  [[nodiscard]] SnakeSprite::SegmentType getSegmentType(size_t index) const;
+  [[nodiscard]] bool isCorner(size_t index) const {
+    return index > 0 && index + 1 < getLength() && getLink(index - 1) != getLink(index);
+  }
+  // rotation of the sprite Snake::render draws for a body, corner or tail segment
+  [[nodiscard]] float getSegmentRotation(size_t index) const;
+
+  // bytes of the step buffer
+  [[nodiscard]] size_t getMemoryBytes() const { return words.capacity() * sizeof(uint64_t); }
+
+  static sf::Vector2i offset(Step step) {
+    constexpr sf::Vector2i OFFSETS[] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    return OFFSETS[static_cast<int>(step)];
+  }
+  static Step opposite(Step step) { return static_cast<Step>(static_cast<int>(step) ^ 1); }
+  // nullopt for cells that are not neighbours
+  static std::optional<Step> stepBetween(sf::Vector2i from, sf::Vector2i to);
+
+  // toTail is the step from the segment to the one behind it, fromHead the step into it from the one ahead
+  static float bodyRotation(Step fromHead);
+  static float cornerRotation(Step fromHead, Step toTail);
+  static float tailRotation(Step fromHead);
+
+  // cells from head to tail
+  class CellIterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = sf::Vector2i;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const sf::Vector2i*;
+    using reference = const sf::Vector2i&;
+
+    CellIterator(const PackedSnakeBody* body, size_t index, sf::Vector2i cell) : body(body), index(index), cell(cell) {}
+
+    reference operator*() const { return cell; }
+    CellIterator& operator++() {
+      if (index < body->linkCount) {
+        cell += offset(body->getLink(index));
+      }
+      ++index;
+      return *this;
+    }
+    CellIterator operator++(int) {
+      CellIterator previous = *this;
+      ++*this;
+      return previous;
+    }
+    bool operator==(const CellIterator& other) const { return index == other.index; }
+
+  private:
+    const PackedSnakeBody* body;
+    size_t index;
+    sf::Vector2i cell;
+  };
+
+  [[nodiscard]] CellIterator begin() const { return CellIterator(this, 0, head); }
+  [[nodiscard]] CellIterator end() const { return CellIterator(this, getLength(), tail); }
+
+private:
+  static constexpr size_t SLOTS_PER_WORD = 32;
+
+  sf::Vector2i head;
+  sf::Vector2i tail;
+  // ring buffer of links; its slot count is a power of two
+  std::vector<uint64_t> words;
+  size_t first = 0;
+  size_t linkCount = 0;
+
+  [[nodiscard]] size_t slotCapacity() const { return words.size() * SLOTS_PER_WORD; }
+  void setSlot(size_t slot, Step step) {
+    const size_t shift = slot % SLOTS_PER_WORD * 2;
+    uint64_t& word = words[slot / SLOTS_PER_WORD];
+    word = (word & ~(uint64_t{3} << shift)) | uint64_t{static_cast<uint8_t>(step)} << shift;
+  }
+  void pushFrontLink(Step step);
+  void pushBackLink(Step step);
+  void grow();
+};
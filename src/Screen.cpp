@@ -1,3 +1,4 @@
 #include "Screen.hpp"
 
-Screen::Screen(sf::RenderWindow& win, Game& gameRef) : window(win), game(gameRef) {}
+Screen::Screen(sf::RenderWindow& win, Game& gameRef, const ResourceSet& resourceSet)
+    : resources(resourceSet), window(win), game(gameRef) {}
@@ -1,14 +1,18 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "utils/ResourceLoader.hpp"
 
 class Game;
 
 class Screen {
+private:
+  ResourceScope resources;
+
 protected:
   sf::RenderWindow& window;
 
 public:
-  explicit Screen(sf::RenderWindow& win, Game& gameRef);
+  explicit Screen(sf::RenderWindow& win, Game& gameRef, const ResourceSet& resourceSet = {});
 
   virtual ~Screen() = default;
 
@@ -19,4 +23,6 @@ public:
   virtual void update() = 0;
 
   virtual void render() = 0;
+
+  virtual const ResourceSet* getPrefetchSet() const { return nullptr; }
 };
@@ -2,9 +2,11 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
-#include <random>
 #include "SnakeSprite.hpp"
+#include "utils/FrameProfiler.hpp"
 #include "utils/GameGrid.hpp"
+#include "utils/GameSnapshot.hpp"
+#include "utils/ZobristHash.hpp"
 
 Snake::Snake(sf::Vector2i startPosition, int initialLength)
     : currentDirection(Direction::Right),
@@ -14,7 +16,6 @@ Snake::Snake(sf::Vector2i startPosition, int initialLength)
       growthEnabled(false),
       snakeSprite(SnakeSprite::SnakeType::Green),
       speed(1.0f),
-      tongueSprite(snakeSprite.getTongueLowSprite()),
       tongueTimer(0.0f),
       tongueVisible(false) {
 
@@ -22,6 +23,8 @@ Snake::Snake(sf::Vector2i startPosition, int initialLength)
   for (int i = 0; i < initialLength; ++i) {
     body.push_back(sf::Vector2i(startPosition.x - i, startPosition.y));
   }
+  rebuildOrientations();
+  zobristHash = computeZobristHash();
 }
 
 void Snake::move() {
@@ -34,16 +37,36 @@ void Snake::move() {
 
   sf::Vector2i newHead = getNextHeadPosition();
 
+  zobristHash ^= zobrist::key(ZobristFeature::SnakeHead, body.front()) ^
+                 zobrist::key(ZobristFeature::SnakeHead, newHead) ^ zobrist::key(ZobristFeature::SnakeBody, newHead);
   body.insert(body.begin(), newHead);
+  orientations.insert(orientations.begin(), SegmentOrientation{SnakeSprite::SegmentType::Head});
 
   if (!growthEnabled) {
+    zobristHash ^= zobrist::key(ZobristFeature::SnakeBody, body.back());
     body.pop_back();
+    orientations.pop_back();
+  }
+
+  for (const int index : {1, getLength() - 1}) {
+    if (index > 0 && index < getLength()) {
+      orientations[index] = computeSegmentOrientation(index);
+    }
   }
 
   growthEnabled = false;
   directionChanged = false;
 }
 
+void Snake::updateTimers(float deltaTime) {
+  disorientedElapsed += deltaTime;
+  invincibleElapsed += deltaTime;
+  speedMultiplierElapsed += deltaTime;
+  temporarySpeedElapsed += deltaTime;
+  fantomSpeedElapsed += deltaTime;
+  automaticSpeedElapsed += deltaTime;
+}
+
 void Snake::setDirection(Direction newDirection) {
   if (disoriented) {
     switch (newDirection) {
@@ -136,6 +159,8 @@ void Snake::reset(sf::Vector2i startPosition, int initialLength) {
   for (int i = 0; i < initialLength; ++i) {
     body.push_back(sf::Vector2i(startPosition.x - i, startPosition.y));
   }
+  rebuildOrientations();
+  zobristHash = computeZobristHash();
   currentDirection = Direction::Right;
   nextDirection = Direction::Right;
   alive = true;
@@ -163,17 +188,17 @@ void Snake::render(sf::RenderWindow& window, const GameGrid& grid) const {
   }
 
   for (size_t i = 0; i < body.size(); ++i) {
-    SnakeSprite::SegmentType segmentType = getSegmentType(static_cast<int>(i));
+    const SegmentOrientation& orientation = orientations[i];
     sf::Sprite segment = [&]() -> sf::Sprite {
-      switch (segmentType) {
+      switch (orientation.type) {
         case SnakeSprite::SegmentType::Head:
           return snakeSprite.getHeadSprite(getDirectionRotation());
         case SnakeSprite::SegmentType::Body:
-          return snakeSprite.getBodySprite(getBodySegmentRotation(static_cast<int>(i)));
+          return snakeSprite.getBodySprite(orientation.rotation);
         case SnakeSprite::SegmentType::BodyCorner:
-          return snakeSprite.getBodyCornerSprite(getBodyCornerRotation(static_cast<int>(i)));
+          return snakeSprite.getBodyCornerSprite(orientation.rotation);
         case SnakeSprite::SegmentType::Tail:
-          return snakeSprite.getTailSprite(getTailRotation());
+          return snakeSprite.getTailSprite(orientation.rotation);
         default:
           return snakeSprite.getBodySprite();
       }
@@ -195,10 +220,10 @@ void Snake::render(sf::RenderWindow& window, const GameGrid& grid) const {
       segment.setColor(sf::Color::White);
     }
 
-    window.draw(segment);
+    FrameProfiler::draw(window, segment);
   }
 
-  updateTongue(grid);
+  updateTongue();
 
   if (tongueVisible && isAlive()) {
     sf::Vector2f headPosition = grid.getCellPosition(body[0].y, body[0].x);
@@ -220,6 +245,9 @@ void Snake::render(sf::RenderWindow& window, const GameGrid& grid) const {
         break;
     }
 
+    sf::Sprite tongueSprite = tongueHigh ? snakeSprite.getTongueHighSprite(getDirectionRotation())
+                                         : snakeSprite.getTongueLowSprite(getDirectionRotation());
+    tongueSprite.setColor(sf::Color(255, 255, 255, tongueHidden ? 0 : 255));
     tongueSprite.setPosition(headPosition + centerOffset + tongueOffset);
 
     float scale = grid.getScaledCellSize() / 28.0f;
@@ -228,7 +256,7 @@ void Snake::render(sf::RenderWindow& window, const GameGrid& grid) const {
 
     tongueSprite.setRotation(sf::degrees(getDirectionRotation()));
 
-    window.draw(tongueSprite);
+    FrameProfiler::draw(window, tongueSprite);
   }
 }
 
@@ -236,7 +264,7 @@ void Snake::updateDirection() {
   currentDirection = nextDirection;
 }
 
-void Snake::updateTongue(const GameGrid& grid) const {
+void Snake::updateTongue() const {
   if (!isAlive()) {
     tongueVisible = false;
     return;
@@ -251,22 +279,12 @@ void Snake::updateTongue(const GameGrid& grid) const {
     }
 
   } else {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> dis(0.0f, 1.0f);
-
-    if (dis(gen) < 0.3f) {
+    if (unitRandom(cosmeticRandom) < 0.3f) {
       tongueVisible = true;
       tongueTimer = 0.0f;
 
-      tongueSprite = (dis(gen) < 0.5f) ? snakeSprite.getTongueLowSprite(getDirectionRotation())
-                                       : snakeSprite.getTongueHighSprite(getDirectionRotation());
-
-      if (dis(gen) < 0.8f) {
-        tongueSprite.setColor(sf::Color(255, 255, 255, 255));
-      } else {
-        tongueSprite.setColor(sf::Color(255, 255, 255, 0));
-      }
+      tongueHigh = unitRandom(cosmeticRandom) >= 0.5f;
+      tongueHidden = unitRandom(cosmeticRandom) >= 0.8f;
     }
   }
 }
@@ -394,6 +412,27 @@ SnakeSprite::SegmentType Snake::getSegmentType(int segmentIndex) const {
   }
 }
 
+Snake::SegmentOrientation Snake::computeSegmentOrientation(int segmentIndex) const {
+  const SnakeSprite::SegmentType type = getSegmentType(segmentIndex);
+  switch (type) {
+    case SnakeSprite::SegmentType::Body:
+      return SegmentOrientation{type, getBodySegmentRotation(segmentIndex)};
+    case SnakeSprite::SegmentType::BodyCorner:
+      return SegmentOrientation{type, getBodyCornerRotation(segmentIndex)};
+    case SnakeSprite::SegmentType::Tail:
+      return SegmentOrientation{type, getTailRotation()};
+    default:
+      return SegmentOrientation{type};
+  }
+}
+
+void Snake::rebuildOrientations() {
+  orientations.resize(body.size());
+  for (int i = 0; i < getLength(); ++i) {
+    orientations[i] = computeSegmentOrientation(i);
+  }
+}
+
 bool Snake::isBodyCorner(int segmentIndex) const {
   if (segmentIndex <= 0 || segmentIndex >= static_cast<int>(body.size()) - 1) {
     return false;
@@ -413,7 +452,7 @@ void Snake::setDisoriented(bool disoriented, float duration) {
   this->disoriented = disoriented;
   if (disoriented) {
     disorientedDuration = duration;
-    disorientedTimer.restart();
+    disorientedElapsed = 0.0f;
   }
 }
 
@@ -421,7 +460,7 @@ void Snake::setInvincible(bool invincible, float duration) {
   this->invincible = invincible;
   if (invincible) {
     invincibleDuration = duration;
-    invincibleTimer.restart();
+    invincibleElapsed = 0.0f;
   } else {
     invincibleDuration = 0.0f;
     snakeSprite.setType(SnakeSprite::SnakeType::Purple);
@@ -446,7 +485,7 @@ void Snake::setSpeedMultiplier(float multiplier, float duration) {
   this->speedMultiplier = multiplier;
   if (duration > 0.0f) {
     speedMultiplierDuration = duration;
-    speedMultiplierTimer.restart();
+    speedMultiplierElapsed = 0.0f;
   }
 }
 
@@ -456,7 +495,7 @@ void Snake::decreaseSpeed(float amount) {
 
 void Snake::updateEffects() {
   if (disoriented && disorientedDuration > 0.0f) {
-    if (disorientedTimer.getElapsedTime().asSeconds() >= disorientedDuration) {
+    if (disorientedElapsed >= disorientedDuration) {
       disoriented = false;
       disorientedDuration = 0.0f;
 
@@ -466,7 +505,7 @@ void Snake::updateEffects() {
   }
 
   if (invincible && invincibleDuration > 0.0f) {
-    if (invincibleTimer.getElapsedTime().asSeconds() >= invincibleDuration) {
+    if (invincibleElapsed >= invincibleDuration) {
       invincible = false;
       invincibleDuration = 0.0f;
 
@@ -476,7 +515,7 @@ void Snake::updateEffects() {
   }
 
   if (speedMultiplierDuration > 0.0f) {
-    if (speedMultiplierTimer.getElapsedTime().asSeconds() >= speedMultiplierDuration) {
+    if (speedMultiplierElapsed >= speedMultiplierDuration) {
       speedMultiplier = 1.0f;
       speedMultiplierDuration = 0.0f;
 
@@ -486,7 +525,7 @@ void Snake::updateEffects() {
   }
 
   if (temporarySpeedDuration > 0.0f) {
-    if (temporarySpeedTimer.getElapsedTime().asSeconds() >= temporarySpeedDuration) {
+    if (temporarySpeedElapsed >= temporarySpeedDuration) {
       speed -= temporarySpeedBonus;
       temporarySpeedBonus = 0.0f;
       temporarySpeedDuration = 0.0f;
@@ -497,7 +536,7 @@ void Snake::updateEffects() {
   }
 
   if (fantomSpeedDuration > 0.0f) {
-    if (fantomSpeedTimer.getElapsedTime().asSeconds() >= fantomSpeedDuration) {
+    if (fantomSpeedElapsed >= fantomSpeedDuration) {
       speed -= fantomSpeedBonus;
       fantomSpeedBonus = 0.0f;
       fantomSpeedDuration = 0.0f;
@@ -507,12 +546,101 @@ void Snake::updateEffects() {
     }
   }
 
-  if (automaticSpeedTimer.getElapsedTime().asSeconds() >= AUTOMATIC_SPEED_INTERVAL) {
+  if (automaticSpeedElapsed >= AUTOMATIC_SPEED_INTERVAL) {
     speed += 1.0f;
-    automaticSpeedTimer.restart();
+    automaticSpeedElapsed = 0.0f;
   }
 }
 
 SnakeSprite::SnakeType Snake::getSnakeType() const {
   return snakeSprite.getType();
-}
\ No newline at end of file
+}
+
+uint64_t Snake::computeZobristHash() const {
+  uint64_t hash = body.empty() ? 0 : zobrist::key(ZobristFeature::SnakeHead, body.front());
+  for (const auto& segment : body) {
+    hash ^= zobrist::key(ZobristFeature::SnakeBody, segment);
+  }
+  return hash;
+}
+
+void Snake::saveState(SnapshotWriter& writer) const {
+  writer.write(static_cast<uint16_t>(body.size()));
+  for (const auto& segment : body) {
+    writer.writePosition(segment);
+  }
+  writer.write(static_cast<uint8_t>(currentDirection));
+  writer.write(static_cast<uint8_t>(nextDirection));
+  writer.write(alive);
+  writer.write(directionChanged);
+  writer.write(growthEnabled);
+  writer.write(speed);
+
+  writer.write(disoriented);
+  writer.write(disorientedElapsed);
+  writer.write(disorientedDuration);
+  writer.write(invincible);
+  writer.write(invincibleElapsed);
+  writer.write(invincibleDuration);
+  writer.write(speedMultiplier);
+  writer.write(speedMultiplierElapsed);
+  writer.write(speedMultiplierDuration);
+  writer.write(temporarySpeedBonus);
+  writer.write(temporarySpeedDuration);
+  writer.write(temporarySpeedElapsed);
+  writer.write(fantomSpeedBonus);
+  writer.write(fantomSpeedDuration);
+  writer.write(fantomSpeedElapsed);
+  writer.write(automaticSpeedElapsed);
+
+  writer.write(static_cast<uint8_t>(snakeSprite.getType()));
+  writer.write(hasTemporaryType);
+}
+
+void Snake::restoreState(SnapshotReader& reader) {
+  const auto length = reader.read<uint16_t>();
+  body.resize(length);
+  for (auto& segment : body) {
+    segment = reader.readPosition();
+  }
+  rebuildOrientations();
+  zobristHash = computeZobristHash();
+  const auto current = reader.read<uint8_t>();
+  const auto next = reader.read<uint8_t>();
+  if (current > static_cast<uint8_t>(Direction::Right) || next > static_cast<uint8_t>(Direction::Right)) {
+    reader.fail();
+    return;
+  }
+  currentDirection = static_cast<Direction>(current);
+  nextDirection = static_cast<Direction>(next);
+  alive = reader.read<uint8_t>() != 0;
+  directionChanged = reader.read<uint8_t>() != 0;
+  growthEnabled = reader.read<uint8_t>() != 0;
+  speed = reader.read<float>();
+
+  disoriented = reader.read<uint8_t>() != 0;
+  disorientedElapsed = reader.read<float>();
+  disorientedDuration = reader.read<float>();
+  invincible = reader.read<uint8_t>() != 0;
+  invincibleElapsed = reader.read<float>();
+  invincibleDuration = reader.read<float>();
+  speedMultiplier = reader.read<float>();
+  speedMultiplierElapsed = reader.read<float>();
+  speedMultiplierDuration = reader.read<float>();
+  temporarySpeedBonus = reader.read<float>();
+  temporarySpeedDuration = reader.read<float>();
+  temporarySpeedElapsed = reader.read<float>();
+  fantomSpeedBonus = reader.read<float>();
+  fantomSpeedDuration = reader.read<float>();
+  fantomSpeedElapsed = reader.read<float>();
+  automaticSpeedElapsed = reader.read<float>();
+
+  const auto type = reader.read<uint8_t>();
+  if (type > static_cast<uint8_t>(SnakeSprite::SnakeType::Black)) {
+    reader.fail();
+    return;
+  }
+  snakeSprite.setType(static_cast<SnakeSprite::SnakeType>(type));
+  hasTemporaryType = reader.read<uint8_t>() != 0;
+  tongueVisible = false;
+}
@@ -1,8 +1,11 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include "utils/GameRandom.hpp"
 
 class GameGrid;
+class SnapshotReader;
+class SnapshotWriter;
 
 #include "SnakeSprite.hpp"
 
@@ -13,6 +16,7 @@ public:
   explicit Snake(sf::Vector2i startPosition, int initialLength = 3);
 
   void move();
+  void updateTimers(float deltaTime);
   void setDirection(Direction newDirection);
   Direction getDirection() const { return currentDirection; }
 
@@ -37,6 +41,22 @@ public:
     tongueVisible = false;
   }
   void reset(sf::Vector2i startPosition, int initialLength = 3);
+  // room for the body to grow to maxLength without reallocating while it moves
+  void reserveLength(int maxLength) {
+    body.reserve(static_cast<size_t>(maxLength));
+    orientations.reserve(static_cast<size_t>(maxLength));
+  }
+
+  struct SegmentOrientation {
+    SnakeSprite::SegmentType type = SnakeSprite::SegmentType::Body;
+    float rotation = 0.0f;
+  };
+  // Sprite type and rotation of every segment, one per body cell. move() updates the entries of the old
+  // head and the tail, the only segments whose neighbours change. The head's rotation follows the current
+  // direction and is not stored.
+  const std::vector<SegmentOrientation>& getSegmentOrientations() const { return orientations; }
+  // worked out from the neighbouring cells
+  SegmentOrientation computeSegmentOrientation(int segmentIndex) const;
 
   void setDisoriented(bool disoriented, float duration = 0.0f);
   void setInvincible(bool invincible, float duration = 0.0f);
@@ -54,9 +74,19 @@ public:
   void setSpeed(float speed) { this->speed = speed; }
   void decreaseSpeed(float amount);
   void setBlinking(bool blinking) { this->blinking = blinking; }
+  void seedCosmetics(uint64_t seed) { cosmeticRandom.seed(seed); }
+
+  void saveState(SnapshotWriter& writer) const;
+  void restoreState(SnapshotReader& reader);
+
+  // Zobrist hash of the occupied cells and the head, updated by move() in O(1)
+  uint64_t getZobristHash() const { return zobristHash; }
+  uint64_t computeZobristHash() const;
 
 private:
   std::vector<sf::Vector2i> body;
+  std::vector<SegmentOrientation> orientations;
+  uint64_t zobristHash = 0;
   Direction currentDirection;
   Direction nextDirection;
   bool alive;
@@ -64,16 +94,15 @@ private:
   bool growthEnabled;
   SnakeSprite snakeSprite;
   float speed;
-  mutable sf::Sprite tongueSprite;
   bool blinking = false;
   mutable sf::Clock blinkTimer;
 
   bool disoriented = false;
   bool invincible = false;
   float speedMultiplier = 1.0f;
-  sf::Clock disorientedTimer;
-  sf::Clock invincibleTimer;
-  sf::Clock speedMultiplierTimer;
+  float disorientedElapsed = 0.0f;
+  float invincibleElapsed = 0.0f;
+  float speedMultiplierElapsed = 0.0f;
   float disorientedDuration = 0.0f;
   float invincibleDuration = 0.0f;
   float speedMultiplierDuration = 0.0f;
@@ -83,17 +112,20 @@ private:
 
   float temporarySpeedBonus = 0.0f;
   float temporarySpeedDuration = 0.0f;
-  sf::Clock temporarySpeedTimer;
+  float temporarySpeedElapsed = 0.0f;
 
   float fantomSpeedBonus = 0.0f;
   float fantomSpeedDuration = 0.0f;
-  sf::Clock fantomSpeedTimer;
+  float fantomSpeedElapsed = 0.0f;
 
-  sf::Clock automaticSpeedTimer;
+  float automaticSpeedElapsed = 0.0f;
   static constexpr float AUTOMATIC_SPEED_INTERVAL = 5.0f;
 
   mutable float tongueTimer;
   mutable bool tongueVisible = false;
+  mutable bool tongueHigh = false;
+  mutable bool tongueHidden = false;
+  mutable Xoshiro256 cosmeticRandom;
   static constexpr float TONGUE_DURATION = 0.5f;
 
   void updateDirection();
@@ -105,6 +137,7 @@ private:
   float getTailRotation() const;
   SnakeSprite::SegmentType getSegmentType(int segmentIndex) const;
   bool isBodyCorner(int segmentIndex) const;
+  void rebuildOrientations();
 
-  void updateTongue(const GameGrid& grid) const;
+  void updateTongue() const;
 };
@@ -1,30 +1,28 @@
 #include "SnakeSprite.hpp"
 #include "utils/ResourceLoader.hpp"
 
-SnakeSprite::SnakeSprite(SnakeType type) : currentType(type) {
-  loadTexture();
-}
+SnakeSprite::SnakeSprite(SnakeType type) : currentType(type) {}
 
 sf::Sprite SnakeSprite::getHeadSprite() const {
-  sf::Sprite sprite(texture);
+  sf::Sprite sprite(getTexture());
   sprite.setTextureRect(getSpriteRect(SegmentType::Head));
   return sprite;
 }
 
 sf::Sprite SnakeSprite::getBodySprite() const {
-  sf::Sprite sprite(texture);
+  sf::Sprite sprite(getTexture());
   sprite.setTextureRect(getSpriteRect(SegmentType::Body));
   return sprite;
 }
 
 sf::Sprite SnakeSprite::getBodyCornerSprite() const {
-  sf::Sprite sprite(texture);
+  sf::Sprite sprite(getTexture());
   sprite.setTextureRect(getSpriteRect(SegmentType::BodyCorner));
   return sprite;
 }
 
 sf::Sprite SnakeSprite::getTailSprite() const {
-  sf::Sprite sprite(texture);
+  sf::Sprite sprite(getTexture());
   sprite.setTextureRect(getSpriteRect(SegmentType::Tail));
   return sprite;
 }
@@ -58,13 +56,13 @@ sf::Sprite SnakeSprite::getTailSprite(float rotation) const {
 }
 
 sf::Sprite SnakeSprite::getTongueLowSprite() const {
-  sf::Sprite sprite(texture);
+  sf::Sprite sprite(getTexture());
   sprite.setTextureRect(getTongueSpriteRect(1));
   return sprite;
 }
 
 sf::Sprite SnakeSprite::getTongueHighSprite() const {
-  sf::Sprite sprite(texture);
+  sf::Sprite sprite(getTexture());
   sprite.setTextureRect(getTongueSpriteRect(2));
   return sprite;
 }
@@ -128,8 +126,10 @@ sf::IntRect SnakeSprite::getTongueSpriteRect(int tongueType) const {
   return sf::IntRect(sf::Vector2i(x, y), sf::Vector2i(SPRITE_WIDTH, SPRITE_HEIGHT));
 }
 
-bool SnakeSprite::loadTexture() {
-  const auto& textureRef = ResourceLoader::getTexture(TextureType::Snake);
-  texture = textureRef;
-  return true;
+const sf::Texture& SnakeSprite::getTexture() const {
+  if (!textureLoaded) {
+    texture = ResourceLoader::getTexture(TextureType::Snake);
+    textureLoaded = true;
+  }
+  return texture;
 }
\ No newline at end of file
@@ -29,7 +29,9 @@ public:
 
 private:
   SnakeType currentType;
-  sf::Texture texture;
+  // loaded on first draw, so a headless simulation never touches the texture cache
+  mutable sf::Texture texture;
+  mutable bool textureLoaded = false;
 
   static constexpr int SPRITE_WIDTH = 28;
   static constexpr int SPRITE_HEIGHT = 28;
@@ -51,5 +53,5 @@ private:
   sf::IntRect getSpriteRect(SegmentType segment) const;
   sf::IntRect getTongueSpriteRect(int tongueType) const;
 
-  bool loadTexture();
+  const sf::Texture& getTexture() const;
 };
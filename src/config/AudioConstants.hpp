@@ -3,7 +3,10 @@
 namespace AudioConstants {
 namespace Music {
 constexpr float BACKGROUND_MUSIC_VOLUME = 2.0f;
-}
+constexpr float PREFETCH_SECONDS = 2.0f;
+constexpr unsigned DECODE_BLOCK_FRAMES = 4096;
+constexpr unsigned CHUNK_FRAMES = 2048;
+}  // namespace Music
 
 namespace SoundEffects {
 constexpr float MENU_NAVIGATION_VOLUME = 3.0f;
@@ -13,4 +16,12 @@ constexpr float EAT_APPLE_VOLUME = 3.0f;
 constexpr float START_GAME_VOLUME = 3.0f;
 constexpr float COUNTDOWN_VOLUME = 3.0f;
 }  // namespace SoundEffects
-}  // namespace AudioConstants
\ No newline at end of file
+
+namespace Voices {
+constexpr int POOL_SIZE = 12;
+constexpr int GAMEPLAY_LIMIT = 8;
+constexpr int MENU_LIMIT = 2;
+constexpr int COUNTDOWN_LIMIT = 1;
+constexpr int REQUEST_QUEUE_CAPACITY = 64;
+}  // namespace Voices
+}  // namespace AudioConstants
@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+
+namespace ResourceConstants {
+// Unreferenced resources are evicted (least recently used first) at screen transitions
+// until each kind fits its budget. Referenced resources are never evicted.
+namespace MemoryBudget {
+constexpr std::size_t TEXTURES = 16 * 1024 * 1024;
+constexpr std::size_t FONTS = 512 * 1024;
+constexpr std::size_t SOUNDS = 8 * 1024 * 1024;
+constexpr std::size_t MUSIC = 0;
+}  // namespace MemoryBudget
+}  // namespace ResourceConstants
@@ -1,8 +1,251 @@
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
 #include "Game.hpp"
+#include "screens/ReplayScreen.hpp"
+#include "utils/AudioService.hpp"
+#include "utils/FrameProfiler.hpp"
+#include "utils/Logger.hpp"
 #include "utils/ResourceLoader.hpp"
+#include "utils/TraceRecorder.hpp"
+#include "utils/autopilot/Autopilot.hpp"
+#include "utils/autopilot/MctsBot.hpp"
+#include "utils/net/GameServer.hpp"
+#include "utils/net/UdpTransport.hpp"
+#include "utils/replay/ReplayPlayer.hpp"
+
+namespace {
+int runReplay(const std::string& path) {
+  const auto replay = ReplayFile::load(path);
+  if (!replay) {
+    return 2;
+  }
+
+  const ReplayResult result = ReplayPlayer::play(*replay);
+  std::printf("ticks %u/%u, score %d, state %016llx, recorded %016llx: %s\n", result.ticks, replay->finalTick,
+              result.score, static_cast<unsigned long long>(result.stateHash),
+              static_cast<unsigned long long>(replay->finalStateHash), result.matches ? "match" : "MISMATCH");
+  if (result.divergedAtTick) {
+    std::printf("first diverging keyframe at tick %u\n", *result.divergedAtTick);
+  }
+  return result.matches ? 0 : 1;
+}
+
+int runSeek(const std::string& path, uint32_t tick) {
+  const auto replay = ReplayFile::load(path);
+  if (!replay) {
+    return 2;
+  }
+
+  ReplayPlayer player(*replay);
+  const auto start = std::chrono::steady_clock::now();
+  player.seek(tick);
+  const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+  std::printf("tick %u/%u, score %d, state %016llx, seek %.2f ms (%zu keyframes)\n", player.getTick(),
+              replay->finalTick, player.getSimulation().getScore(),
+              static_cast<unsigned long long>(player.getSimulation().computeStateHash()), elapsed.count(),
+              replay->keyframes.size());
+  return 0;
+}
+
+// plays a whole game with the path-following autopilot, or with the search bot when mctsThreads is set
+int runBot(uint64_t seed, int difficulty, std::optional<unsigned> mctsThreads) {
+  Replay replay;
+  replay.config.seed = seed;
+  replay.config.difficulty = static_cast<GameDifficultyLevel>(std::clamp(difficulty, 0, 4));
+
+  GameSimulation simulation(replay.config);
+  Autopilot autopilot(GameSimulation::GRID_COLS, GameSimulation::GRID_ROWS);
+  const auto mcts = mctsThreads ? std::make_unique<MctsBot>(*mctsThreads) : nullptr;
+  while (!simulation.isGameOver()) {
+    const auto input = mcts ? mcts->update(simulation) : autopilot.update(simulation);
+    if (input) {
+      replay.events.push_back(ReplayEvent{simulation.getTick(), *input});
+      ReplayPlayer::applyInput(simulation, *input);
+    }
+    simulation.tick();
+    ReplayFile::captureKeyframe(replay, simulation);
+  }
+
+  replay.finalTick = simulation.getTick();
+  replay.finalStateHash = simulation.computeStateHash();
+  const auto path = ReplayFile::saveSession(replay);
+  std::printf("seed %llu: score %d, length %d, %.0f s, replay %s\n", static_cast<unsigned long long>(seed),
+              simulation.getScore(), simulation.getSnake().getLength(), simulation.getGameplaySeconds(),
+              path ? path->c_str() : "not saved");
+  if (mcts) {
+    const MctsSearchStats& stats = mcts->getTotalStats();
+    std::printf("%u threads: %.0f iterations/s, %.0f nodes/s\n", mcts->getThreadCount(),
+                static_cast<double>(stats.iterations) / stats.seconds, static_cast<double>(stats.nodes) / stats.seconds);
+  } else {
+    std::printf("%llu searches\n", static_cast<unsigned long long>(autopilot.getSearchCount()));
+  }
+  return 0;
+}
+
+constexpr int ALLOCATION_CHECK_SPEED = 8;
+constexpr int ALLOCATION_CHECK_REPORTED_FRAMES = 10;
+
+// Plays a replay on screen and fails when any frame after the warmup allocated on the heap inside update
+// or render. Loading textures, laying out glyphs and growing containers to their working size is what the
+// warmup is for; after it the game loop must run out of memory it already holds.
+int runAllocationCheck(const std::string& path, int warmupFrames) {
+  auto replay = ReplayFile::load(path);
+  if (!replay) {
+    return 2;
+  }
+
+  sf::RenderWindow window(sf::VideoMode(sf::Vector2u(800, 600)), "Snake Game - allocation check");
+  ResourceLoader::initializeAllResources();
+  Game game(window);
+  auto* screen = new ReplayScreen(window, game, std::move(*replay));
+  screen->setPlaybackSpeed(ALLOCATION_CHECK_SPEED);
+  game.setCurrentScreen(screen);
+
+  FrameProfiler& profiler = FrameProfiler::getInstance();
+  profiler.setRecording(true);
+
+  constexpr std::array CHECKED_ZONES = {ProfileZone::Update, ProfileZone::Simulation, ProfileZone::Render,
+                                        ProfileZone::Walls,  ProfileZone::Items,      ProfileZone::Snake};
+  std::array<uint64_t, CHECKED_ZONES.size()> zoneTotals{};
+  int frames = 0;
+  int allocatingFrames = 0;
+  // leaving the replay screen, by Escape or by closing the window, ends the check early
+  while (window.isOpen() && game.getCurrentScreen() == screen && !screen->isFinished()) {
+    game.runFrame();
+    if (++frames <= warmupFrames) {
+      continue;
+    }
+
+    const uint64_t update = profiler.getLastFrameAllocations(ProfileZone::Update);
+    const uint64_t render = profiler.getLastFrameAllocations(ProfileZone::Render);
+    if (update + render == 0) {
+      continue;
+    }
+    allocatingFrames++;
+    for (size_t i = 0; i < CHECKED_ZONES.size(); ++i) {
+      zoneTotals[i] += profiler.getLastFrameAllocations(CHECKED_ZONES[i]);
+    }
+    if (allocatingFrames <= ALLOCATION_CHECK_REPORTED_FRAMES) {
+      std::printf("frame %d allocated: update %llu, render %llu\n", frames, static_cast<unsigned long long>(update),
+                  static_cast<unsigned long long>(render));
+    }
+  }
+  profiler.setRecording(false);
+  AudioService::getInstance().shutdown();
+
+  if (frames <= warmupFrames) {
+    std::printf("the replay ended after %d frames, within the %d warmup frames\n", frames, warmupFrames);
+    return 2;
+  }
+  std::printf("%d frames checked after %d warmup frames, %d allocated\n", frames - warmupFrames, warmupFrames,
+              allocatingFrames);
+  for (size_t i = 0; i < CHECKED_ZONES.size(); ++i) {
+    if (zoneTotals[i] > 0) {
+      std::printf("  %-12s %llu allocations\n", FrameProfiler::getZoneName(CHECKED_ZONES[i]),
+                  static_cast<unsigned long long>(zoneTotals[i]));
+    }
+  }
+  return allocatingFrames > 0 ? 1 : 0;
+}
+
+constexpr int SERVER_REPORT_SECONDS = 10;
+
+// Runs a multiplayer server on a UDP port of all interfaces, ticking in real time until the process is
+// stopped, and prints the load every few seconds.
+int runServer(uint16_t port, int maxPlayers, int boardSize) {
+  const auto transport = UdpTransport::open(port, true);
+  if (!transport) {
+    return 2;
+  }
+
+  MultiplayerConfig config;
+  config.seed = static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+  config.maxPlayers = maxPlayers;
+  config.cols = boardSize;
+  config.rows = boardSize;
+  GameServer server(config, *transport);
+  std::printf("serving a %dx%d board to %d players on UDP port %u\n", server.getSimulation().getConfig().cols,
+              server.getSimulation().getConfig().rows, server.getSimulation().getConfig().maxPlayers,
+              transport->getPort());
+
+  const auto tickDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double>(MultiplayerSimulation::TICK_SECONDS));
+  auto nextTick = std::chrono::steady_clock::now();
+  ServerStats reported;
+  while (true) {
+    server.tick();
+    nextTick += tickDuration;
+    std::this_thread::sleep_until(nextTick);
+
+    const ServerStats& stats = server.getStats();
+    const uint64_t reportTicks = SERVER_REPORT_SECONDS * MultiplayerSimulation::TICKS_PER_SECOND;
+    if (stats.ticks % reportTicks == 0) {
+      std::printf("%d clients, tick %.3f ms mean, %.3f ms max, %.1f KB/s out, %.1f KB/s in\n", server.getClientCount(),
+                  (stats.totalTickMs - reported.totalTickMs) / static_cast<double>(reportTicks), stats.maxTickMs,
+                  static_cast<double>(stats.bytesSent - reported.bytesSent) / SERVER_REPORT_SECONDS / 1024.0,
+                  static_cast<double>(stats.bytesReceived - reported.bytesReceived) / SERVER_REPORT_SECONDS / 1024.0);
+      reported = stats;
+    }
+  }
+}
+
+// stops a running trace capture early rather than dropping it, then flushes the log
+int finish(int status) {
+  TraceRecorder::getInstance().shutdown();
+  Logger::getInstance().shutdown();
+  return status;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  TraceRecorder::nameThread("main");
+  // --trace <seconds> may precede any of the other modes
+  if (argc >= 3 && std::string(argv[1]) == "--trace") {
+    TraceRecorder::getInstance().startCapture(std::chrono::milliseconds(std::stoi(argv[2]) * 1000));
+    argc -= 2;
+    argv += 2;
+  }
+
+  if (argc == 3 && std::string(argv[1]) == "--replay") {
+    return finish(runReplay(argv[2]));
+  }
+  if (argc == 5 && std::string(argv[1]) == "--replay" && std::string(argv[3]) == "--seek") {
+    return finish(runSeek(argv[2], static_cast<uint32_t>(std::stoul(argv[4]))));
+  }
+
+  if ((argc == 3 || argc == 4) && std::string(argv[1]) == "--autopilot") {
+    return finish(runBot(std::stoull(argv[2]), argc == 4 ? std::stoi(argv[3]) : 2, std::nullopt));
+  }
+  if (argc >= 3 && argc <= 5 && std::string(argv[1]) == "--mcts") {
+    const unsigned threads = argc == 5 ? static_cast<unsigned>(std::stoul(argv[4])) : 0;
+    return finish(runBot(std::stoull(argv[2]), argc >= 4 ? std::stoi(argv[3]) : 2, threads));
+  }
+
+  if ((argc == 3 || argc == 4) && std::string(argv[1]) == "--alloc-check") {
+    return finish(runAllocationCheck(argv[2], argc == 4 ? std::stoi(argv[3]) : 120));
+  }
+
+  if (argc >= 3 && argc <= 5 && std::string(argv[1]) == "--server") {
+    return finish(runServer(static_cast<uint16_t>(std::stoul(argv[2])), argc >= 4 ? std::stoi(argv[3]) : 16,
+                            argc == 5 ? std::stoi(argv[4]) : 64));
+  }
+
+  std::optional<Replay> watchedReplay;
+  if (argc == 3 && std::string(argv[1]) == "--watch") {
+    watchedReplay = ReplayFile::load(argv[2]);
+    if (!watchedReplay) {
+      return finish(2);
+    }
+  }
 
-int main() {
   sf::RenderWindow window(sf::VideoMode(sf::Vector2u(800, 600)), "Snake Game");
 
   ResourceLoader::initializeAllResources();
@@ -12,9 +255,15 @@ int main() {
 
   window.setIcon(icon.getSize(), icon.getPixelsPtr());
 
-  const Game game(window);
+  Game game(window);
+  if (watchedReplay) {
+    game.setCurrentScreen(new ReplayScreen(window, game, std::move(*watchedReplay)));
+  }
 
   game.start();
 
-  return 0;
+  AudioService::getInstance().logStats();
+  AudioService::getInstance().shutdown();
+
+  return finish(0);
 }
\ No newline at end of file
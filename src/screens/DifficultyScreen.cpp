@@ -1,6 +1,7 @@
 #include "DifficultyScreen.hpp"
 
 #include "../utils/FontInitializer.hpp"
+#include "../utils/FrameProfiler.hpp"
 #include "../utils/ScalingUtils.hpp"
 #include "../utils/SettingStorage.hpp"
 #include "../utils/difficulty/DifficultyManager.hpp"
@@ -8,8 +9,14 @@
 
 using namespace shape;
 
+const ResourceSet& DifficultyScreen::getResourceSet() {
+  static const ResourceSet resourceSet{
+      {}, {FontType::DebugFont}, {SoundType::SetActiveMenuItem, SoundType::SelectMenuItem}, {}};
+  return resourceSet;
+}
+
 DifficultyScreen::DifficultyScreen(sf::RenderWindow& win, Game& gameRef)
-    : Screen(win, gameRef), titleText(font), backText(font) {
+    : Screen(win, gameRef, getResourceSet()), titleText(font), backText(font) {
 
   screenRect.setSize(originSize);
   screenRect.setFillColor(menuBackgroundColor);
@@ -22,7 +29,7 @@ DifficultyScreen::DifficultyScreen(sf::RenderWindow& win, Game& gameRef)
 
   initializeDifficultyItems();
 
-  game.loadSettings();
+  game.refreshSettings();
   soundManager.setSoundEnabled(game.getSettingsReader().getGameSound());
 }
 
@@ -81,7 +88,7 @@ void DifficultyScreen::renderScreenRect() {
 
   screenRect.setPosition(position);
 
-  window.draw(screenRect);
+  FrameProfiler::draw(window, screenRect);
 }
 
 void DifficultyScreen::renderTitle() {
@@ -91,7 +98,7 @@ void DifficultyScreen::renderTitle() {
 
   titleText.setScale(screenRect.getScale());
 
-  window.draw(titleText);
+  FrameProfiler::draw(window, titleText);
 }
 
 void DifficultyScreen::renderScreenItems() {
@@ -106,7 +113,7 @@ void DifficultyScreen::renderScreenItems() {
         screenRect.getPosition().y + 100.0f * screenRect.getScale().y + i * 50.0f * screenRect.getScale().y));
 
     difficultyItems[i].setScale(screenRect.getScale());
-    window.draw(difficultyItems[i]);
+    FrameProfiler::draw(window, difficultyItems[i]);
 
     if (i == selectedDifficultyIndex) {
       difficultyItems[i].setFillColor(textColor);
@@ -126,7 +133,7 @@ void DifficultyScreen::renderBackButton() {
   backText.setPosition(sf::Vector2f(
       position.x,
       screenRect.getPosition().y + screenRect.getSize().y * screenRect.getScale().y - 40.0f * screenRect.getScale().y));
-  window.draw(backText);
+  FrameProfiler::draw(window, backText);
 }
 
 void DifficultyScreen::initializeDifficultyItems() {
@@ -137,17 +144,12 @@ void DifficultyScreen::initializeDifficultyItems() {
   difficultyItems.clear();
   difficultyItems.reserve(difficultyLevels.size());
 
-  SettingStorage settingStorage;
-  bool settingsLoaded = settingStorage.loadSettings();
-
-  if (settingsLoaded) {
-    GameDifficultyLevel currentDifficultyLevel = settingStorage.getGameDifficultyLevel();
+  const GameDifficultyLevel currentDifficultyLevel = game.getSettingsReader().getGameDifficultyLevel();
 
-    for (size_t i = 0; i < difficultyLevels.size(); ++i) {
-      if (difficultyLevels[i] == currentDifficultyLevel) {
-        selectedDifficultyIndex = static_cast<int>(i);
-        break;
-      }
+  for (size_t i = 0; i < difficultyLevels.size(); ++i) {
+    if (difficultyLevels[i] == currentDifficultyLevel) {
+      selectedDifficultyIndex = static_cast<int>(i);
+      break;
     }
   }
 
@@ -174,7 +176,7 @@ void DifficultyScreen::confirmSelection() {
       GameDifficultyLevel::HarderThanMiddle, GameDifficultyLevel::Hard};
 
   if (selectedDifficultyIndex < difficultyLevels.size()) {
-    SettingStorage& settingStorage = const_cast<SettingStorage&>(game.getSettingsReader());
+    SettingStorage& settingStorage = game.getSettingStorage();
     settingStorage.setGameDifficultyLevel(difficultyLevels[selectedDifficultyIndex]);
     settingStorage.saveSettings();
   }
@@ -11,6 +11,8 @@ class DifficultyScreen : public Screen {
 public:
   explicit DifficultyScreen(sf::RenderWindow& win, Game& gameRef);
 
+  static const ResourceSet& getResourceSet();
+
   void processEvents(const sf::Event& event) override;
   void update() override;
   void render() override;
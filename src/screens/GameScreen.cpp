@@ -1,81 +1,76 @@
 #include "GameScreen.hpp"
+#include <algorithm>
 #include "../config/AudioConstants.hpp"
-#include "../utils/GameItem.hpp"
-#include "../utils/GameItemManager.hpp"
+#include "../utils/AudioService.hpp"
+#include "../utils/FrameProfiler.hpp"
 #include "../utils/GameUI.hpp"
+#include "../utils/Logger.hpp"
 #include "../utils/ResourceLoader.hpp"
 #include "../utils/ScalingUtils.hpp"
 #include "../utils/SettingStorage.hpp"
-#include "../utils/WallManager.hpp"
-#include "../utils/difficulty/DifficultyManager.hpp"
+#include "../utils/TimerManager.hpp"
+#include "../utils/TraceRecorder.hpp"
+#include "../utils/replay/ReplayPlayer.hpp"
 #include "HighScores.hpp"
 #include "PauseScreen.hpp"
 
 using namespace shape;
 
+const ResourceSet& GameScreen::getResourceSet() {
+  static const ResourceSet resourceSet{
+      {TextureType::Snake, TextureType::GreenApple, TextureType::RedApple, TextureType::FantomApple,
+       TextureType::WaterBubble, TextureType::BoardBorder, TextureType::BoardGrid, TextureType::Wall_1,
+       TextureType::Wall_2, TextureType::Wall_3, TextureType::Wall_4, TextureType::GameUI, TextureType::Digits},
+      {FontType::DebugFont},
+      {SoundType::EatApple, SoundType::GameOver, SoundType::Countdown, SoundType::StartGame},
+      {MusicType::BackgroundMusic}};
+  return resourceSet;
+}
+
 GameScreen::GameScreen(sf::RenderWindow& win, Game& gameRef)
-    : Screen(win, gameRef),
-      gameGrid(32, 32, 824.0f, sf::Vector2f(0, 0), 1.0f, 912.0f),
-      snake(sf::Vector2i(16, 16), 5),
-      countdownTimer(1, false),
-      gameOverSound(ResourceLoader::getSound(SoundType::GameOver)),
-      eatAppleSound(ResourceLoader::getSound(SoundType::EatApple)),
-      startGameSound(ResourceLoader::getSound(SoundType::StartGame)) {
+    : Screen(win, gameRef, getResourceSet()),
+      gameGrid(GameSimulation::GRID_ROWS, GameSimulation::GRID_COLS, 824.0f, sf::Vector2f(0, 0), 1.0f, 912.0f),
+      countdownTimer(1, false) {
+  TRACE_SCOPE("GameScreen construction");
   initializeGrid();
 
   backgroundMusic = &ResourceLoader::getMusic(MusicType::BackgroundMusic);
   backgroundMusic->setLooping(true);
   backgroundMusic->setVolume(AudioConstants::Music::BACKGROUND_MUSIC_VOLUME);
 
-  gameOverSound.setVolume(AudioConstants::SoundEffects::GAME_OVER_VOLUME);
+  AudioService::getInstance().preload(getResourceSet().sounds);
   gameOverSoundPlayed = false;
 
-  eatAppleSound.setVolume(AudioConstants::SoundEffects::EAT_APPLE_VOLUME);
-  startGameSound.setVolume(AudioConstants::SoundEffects::START_GAME_VOLUME);
-
-  game.loadSettings();
+  game.refreshSettings();
 
   soundEnabled = game.getSettingsReader().getGameSound();
   musicEnabled = game.getSettingsReader().getGameMusic();
 
-  snake.setSnakeType(game.getSettingsReader().getSnakeType());
-
-  this->difficultySettings =
-      &DifficultyManager::getDifficultySettings(game.getSettingsReader().getGameDifficultyLevel());
+  replay.config.seed = GameRandom::generateSeed();
+  replay.config.difficulty = game.getSettingsReader().getGameDifficultyLevel();
+  replay.config.snakeType = game.getSettingsReader().getSnakeType();
+  replay.config.countdownSeconds = game.getSettingsReader().getGameCountdownInSeconds();
 
-  snake.setSpeed(this->difficultySettings->getBaseSnakeSpeed());
+  simulation = std::make_unique<GameSimulation>(replay.config, arena.getResource());
 
   countdownTimer.setSoundEnabled(soundEnabled);
 
-  countdownTimer.setDuration(game.getSettingsReader().getGameCountdownInSeconds());
+  countdownTimer.setDuration(replay.config.countdownSeconds);
   countdownTimer.start();
 
   snakeTypeTimer.restart();
+  frameClock.restart();
 
   gameUI = GameUI();
 
   game.resetScore();
   gameUI.setScore(0);
   gameUI.setApples(0);
-
-  wallManager = std::make_unique<WallManager>(gameGrid, *difficultySettings);
-
-  gameItemManager = std::make_unique<GameItemManager>(gameGrid, *this->difficultySettings);
-
-  int wallsGenerated = 0;
-  int maxAttempts = difficultySettings->getWallCount() * 3;
-  int attempts = 0;
-
-  while (wallsGenerated < difficultySettings->getWallCount() && attempts < maxAttempts) {
-    if (wallManager->tryGenerateWall(snake)) {
-      wallsGenerated++;
-    }
-    attempts++;
-  }
 }
 
 GameScreen::~GameScreen() {
-  pauseMusic();
+  stopMusic();
+  saveReplay();
 }
 
 void GameScreen::processEvents(const sf::Event& event) {
@@ -94,28 +89,35 @@ void GameScreen::processEvents(const sf::Event& event) {
           game.setCurrentScreenWithPrevious(new PauseScreen(window, game), this);
         }
         break;
+      case sf::Keyboard::Key::F2:
+        if (autopilot) {
+          autopilot.reset();
+        } else if (!gameOver) {
+          autopilot = std::make_unique<Autopilot>(GameSimulation::GRID_COLS, GameSimulation::GRID_ROWS);
+        }
+        break;
       case sf::Keyboard::Key::Up:
       case sf::Keyboard::Key::W:
         if (!gameOver) {
-          snake.setDirection(Snake::Direction::Up);
+          applyInput(ReplayInput::Up);
         }
         break;
       case sf::Keyboard::Key::Down:
       case sf::Keyboard::Key::S:
         if (!gameOver) {
-          snake.setDirection(Snake::Direction::Down);
+          applyInput(ReplayInput::Down);
         }
         break;
       case sf::Keyboard::Key::Left:
       case sf::Keyboard::Key::A:
         if (!gameOver) {
-          snake.setDirection(Snake::Direction::Left);
+          applyInput(ReplayInput::Left);
         }
         break;
       case sf::Keyboard::Key::Right:
       case sf::Keyboard::Key::D:
         if (!gameOver) {
-          snake.setDirection(Snake::Direction::Right);
+          applyInput(ReplayInput::Right);
         }
         break;
       default:
@@ -133,12 +135,22 @@ void GameScreen::update() {
     return;
   }
 
-  if (wallManager) {
-    wallManager->update(1.0f / 60.0f, snake);
-  }
+  const float frameSeconds = frameClock.restart().asSeconds();
+  tickAccumulator = std::min(tickAccumulator + frameSeconds, MAX_TICKS_PER_FRAME * GameSimulation::TICK_SECONDS);
 
-  if (gameItemManager && countdownTimer.getIsFinished()) {
-    gameItemManager->update(1.0f / 60.0f, snake);
+  {
+    PROFILE_ZONE(Simulation);
+    while (tickAccumulator >= GameSimulation::TICK_SECONDS && !simulation->isGameOver()) {
+      TRACE_SCOPE("tick");
+      if (autopilot) {
+        if (const auto input = autopilot->update(*simulation)) {
+          applyInput(*input);
+        }
+      }
+      handleTickResult(simulation->tick());
+      ReplayFile::captureKeyframe(replay, *simulation);
+      tickAccumulator -= GameSimulation::TICK_SECONDS;
+    }
   }
 
   if (isBlinking) {
@@ -154,75 +166,64 @@ void GameScreen::update() {
     }
   }
 
-  if (countdownTimer.getIsFinished() && !musicStarted && !isBlinking) {
+  if (!simulation->isCountdownActive() && !musicStarted && !isBlinking && !simulation->isGameOver()) {
     if (musicEnabled) {
       backgroundMusic->play();
     }
     musicStarted = true;
     if (soundEnabled) {
-      startGameSound.play();
+      AudioService::getInstance().play(SoundType::StartGame);
     }
   }
 
-  if (countdownTimer.getIsFinished() && !isBlinking) {
-    if (speedIncreaseTimer.getElapsedTime().asSeconds() >= difficultySettings->getSpeedIncreaseInterval()) {
-      float currentSpeed = snake.getSpeed();
-      snake.setSpeed(currentSpeed + difficultySettings->getSpeedIncreaseRate());
-      speedIncreaseTimer.restart();
-    }
-
-    if (moveTimer.getElapsedTime().asSeconds() >= 1 / snake.getSpeed()) {
-      snake.move();
-
-      if (gameItemManager) {
-        auto* collidedItem = gameItemManager->checkCollision(snake.getHead());
-        if (collidedItem) {
-          if (soundEnabled) {
-            eatAppleSound.play();
-          }
+  countdownTimer.update();
+}
 
-          collidedItem->applySpecialEffects(snake);
+void GameScreen::handleTickResult(const TickResult& result) {
+  if (result.ateItem) {
+    if (soundEnabled) {
+      AudioService::getInstance().play(SoundType::EatApple);
+    }
 
-          snake.grow();
+    game.addScore(result.points);
+    gameUI.setScore(game.getScore());
+    gameUI.setApples(simulation->getApplesEaten());
+  }
 
-          int points = static_cast<int>(collidedItem->getPoints() * difficultySettings->getScoreMultiplier());
-          game.addScore(points);
-          gameUI.setScore(game.getScore());
-          gameUI.setApples(gameUI.getApples() + 1);
+  if (result.died) {
+    pauseMusic();
 
-          gameItemManager->removeItem(collidedItem);
-        }
+    if (!gameOverSoundPlayed) {
+      if (soundEnabled) {
+        AudioService::getInstance().play(SoundType::GameOver);
       }
+      gameOverSoundPlayed = true;
+    }
 
-      bool wallCollision = false;
-      if (wallManager && !snake.isInvincible()) {
-        wallCollision = wallManager->checkWallCollision(snake.getHead());
-      }
-
-      if (wallCollision || snake.checkWallCollision(gameGrid.getCols(), gameGrid.getRows()) ||
-          snake.checkSelfCollision()) {
-        pauseMusic();
-
-        if (!gameOverSoundPlayed) {
-          if (soundEnabled) {
-            gameOverSound.play();
-          }
-          gameOverSoundPlayed = true;
-        }
+    startBlinking();
+  }
+}
 
-        snake.kill();
-        startBlinking();
-      }
+void GameScreen::applyInput(ReplayInput input) {
+  replay.events.push_back(ReplayEvent{simulation->getTick(), input});
+  ReplayPlayer::applyInput(*simulation, input);
+}
 
-      moveTimer.restart();
-    }
+void GameScreen::saveReplay() {
+  if (replaySaved) {
+    return;
   }
+  replaySaved = true;
 
-  countdownTimer.update();
+  replay.finalTick = simulation->getTick();
+  replay.finalStateHash = simulation->computeStateHash();
+  if (const auto path = ReplayFile::saveSession(replay)) {
+    LOG_INFO("Replay saved to {} ({} inputs, {} ticks)", *path, replay.events.size(), replay.finalTick);
+  }
 }
 
 sf::Sprite GameScreen::renderBoardBorder() const {
-  const auto texture = ResourceLoader::getTexture(TextureType::BoardBorder);
+  const auto& texture = ResourceLoader::getTexture(TextureType::BoardBorder);
   sf::Sprite sprite(texture);
 
   const float scale = getScale(sf::Vector2f(sprite.getTexture().getSize()), window.getSize());
@@ -233,13 +234,13 @@ sf::Sprite GameScreen::renderBoardBorder() const {
 
   sprite.setPosition(position);
 
-  window.draw(sprite);
+  FrameProfiler::draw(window, sprite);
 
   return sprite;
 }
 
 void GameScreen::renderBoardGrid() const {
-  const auto texture = ResourceLoader::getTexture(TextureType::BoardGrid);
+  const auto& texture = ResourceLoader::getTexture(TextureType::BoardGrid);
   sf::Sprite sprite(texture);
 
   const float scaleRelativeFactor = 912.0f / 992.0f;
@@ -250,7 +251,7 @@ void GameScreen::renderBoardGrid() const {
 
   sprite.setPosition(position);
 
-  window.draw(sprite);
+  FrameProfiler::draw(window, sprite);
 }
 
 void GameScreen::renderDebugGrid() const {
@@ -261,7 +262,7 @@ void GameScreen::renderDebugGrid() const {
 
   border.setPosition(gameGrid.getTopLeft());
 
-  window.draw(border);
+  FrameProfiler::draw(window, border);
 
   sf::RectangleShape cell(sf::Vector2f(gameGrid.getCellSize(), gameGrid.getCellSize()));
   cell.setScale(sf::Vector2f(gameGrid.getScale(), gameGrid.getScale()));
@@ -272,7 +273,7 @@ void GameScreen::renderDebugGrid() const {
   for (int row = 0; row < gameGrid.getRows(); ++row) {
     for (int col = 0; col < gameGrid.getCols(); ++col) {
       cell.setPosition(gameGrid.getCellPosition(row, col));
-      window.draw(cell);
+      FrameProfiler::draw(window, cell);
     }
   }
 }
@@ -283,17 +284,20 @@ void GameScreen::render() {
 
   renderGameUI(boardBorder);
 
-  if (wallManager) {
-    wallManager->render(window, gameGrid);
+  {
+    PROFILE_ZONE(Walls);
+    simulation->getWallManager().render(window, gameGrid);
   }
-
-  if (gameItemManager) {
-    gameItemManager->render(window, gameGrid);
+  {
+    PROFILE_ZONE(Items);
+    simulation->getGameItemManager().render(window, gameGrid);
+  }
+  {
+    PROFILE_ZONE(Snake);
+    Snake& snake = simulation->getSnake();
+    snake.setBlinking(isBlinking);
+    snake.render(window, gameGrid);
   }
-
-  snake.setBlinking(isBlinking);
-
-  snake.render(window, gameGrid);
 
   if (countdownTimer.getIsActive()) {
     sf::Vector2u windowSize = window.getSize();
@@ -308,7 +312,7 @@ void GameScreen::renderGameUI(const sf::Sprite& boardBorder) const {
       getPosition(sf::Vector2f(boardBorder.getTexture().getSize()), window.getSize(), boardBorder.getScale().x);
 
   gameUI.setScale(boardBorder.getScale().x);
-  gameUI.setSpeed(static_cast<int>(snake.getSpeed()));
+  gameUI.setSpeed(static_cast<int>(simulation->getSnake().getSpeed()));
   gameUI.render(window, sf::Vector2f(boardBorder.getGlobalBounds().position.x +
                                          (boardBorderSize.x + 16) * boardBorder.getScale().x,
                                      boardBorder.getGlobalBounds().position.y));
@@ -316,6 +320,7 @@ void GameScreen::renderGameUI(const sf::Sprite& boardBorder) const {
 
 void GameScreen::restartCountdown() {
   countdownTimer.start();
+  applyInput(ReplayInput::Countdown);
 }
 
 void GameScreen::handleGameOver() {
@@ -324,9 +329,8 @@ void GameScreen::handleGameOver() {
 
   gameOver = true;
 
-  if (game.isNewHighScore()) {
-    game.saveScoreToRecordTable();
-  }
+  game.recordGameResult(simulation->getSnake().getLength(), simulation->getGameplaySeconds());
+  saveReplay();
 
   game.setCurrentScreen(new HighScores(window, game));
 }
@@ -351,7 +355,7 @@ void GameScreen::updateGrid() {
 void GameScreen::resume() {
   updateGrid();
 
-  countdownTimer.start();
+  restartCountdown();
 
   resumeMusic();
 
@@ -360,6 +364,13 @@ void GameScreen::resume() {
 
 void GameScreen::pauseMusic() {
   if (backgroundMusic && musicStarted) {
+    backgroundMusic->pause();
+    musicStarted = false;
+  }
+}
+
+void GameScreen::stopMusic() {
+  if (backgroundMusic) {
     backgroundMusic->stop();
     musicStarted = false;
   }
@@ -380,6 +391,7 @@ void GameScreen::pause() {
 
 void GameScreen::unpause() {
   isPaused = false;
+  frameClock.restart();
 
   TimerManager::getInstance().unpauseAll();
 }
@@ -1,18 +1,21 @@
 #pragma once
-#include <SFML/Audio.hpp>
 #include <SFML/System/Clock.hpp>
 #include <memory>
+#include "../GameSimulation.hpp"
 #include "../Screen.hpp"
-#include "../Snake.hpp"
 #include "../utils/CountdownTimer.hpp"
 #include "../utils/GameGrid.hpp"
-#include "../utils/GameItemManager.hpp"
 #include "../utils/GameUI.hpp"
-#include "../utils/WallManager.hpp"
+#include "../utils/MusicStream.hpp"
+#include "../utils/SessionArena.hpp"
+#include "../utils/autopilot/Autopilot.hpp"
+#include "../utils/replay/ReplayFile.hpp"
 
 class GameScreen final : public Screen {
 public:
   explicit GameScreen(sf::RenderWindow& win, Game& gameRef);
+
+  static const ResourceSet& getResourceSet();
   ~GameScreen();
 
   void processEvents(const sf::Event& event) override;
@@ -26,6 +29,7 @@ public:
   void resume();
 
   void pauseMusic();
+  void stopMusic();
   void resumeMusic();
 
   void pause();
@@ -37,33 +41,29 @@ private:
   float scaleRelativeFactor = 912.0f / 992.0f;
   GameGrid gameGrid;
 
-  Snake snake;
-  mutable GameUI gameUI;
-
-  std::unique_ptr<WallManager> wallManager;
-
-  std::unique_ptr<GameItemManager> gameItemManager;
+  // declared before the simulation, so the walls and items it holds are gone when the arena is released
+  SessionArena arena;
+  std::unique_ptr<GameSimulation> simulation;
+  Replay replay;
+  bool replaySaved = false;
+  std::unique_ptr<Autopilot> autopilot;
 
-  const DifficultySettings* difficultySettings;
+  mutable GameUI gameUI;
 
   CountdownTimer countdownTimer;
 
-  sf::Music* backgroundMusic;
+  MusicStream* backgroundMusic;
   bool musicStarted = false;
 
-  sf::Sound gameOverSound;
   bool gameOverSoundPlayed = false;
 
-  sf::Sound eatAppleSound;
-
-  sf::Sound startGameSound;
-
   bool soundEnabled = true;
   bool musicEnabled = true;
 
-  sf::Clock moveTimer;
   sf::Clock snakeTypeTimer;
-  sf::Clock speedIncreaseTimer;
+  sf::Clock frameClock;
+  float tickAccumulator = 0.0f;
+  static constexpr int MAX_TICKS_PER_FRAME = 5;
 
   bool gameOver = false;
   bool scoreSaved = false;
@@ -81,6 +81,10 @@ private:
 
   void renderDebugGrid() const;
   void handleGameOver();
+  void handleTickResult(const TickResult& result);
+
+  void applyInput(ReplayInput input);
+  void saveReplay();
 
   void initializeGrid();
   void updateGrid();
@@ -1,11 +1,23 @@
 #include "HighScores.hpp"
 #include "../utils/FontInitializer.hpp"
+#include "../utils/FrameProfiler.hpp"
 #include "../utils/ScalingUtils.hpp"
+#include "../utils/difficulty/DifficultyManager.hpp"
 #include "MainMenu.hpp"
 
 using namespace shape;
 
-HighScores::HighScores(sf::RenderWindow& win, Game& gameRef) : Screen(win, gameRef), titleText(font), backText(font) {
+const ResourceSet& HighScores::getResourceSet() {
+  static const ResourceSet resourceSet{{}, {FontType::DebugFont}, {}, {}};
+  return resourceSet;
+}
+
+HighScores::HighScores(sf::RenderWindow& win, Game& gameRef)
+    : Screen(win, gameRef, getResourceSet()),
+      titleText(font),
+      difficultyText(font),
+      noScoresText(font),
+      backText(font) {
   font = FontInitializer::getDebugFont();
 
   screenRect.setSize(originSize);
@@ -17,7 +29,46 @@ HighScores::HighScores(sf::RenderWindow& win, Game& gameRef) : Screen(win, gameR
   titleText.setLineSpacing(0.0f);
   FontInitializer::initializeBackText(backText, font, 24);
 
-  game.loadSettings();
+  difficultyText.setString(
+      DifficultyManager::getDifficultyDisplayName(game.getSettingsReader().getGameDifficultyLevel()));
+  difficultyText.setCharacterSize(20);
+  difficultyText.setFillColor(textColor);
+
+  game.refreshSettings();
+  buildScoreTexts();
+}
+
+void HighScores::buildScoreTexts() {
+  const auto recordTable = game.getScoreLog().getTopScores(game.getSettingsReader().getGameDifficultyLevel(),
+                                                           static_cast<size_t>(SCORES_COUNT));
+
+  const auto lastRecordSequence = game.getLastRecordSequence();
+
+  scoreTexts.clear();
+  scoreTexts.reserve(recordTable.size());
+  for (size_t i = 0; i < recordTable.size(); ++i) {
+    sf::Text& item = scoreTexts.emplace_back(font);
+
+    item.setString(std::to_string(i + 1) + std::string(2, ' ') + std::string(14, '.') + std::string(2, ' ') +
+                   std::to_string(recordTable[i].record.score));
+
+    if (lastRecordSequence && *lastRecordSequence == recordTable[i].sequence) {
+      item.setFillColor(sf::Color::Green);
+    } else {
+      item.setFillColor(sf::Color::White);
+    }
+
+    item.setStyle(sf::Text::Regular);
+  }
+
+  noScoresText.setString(L"Пока нет рекордов!");
+  noScoresText.setCharacterSize(24);
+  noScoresText.setFillColor(sf::Color::White);
+  noScoresText.setStyle(sf::Text::Bold);
+}
+
+const ResourceSet* HighScores::getPrefetchSet() const {
+  return &MainMenu::getResourceSet();
 }
 
 void HighScores::processEvents(const sf::Event& event) {
@@ -55,7 +106,7 @@ void HighScores::renderScreenRect() {
   const auto position = getPosition(sf::Vector2f(screenRect.getSize()), window.getSize(), scale);
   screenRect.setPosition(position);
 
-  window.draw(screenRect);
+  FrameProfiler::draw(window, screenRect);
 }
 
 void HighScores::renderTitle() {
@@ -65,22 +116,20 @@ void HighScores::renderTitle() {
 
   titleText.setScale(screenRect.getScale());
 
-  window.draw(titleText);
-}
-
-void HighScores::renderScores() {
-  const auto& recordTable = game.getSettingsReader().getGameRecordTable();
-
-  const auto currentScore = game.getScore();
+  FrameProfiler::draw(window, titleText);
 
-  for (size_t i = 0; i < recordTable.size(); ++i) {
-    sf::Text item(font);
+  const auto difficultyPosition =
+      getPosition(sf::Vector2f(difficultyText.getLocalBounds().size), window.getSize(), screenRect.getScale().x);
+  difficultyText.setPosition(
+      sf::Vector2f(difficultyPosition.x, screenRect.getPosition().y + 60 * screenRect.getScale().y));
+  difficultyText.setScale(screenRect.getScale());
 
-    item.setString(std::to_string(i + 1) + std::string(2, ' ') + std::string(14, '.') + std::string(2, ' ') +
-                   std::to_string(recordTable[i]));
+  FrameProfiler::draw(window, difficultyText);
+}
 
-    const auto position =
-        getPosition(sf::Vector2f(item.getLocalBounds().size), window.getSize(), screenRect.getScale().x);
+void HighScores::renderScores() {
+  for (size_t i = 0; i < scoreTexts.size(); ++i) {
+    sf::Text& item = scoreTexts[i];
 
     item.setPosition(sf::Vector2f(
         screenRect.getPosition().x + 120.0f * screenRect.getScale().x,
@@ -88,40 +137,15 @@ void HighScores::renderScores() {
 
     item.setScale(screenRect.getScale());
 
-    bool isLastOccurrence = false;
-    if (currentScore == recordTable[i]) {
-      isLastOccurrence = true;
-      for (size_t j = i + 1; j < recordTable.size(); ++j) {
-        if (currentScore == recordTable[j]) {
-          isLastOccurrence = false;
-          break;
-        }
-      }
-    }
-
-    if (isLastOccurrence) {
-      item.setFillColor(sf::Color::Green);
-    } else {
-      item.setFillColor(sf::Color::White);
-    }
-
-    item.setStyle(sf::Text::Regular);
-
-    window.draw(item);
+    FrameProfiler::draw(window, item);
   }
 
-  if (recordTable.empty()) {
-    sf::Text noScoresText(font);
-    noScoresText.setString(L"Пока нет рекордов!");
-    noScoresText.setCharacterSize(24);
-    noScoresText.setFillColor(sf::Color::White);
-    noScoresText.setStyle(sf::Text::Bold);
-
+  if (scoreTexts.empty()) {
     sf::FloatRect textBounds = noScoresText.getLocalBounds();
     const auto position = getPosition(sf::Vector2f(textBounds.size), window.getSize(), screenRect.getScale().x);
 
     noScoresText.setPosition(position);
-    window.draw(noScoresText);
+    FrameProfiler::draw(window, noScoresText);
   }
 }
 
@@ -133,5 +157,5 @@ void HighScores::renderBackButton() {
   backText.setPosition(sf::Vector2f(
       position.x,
       screenRect.getPosition().y + screenRect.getSize().y * screenRect.getScale().y - 40.0f * screenRect.getScale().y));
-  window.draw(backText);
+  FrameProfiler::draw(window, backText);
 }
@@ -10,7 +10,10 @@ private:
   sf::RectangleShape screenRect;
   sf::Font font;
   sf::Text titleText;
+  sf::Text difficultyText;
+  // built once, the score log does not change while the table is shown
   std::vector<sf::Text> scoreTexts;
+  sf::Text noScoresText;
   sf::Text backText;
   sf::Vector2f originSize = sf::Vector2f(600.0f, 500.0f);
 
@@ -23,6 +26,7 @@ private:
   sf::Color borderColor = MenuColors::BORDER_COLOR;
 
   void initializeScreenRect();
+  void buildScoreTexts();
 
   void renderScreenRect();
   void renderTitle();
@@ -32,6 +36,10 @@ private:
 public:
   explicit HighScores(sf::RenderWindow& win, Game& gameRef);
 
+  static const ResourceSet& getResourceSet();
+
+  const ResourceSet* getPrefetchSet() const override;
+
   void processEvents(const sf::Event& event) override;
   void update() override;
   void render() override;
@@ -1,6 +1,7 @@
 #include "MainMenu.hpp"
-#include <iostream>
 #include "../utils/FontInitializer.hpp"
+#include "../utils/FrameProfiler.hpp"
+#include "../utils/Logger.hpp"
 #include "../utils/ScalingUtils.hpp"
 #include "../utils/SettingStorage.hpp"
 #include "DifficultyScreen.hpp"
@@ -10,7 +11,14 @@
 
 using namespace shape;
 
-MainMenu::MainMenu(sf::RenderWindow& win, Game& gameRef) : Screen(win, gameRef), titleText(font) {
+const ResourceSet& MainMenu::getResourceSet() {
+  static const ResourceSet resourceSet{
+      {}, {FontType::DebugFont}, {SoundType::SetActiveMenuItem, SoundType::SelectMenuItem}, {}};
+  return resourceSet;
+}
+
+MainMenu::MainMenu(sf::RenderWindow& win, Game& gameRef)
+    : Screen(win, gameRef, getResourceSet()), titleText(font) {
   font = FontInitializer::getDebugFont();
   FontInitializer::initializeTitleText(titleText, font, L"Главное меню");
 
@@ -24,18 +32,22 @@ MainMenu::MainMenu(sf::RenderWindow& win, Game& gameRef) : Screen(win, gameRef),
   screenRect.setOutlineColor(borderColor);
   screenRect.setOutlineThickness(10.0f);
 
-  game.loadSettings();
+  game.refreshSettings();
   soundManager.setSoundEnabled(game.getSettingsReader().getGameSound());
 
   initializeMenuItems();
 }
 
+const ResourceSet* MainMenu::getPrefetchSet() const {
+  return &GameScreen::getResourceSet();
+}
+
 void MainMenu::drawMenuBackground(sf::RenderWindow& window, const sf::Text& text) const {
   sf::RectangleShape background;
   background.setSize(sf::Vector2f(text.getLocalBounds().size.x + 20, text.getLocalBounds().size.y + 10));
   background.setPosition(sf::Vector2f(text.getPosition().x - 10, text.getPosition().y - 5));
   background.setFillColor(sf::Color(MenuColors::BORDER_R, MenuColors::BORDER_G, MenuColors::BORDER_B));
-  window.draw(background);
+  FrameProfiler::draw(window, background);
 }
 
 void MainMenu::processEvents(const sf::Event& event) {
@@ -43,13 +55,13 @@ void MainMenu::processEvents(const sf::Event& event) {
     switch (event.getIf<sf::Event::KeyPressed>()->code) {
       case sf::Keyboard::Key::W:
       case sf::Keyboard::Key::Up:
-        std::cout << "Keypressed up(w)" << std::endl;
+        LOG_DEBUG("Keypressed up(w)");
         selectedIndex = (selectedIndex - 1 + MENU_ITEMS_COUNT) % MENU_ITEMS_COUNT;
         soundManager.playNavigationSound();
         break;
       case sf::Keyboard::Key::S:
       case sf::Keyboard::Key::Down:
-        std::cout << "Keypressed down(s)" << std::endl;
+        LOG_DEBUG("Keypressed down(s)");
         selectedIndex = (selectedIndex + 1) % MENU_ITEMS_COUNT;
         soundManager.playNavigationSound();
         break;
@@ -111,7 +123,7 @@ void MainMenu::renderMenuRect() {
   const auto position = getPosition(sf::Vector2f(screenRect.getSize()), window.getSize(), scale);
   screenRect.setPosition(position);
 
-  window.draw(screenRect);
+  FrameProfiler::draw(window, screenRect);
 }
 
 void MainMenu::renderTitle() {
@@ -121,7 +133,7 @@ void MainMenu::renderTitle() {
 
   titleText.setScale(screenRect.getScale());
 
-  window.draw(titleText);
+  FrameProfiler::draw(window, titleText);
 }
 
 void MainMenu::renderMenuItems() {
@@ -135,7 +147,7 @@ void MainMenu::renderMenuItems() {
                                                   i * 50.0f * screenRect.getScale().y));
 
     item.setScale(screenRect.getScale());
-    window.draw(item);
+    FrameProfiler::draw(window, item);
 
     if (i == selectedIndex) {
       item.setFillColor(textColor);
@@ -145,6 +157,6 @@ void MainMenu::renderMenuItems() {
       item.setStyle(sf::Text::Regular);
     }
 
-    window.draw(item);
+    FrameProfiler::draw(window, item);
   }
 }
@@ -46,6 +46,10 @@ private:
 public:
   explicit MainMenu(sf::RenderWindow& win, Game& gameRef);
 
+  static const ResourceSet& getResourceSet();
+
+  const ResourceSet* getPrefetchSet() const override;
+
   void processEvents(const sf::Event& event) override;
   void update() override;
   void render() override;
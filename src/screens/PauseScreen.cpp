@@ -1,6 +1,7 @@
 #include "PauseScreen.hpp"
 #include <iostream>
 #include "../utils/FontInitializer.hpp"
+#include "../utils/FrameProfiler.hpp"
 #include "../utils/ScalingUtils.hpp"
 #include "../utils/SettingStorage.hpp"
 
@@ -8,7 +9,14 @@
 
 using namespace shape;
 
-PauseScreen::PauseScreen(sf::RenderWindow& win, Game& gameRef) : Screen(win, gameRef), titleText(font), backText(font) {
+const ResourceSet& PauseScreen::getResourceSet() {
+  static const ResourceSet resourceSet{
+      {}, {FontType::DebugFont}, {SoundType::SetActiveMenuItem, SoundType::SelectMenuItem}, {}};
+  return resourceSet;
+}
+
+PauseScreen::PauseScreen(sf::RenderWindow& win, Game& gameRef)
+    : Screen(win, gameRef, getResourceSet()), titleText(font), backText(font) {
   font = FontInitializer::getDebugFont();
   FontInitializer::initializeTitleText(titleText, font, L"Пауза");
   FontInitializer::initializeBackText(backText, font, 14);
@@ -23,7 +31,7 @@ PauseScreen::PauseScreen(sf::RenderWindow& win, Game& gameRef) : Screen(win, gam
   screenRect.setOutlineColor(borderColor);
   screenRect.setOutlineThickness(10.0f);
 
-  game.loadSettings();
+  game.refreshSettings();
   soundManager.setSoundEnabled(game.getSettingsReader().getGameSound());
 
   initializeMenuItems();
@@ -102,7 +110,7 @@ void PauseScreen::renderMenuRect() {
   const auto position = getPosition(sf::Vector2f(screenRect.getSize()), window.getSize(), scale);
   screenRect.setPosition(position);
 
-  window.draw(screenRect);
+  FrameProfiler::draw(window, screenRect);
 }
 
 void PauseScreen::renderTitle() {
@@ -112,7 +120,7 @@ void PauseScreen::renderTitle() {
 
   titleText.setScale(screenRect.getScale());
 
-  window.draw(titleText);
+  FrameProfiler::draw(window, titleText);
 }
 
 void PauseScreen::renderMenuItems() {
@@ -127,7 +135,7 @@ void PauseScreen::renderMenuItems() {
                                                   i * 50.0f * screenRect.getScale().y));
 
     item.setScale(screenRect.getScale());
-    window.draw(item);
+    FrameProfiler::draw(window, item);
 
     if (i == selectedIndex) {
       item.setFillColor(textColor);
@@ -137,7 +145,7 @@ void PauseScreen::renderMenuItems() {
       item.setStyle(sf::Text::Regular);
     }
 
-    window.draw(item);
+    FrameProfiler::draw(window, item);
   }
 }
 
@@ -149,5 +157,5 @@ void PauseScreen::renderBackButton() {
   backText.setPosition(sf::Vector2f(
       position.x,
       screenRect.getPosition().y + screenRect.getSize().y * screenRect.getScale().y - 40.0f * screenRect.getScale().y));
-  window.draw(backText);
+  FrameProfiler::draw(window, backText);
 }
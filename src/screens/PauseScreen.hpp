@@ -44,6 +44,8 @@ private:
 public:
   explicit PauseScreen(sf::RenderWindow& win, Game& gameRef);
 
+  static const ResourceSet& getResourceSet();
+
   void processEvents(const sf::Event& event) override;
   void update() override;
   void render() override;
@@ -0,0 +1,150 @@
+#include "ReplayScreen.hpp"
+#include <algorithm>
+#include <cstdio>
+#include "../Game.hpp"
+#include "../utils/FrameProfiler.hpp"
+#include "../utils/ResourceLoader.hpp"
+#include "../utils/ScalingUtils.hpp"
+#include "MainMenu.hpp"
+
+using namespace shape;
+
+namespace {
+// every character the status line can show, laid out once so drawing it never loads a glyph
+constexpr const char* STATUS_GLYPHS = "0123456789:/x scorepaused";
+}  // namespace
+
+const ResourceSet& ReplayScreen::getResourceSet() {
+  static const ResourceSet resourceSet{
+      {TextureType::Snake, TextureType::GreenApple, TextureType::RedApple, TextureType::FantomApple,
+       TextureType::WaterBubble, TextureType::BoardBorder, TextureType::BoardGrid, TextureType::Wall_1,
+       TextureType::Wall_2, TextureType::Wall_3, TextureType::Wall_4},
+      {FontType::DebugFont},
+      {},
+      {}};
+  return resourceSet;
+}
+
+ReplayScreen::ReplayScreen(sf::RenderWindow& win, Game& gameRef, Replay replay)
+    : Screen(win, gameRef, getResourceSet()),
+      gameGrid(GameSimulation::GRID_ROWS, GameSimulation::GRID_COLS, 824.0f, sf::Vector2f(0, 0), 1.0f, 912.0f),
+      replay(std::move(replay)),
+      player(this->replay, arena.getResource()),
+      statusText(ResourceLoader::getFont(FontType::DebugFont)) {
+  initializeGrid();
+  statusText.setCharacterSize(18);
+  statusText.setString(STATUS_GLYPHS);
+  (void)statusText.getLocalBounds();
+  frameClock.restart();
+}
+
+void ReplayScreen::processEvents(const sf::Event& event) {
+  if (event.is<sf::Event::KeyPressed>()) {
+    switch (event.getIf<sf::Event::KeyPressed>()->code) {
+      case sf::Keyboard::Key::Escape:
+        game.setCurrentScreen(new MainMenu(window, game));
+        return;
+      case sf::Keyboard::Key::Space:
+        isPaused = !isPaused;
+        break;
+      case sf::Keyboard::Key::Right:
+        seekBy(SEEK_STEP_SECONDS);
+        break;
+      case sf::Keyboard::Key::Left:
+        seekBy(-SEEK_STEP_SECONDS);
+        break;
+      case sf::Keyboard::Key::Up:
+        playbackSpeed = std::min(playbackSpeed * 2, MAX_PLAYBACK_SPEED);
+        break;
+      case sf::Keyboard::Key::Down:
+        playbackSpeed = std::max(playbackSpeed / 2, 1);
+        break;
+      case sf::Keyboard::Key::Home:
+        player.seek(0);
+        break;
+      case sf::Keyboard::Key::End:
+        player.seek(replay.finalTick);
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (event.is<sf::Event::Resized>()) {
+    initializeGrid();
+  }
+}
+
+void ReplayScreen::seekBy(int seconds) {
+  const int64_t target = static_cast<int64_t>(player.getTick()) + seconds * GameSimulation::TICKS_PER_SECOND;
+  player.seek(static_cast<uint32_t>(std::clamp<int64_t>(target, 0, replay.finalTick)));
+  tickAccumulator = 0.0f;
+}
+
+void ReplayScreen::update() {
+  const float frameSeconds = frameClock.restart().asSeconds();
+  if (isPaused || player.isFinished()) {
+    return;
+  }
+
+  // a long stall must not turn into a jump, so at most a tenth of a second of replay time per frame
+  tickAccumulator = std::min(tickAccumulator + frameSeconds, 0.1f);
+  const float replaySeconds = tickAccumulator * static_cast<float>(playbackSpeed);
+  const auto ticks = static_cast<uint32_t>(replaySeconds / GameSimulation::TICK_SECONDS);
+  player.advance(ticks);
+  tickAccumulator -= static_cast<float>(ticks) * GameSimulation::TICK_SECONDS / static_cast<float>(playbackSpeed);
+}
+
+void ReplayScreen::render() {
+  renderBoard();
+
+  const GameSimulation& simulation = player.getSimulation();
+  simulation.getWallManager().render(window, gameGrid);
+  simulation.getGameItemManager().render(window, gameGrid);
+  simulation.getSnake().render(window, gameGrid);
+
+  renderStatus();
+}
+
+void ReplayScreen::renderBoard() const {
+  sf::Sprite border(ResourceLoader::getTexture(TextureType::BoardBorder));
+  const float borderScale = getScale(sf::Vector2f(border.getTexture().getSize()), window.getSize());
+  border.setScale(sf::Vector2f(borderScale, borderScale));
+  border.setPosition(getPosition(sf::Vector2f(border.getTexture().getSize()), window.getSize(), borderScale));
+  FrameProfiler::draw(window, border);
+
+  sf::Sprite grid(ResourceLoader::getTexture(TextureType::BoardGrid));
+  const float gridScale =
+      getScale(sf::Vector2f(grid.getTexture().getSize()), window.getSize()) * gameGrid.getScaleFactor();
+  grid.setScale(sf::Vector2f(gridScale, gridScale));
+  grid.setPosition(getPosition(sf::Vector2f(grid.getTexture().getSize()), window.getSize(), gridScale));
+  FrameProfiler::draw(window, grid);
+}
+
+void ReplayScreen::renderStatus() {
+  const uint32_t seconds = player.getTick() / GameSimulation::TICKS_PER_SECOND;
+  const uint32_t finalSeconds = replay.finalTick / GameSimulation::TICKS_PER_SECOND;
+  // fixed-width fields keep the length steady, so the string is rewritten rather than reallocated
+  char status[64];
+  const int length = std::snprintf(status, sizeof(status), "%u:%02u / %u:%02u  x%-3d  score %-5d%s", seconds / 60,
+                                   seconds % 60, finalSeconds / 60, finalSeconds % 60, playbackSpeed,
+                                   player.getSimulation().getScore(), isPaused ? "  paused" : "");
+  if (length != static_cast<int>(statusString.getSize())) {
+    statusString = status;
+  } else {
+    for (int i = 0; i < length; ++i) {
+      statusString[static_cast<size_t>(i)] = static_cast<char32_t>(status[i]);
+    }
+  }
+
+  statusText.setString(statusString);
+  statusText.setPosition(sf::Vector2f(16.0f, 16.0f));
+  FrameProfiler::draw(window, statusText);
+}
+
+void ReplayScreen::initializeGrid() {
+  const float scale = getScale(sf::Vector2f(gridSize, gridSize), window.getSize()) * gameGrid.getScaleFactor();
+  const auto position = getPosition(sf::Vector2f(gridSize, gridSize), window.getSize(), scale);
+
+  gameGrid.updateGrid(position, scale);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <algorithm>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/System/Clock.hpp>
+#include "../Screen.hpp"
+#include "../utils/GameGrid.hpp"
+#include "../utils/SessionArena.hpp"
+#include "../utils/replay/ReplayPlayer.hpp"
+
+// Plays a recorded game back. Fast-forward and seeking simulate headlessly and only the resulting
+// state is drawn, so scrubbing costs one frame however far it jumps.
+class ReplayScreen final : public Screen {
+public:
+  explicit ReplayScreen(sf::RenderWindow& win, Game& gameRef, Replay replay);
+
+  static const ResourceSet& getResourceSet();
+
+  void processEvents(const sf::Event& event) override;
+  void update() override;
+  void render() override;
+
+  [[nodiscard]] bool isFinished() const { return player.isFinished(); }
+  void setPlaybackSpeed(int speed) { playbackSpeed = std::clamp(speed, 1, MAX_PLAYBACK_SPEED); }
+
+private:
+  static constexpr int SEEK_STEP_SECONDS = 10;
+  static constexpr int MAX_PLAYBACK_SPEED = 256;
+
+  float gridSize = 824.0f;
+  GameGrid gameGrid;
+
+  SessionArena arena;
+  Replay replay;
+  ReplayPlayer player;
+
+  sf::Text statusText;
+  // edited in place while the status keeps its length, so a steady frame does not allocate
+  sf::String statusString;
+  sf::Clock frameClock;
+  float tickAccumulator = 0.0f;
+  int playbackSpeed = 1;
+  bool isPaused = false;
+
+  void seekBy(int seconds);
+  void initializeGrid();
+  void renderBoard() const;
+  void renderStatus();
+};
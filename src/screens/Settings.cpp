@@ -1,13 +1,21 @@
 #include "Settings.hpp"
-#include <iostream>
 #include "../utils/FontInitializer.hpp"
+#include "../utils/FrameProfiler.hpp"
+#include "../utils/Logger.hpp"
 #include "../utils/ScalingUtils.hpp"
 #include "../utils/SettingStorage.hpp"
 #include "MainMenu.hpp"
 
 using namespace shape;
 
-Settings::Settings(sf::RenderWindow& win, Game& gameRef) : Screen(win, gameRef), titleText(font), backText(font) {
+const ResourceSet& Settings::getResourceSet() {
+  static const ResourceSet resourceSet{
+      {}, {FontType::DebugFont}, {SoundType::SetActiveMenuItem, SoundType::SelectMenuItem}, {}};
+  return resourceSet;
+}
+
+Settings::Settings(sf::RenderWindow& win, Game& gameRef)
+    : Screen(win, gameRef, getResourceSet()), titleText(font), backText(font) {
   font = FontInitializer::getDebugFont();
   FontInitializer::initializeTitleText(titleText, font, L"Настройки");
   FontInitializer::initializeBackText(backText, font, 14);
@@ -27,13 +35,13 @@ void Settings::processEvents(const sf::Event& event) {
     switch (event.getIf<sf::Event::KeyPressed>()->code) {
       case sf::Keyboard::Key::W:
       case sf::Keyboard::Key::Up:
-        std::cout << "Keypressed up(w)" << std::endl;
+        LOG_DEBUG("Keypressed up(w)");
         selectedIndex = (selectedIndex - 1 + MENU_ITEMS_COUNT) % MENU_ITEMS_COUNT;
         soundManager.playNavigationSound();
         break;
       case sf::Keyboard::Key::S:
       case sf::Keyboard::Key::Down:
-        std::cout << "Keypressed down(s)" << std::endl;
+        LOG_DEBUG("Keypressed down(s)");
         selectedIndex = (selectedIndex + 1) % MENU_ITEMS_COUNT;
         soundManager.playNavigationSound();
         break;
@@ -85,7 +93,7 @@ void Settings::renderMenuRect() {
   const auto position = getPosition(sf::Vector2f(screenRect.getSize()), window.getSize(), scale);
   screenRect.setPosition(position);
 
-  window.draw(screenRect);
+  FrameProfiler::draw(window, screenRect);
 }
 
 void Settings::renderTitle() {
@@ -95,7 +103,7 @@ void Settings::renderTitle() {
 
   titleText.setScale(screenRect.getScale());
 
-  window.draw(titleText);
+  FrameProfiler::draw(window, titleText);
 }
 
 void Settings::renderMenuItems() {
@@ -118,13 +126,12 @@ void Settings::renderMenuItems() {
       item.setStyle(sf::Text::Regular);
     }
 
-    window.draw(item);
+    FrameProfiler::draw(window, item);
   }
 }
 
 void Settings::toggleSoundSetting() {
-  SettingStorage settingStorage;
-  settingStorage.loadSettings();
+  SettingStorage& settingStorage = game.getSettingStorage();
 
   switch (selectedIndex) {
     case 0:
@@ -149,19 +156,12 @@ void Settings::renderBackButton() {
   backText.setPosition(sf::Vector2f(
       position.x,
       screenRect.getPosition().y + screenRect.getSize().y * screenRect.getScale().y - 40.0f * screenRect.getScale().y));
-  window.draw(backText);
+  FrameProfiler::draw(window, backText);
 }
 
 void Settings::loadSettings() {
-  SettingStorage settingStorage;
+  game.refreshSettings();
 
-  bool settingsLoaded = settingStorage.loadSettings();
-
-  if (settingsLoaded) {
-    soundEnabled = settingStorage.getGameSound();
-    musicEnabled = settingStorage.getGameMusic();
-  } else {
-    soundEnabled = true;
-    musicEnabled = true;
-  }
+  soundEnabled = game.getSettingsReader().getGameSound();
+  musicEnabled = game.getSettingsReader().getGameMusic();
 }
@@ -51,6 +51,8 @@ private:
 public:
   explicit Settings(sf::RenderWindow& win, Game& gameRef);
 
+  static const ResourceSet& getResourceSet();
+
   void processEvents(const sf::Event& event) override;
   void update() override;
   void render() override;
@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+
+struct AllocationCounts {
+  uint64_t allocations = 0;
+  uint64_t bytes = 0;
+};
+
+// Counts heap allocations. AllocationTracker.cpp replaces the global operator new and delete for the whole
+// program, so everything that allocates through new, the standard containers and SFML included, is counted;
+// C libraries calling malloc directly, like FreeType, are not. The counters are per thread: a scope on the
+// main thread sees only its own allocations, never the logger's or the audio mixer's. Counting costs two
+// thread-local increments per allocation.
+class AllocationTracker {
+public:
+  // allocations made by the calling thread since it started
+  static AllocationCounts getThreadCounts();
+};
+
+// allocations made by the calling thread since the scope was entered
+class AllocationScope {
+public:
+  AllocationScope() : start(AllocationTracker::getThreadCounts()) {}
+
+  [[nodiscard]] AllocationCounts getCounts() const {
+    const AllocationCounts now = AllocationTracker::getThreadCounts();
+    return AllocationCounts{now.allocations - start.allocations, now.bytes - start.bytes};
+  }
+
+private:
+  AllocationCounts start;
+};
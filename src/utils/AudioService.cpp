@@ -0,0 +1,261 @@
+#include "AudioService.hpp"
+#include <iostream>
+#include "TraceRecorder.hpp"
+
+AudioService& AudioService::getInstance() {
+  static AudioService instance;
+  return instance;
+}
+
+AudioService::AudioService() = default;
+
+AudioService::~AudioService() {
+  shutdown();
+}
+
+void AudioService::preload(const std::vector<SoundType>& soundTypes) {
+  for (const auto soundType : soundTypes) {
+    auto& cached = pcmCache[static_cast<size_t>(soundType)];
+    if (!cached) {
+      cached = ResourceLoader::acquireSound(soundType);
+    }
+  }
+}
+
+void AudioService::play(SoundType soundType) {
+  auto& cached = pcmCache[static_cast<size_t>(soundType)];
+  if (!cached) {
+    cached = ResourceLoader::acquireSound(soundType);
+    if (!cached) {
+      return;
+    }
+  }
+
+  ensureWorker();
+  triggeredCount.fetch_add(1, std::memory_order_relaxed);
+  if (TraceRecorder::isCapturing()) {
+    TraceRecorder::getInstance().recordInstant("play sound");
+  }
+
+  if (!requests.push(PlayRequest{soundType, false, std::chrono::steady_clock::now()})) {
+    droppedCount.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  requestSignal.fetch_add(1, std::memory_order_release);
+  requestSignal.notify_one();
+}
+
+void AudioService::stopAll() {
+  if (!running.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  if (requests.push(PlayRequest{SoundType::EatApple, true, std::chrono::steady_clock::now()})) {
+    requestSignal.fetch_add(1, std::memory_order_release);
+    requestSignal.notify_one();
+  }
+}
+
+void AudioService::shutdown() {
+  if (running.exchange(false)) {
+    requestSignal.fetch_add(1, std::memory_order_release);
+    requestSignal.notify_one();
+    worker.join();
+  }
+
+  for (auto& voice : voices) {
+    voice.sound.reset();
+  }
+  for (auto& cached : pcmCache) {
+    cached.reset();
+  }
+}
+
+void AudioService::ensureWorker() {
+  if (running.load(std::memory_order_acquire)) {
+    return;
+  }
+  running.store(true, std::memory_order_release);
+  worker = std::thread(&AudioService::workerLoop, this);
+}
+
+void AudioService::workerLoop() {
+  TraceRecorder::nameThread("audio mixer");
+  while (running.load(std::memory_order_acquire)) {
+    const uint32_t observedSignal = requestSignal.load(std::memory_order_acquire);
+
+    const auto busyStart = std::chrono::steady_clock::now();
+    bool handled = false;
+
+    PlayRequest request;
+    while (requests.pop(request)) {
+      handled = true;
+
+      if (request.stopAll) {
+        for (auto& voice : voices) {
+          if (voice.sound) {
+            voice.sound->stop();
+          }
+        }
+        continue;
+      }
+
+      startVoice(request);
+    }
+
+    if (handled) {
+      const auto busy = std::chrono::steady_clock::now() - busyStart;
+      workerBusyNanos.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(busy).count(),
+                                std::memory_order_relaxed);
+    }
+
+    requestSignal.wait(observedSignal, std::memory_order_acquire);
+  }
+
+  for (auto& voice : voices) {
+    if (voice.sound) {
+      voice.sound->stop();
+    }
+  }
+}
+
+void AudioService::startVoice(const PlayRequest& request) {
+  TRACE_SCOPE("start voice");
+  const sf::SoundBuffer& buffer = pcmCache[static_cast<size_t>(request.soundType)].get();
+  const SoundCategory category = getCategory(request.soundType);
+
+  Voice& voice = selectVoice(category);
+  if (voice.sound) {
+    voice.sound->stop();
+    voice.sound->setBuffer(buffer);
+  } else {
+    voice.sound.emplace(buffer);
+  }
+
+  voice.category = category;
+  voice.startedAt = ++voiceClock;
+  voice.sound->setVolume(getVolume(request.soundType));
+  voice.sound->play();
+
+  const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                            request.triggeredAt)
+                           .count();
+  playedCount.fetch_add(1, std::memory_order_relaxed);
+  totalLatencyNanos.fetch_add(latency, std::memory_order_relaxed);
+  if (static_cast<uint64_t>(latency) > maxLatencyNanos.load(std::memory_order_relaxed)) {
+    maxLatencyNanos.store(latency, std::memory_order_relaxed);
+  }
+}
+
+AudioService::Voice& AudioService::selectVoice(SoundCategory category) {
+  int busyInCategory = 0;
+  Voice* oldestInCategory = nullptr;
+  Voice* oldestOverall = nullptr;
+  Voice* freeVoice = nullptr;
+
+  for (auto& voice : voices) {
+    if (!isVoiceBusy(voice)) {
+      if (!freeVoice) {
+        freeVoice = &voice;
+      }
+      continue;
+    }
+
+    if (!oldestOverall || voice.startedAt < oldestOverall->startedAt) {
+      oldestOverall = &voice;
+    }
+
+    if (voice.category == category) {
+      busyInCategory++;
+      if (!oldestInCategory || voice.startedAt < oldestInCategory->startedAt) {
+        oldestInCategory = &voice;
+      }
+    }
+  }
+
+  if (busyInCategory >= getVoiceLimit(category) && oldestInCategory) {
+    stolenCount.fetch_add(1, std::memory_order_relaxed);
+    return *oldestInCategory;
+  }
+
+  if (freeVoice) {
+    return *freeVoice;
+  }
+
+  stolenCount.fetch_add(1, std::memory_order_relaxed);
+  return oldestInCategory ? *oldestInCategory : *oldestOverall;
+}
+
+bool AudioService::isVoiceBusy(const Voice& voice) {
+  return voice.sound && voice.sound->getStatus() == sf::SoundSource::Status::Playing;
+}
+
+AudioStats AudioService::getStats() const {
+  AudioStats stats;
+  stats.triggered = triggeredCount.load(std::memory_order_relaxed);
+  stats.played = playedCount.load(std::memory_order_relaxed);
+  stats.stolen = stolenCount.load(std::memory_order_relaxed);
+  stats.dropped = droppedCount.load(std::memory_order_relaxed);
+  stats.maxLatencyMicros = maxLatencyNanos.load(std::memory_order_relaxed) / 1000.0;
+  stats.workerBusyMicros = workerBusyNanos.load(std::memory_order_relaxed) / 1000.0;
+  if (stats.played > 0) {
+    stats.averageLatencyMicros = totalLatencyNanos.load(std::memory_order_relaxed) / 1000.0 / stats.played;
+  }
+  return stats;
+}
+
+void AudioService::logStats() const {
+  const AudioStats stats = getStats();
+  std::cout << "Audio: " << stats.triggered << " triggered, " << stats.played << " played, " << stats.stolen
+            << " voices stolen, " << stats.dropped << " dropped, latency avg " << stats.averageLatencyMicros
+            << " us / max " << stats.maxLatencyMicros << " us, mixer busy " << stats.workerBusyMicros << " us"
+            << std::endl;
+}
+
+SoundCategory AudioService::getCategory(SoundType soundType) {
+  switch (soundType) {
+    case SoundType::SelectMenuItem:
+    case SoundType::SetActiveMenuItem:
+      return SoundCategory::Menu;
+    case SoundType::Countdown:
+      return SoundCategory::Countdown;
+    case SoundType::EatApple:
+    case SoundType::GameOver:
+    case SoundType::StartGame:
+    default:
+      return SoundCategory::Gameplay;
+  }
+}
+
+float AudioService::getVolume(SoundType soundType) {
+  switch (soundType) {
+    case SoundType::EatApple:
+      return AudioConstants::SoundEffects::EAT_APPLE_VOLUME;
+    case SoundType::GameOver:
+      return AudioConstants::SoundEffects::GAME_OVER_VOLUME;
+    case SoundType::Countdown:
+      return AudioConstants::SoundEffects::COUNTDOWN_VOLUME;
+    case SoundType::SelectMenuItem:
+      return AudioConstants::SoundEffects::MENU_SELECTION_VOLUME;
+    case SoundType::SetActiveMenuItem:
+      return AudioConstants::SoundEffects::MENU_NAVIGATION_VOLUME;
+    case SoundType::StartGame:
+      return AudioConstants::SoundEffects::START_GAME_VOLUME;
+    default:
+      return 100.0f;
+  }
+}
+
+int AudioService::getVoiceLimit(SoundCategory category) {
+  switch (category) {
+    case SoundCategory::Gameplay:
+      return AudioConstants::Voices::GAMEPLAY_LIMIT;
+    case SoundCategory::Menu:
+      return AudioConstants::Voices::MENU_LIMIT;
+    case SoundCategory::Countdown:
+      return AudioConstants::Voices::COUNTDOWN_LIMIT;
+    default:
+      return AudioConstants::Voices::POOL_SIZE;
+  }
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <SFML/Audio.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "../config/AudioConstants.hpp"
+#include "ResourceLoader.hpp"
+#include "SpscQueue.hpp"
+
+enum class SoundCategory { Gameplay, Menu, Countdown };
+
+struct AudioStats {
+  uint64_t triggered = 0;
+  uint64_t played = 0;
+  uint64_t stolen = 0;
+  uint64_t dropped = 0;
+  double averageLatencyMicros = 0.0;
+  double maxLatencyMicros = 0.0;
+  double workerBusyMicros = 0.0;
+};
+
+// Plays sound effects on a fixed pool of voices owned by a mixer thread. play() only pushes
+// a request into a lock-free queue, so it is safe to call from the game loop every frame.
+// When a category runs out of voices its oldest voice is reused instead of cutting off
+// the sound that was triggered last.
+class AudioService {
+public:
+  static AudioService& getInstance();
+
+  void preload(const std::vector<SoundType>& soundTypes);
+
+  void play(SoundType soundType);
+
+  void stopAll();
+
+  void shutdown();
+
+  AudioStats getStats() const;
+  void logStats() const;
+
+  static SoundCategory getCategory(SoundType soundType);
+  static float getVolume(SoundType soundType);
+  static int getVoiceLimit(SoundCategory category);
+
+private:
+  AudioService();
+  ~AudioService();
+  AudioService(const AudioService&) = delete;
+  AudioService& operator=(const AudioService&) = delete;
+
+  static constexpr size_t SOUND_TYPE_COUNT = static_cast<size_t>(SoundType::StartGame) + 1;
+
+  struct PlayRequest {
+    SoundType soundType = SoundType::EatApple;
+    bool stopAll = false;
+    std::chrono::steady_clock::time_point triggeredAt;
+  };
+
+  struct Voice {
+    std::optional<sf::Sound> sound;
+    SoundCategory category = SoundCategory::Gameplay;
+    uint64_t startedAt = 0;
+  };
+
+  void ensureWorker();
+  void workerLoop();
+  void startVoice(const PlayRequest& request);
+  Voice& selectVoice(SoundCategory category);
+  static bool isVoiceBusy(const Voice& voice);
+
+  std::array<ResourceHandle<sf::SoundBuffer>, SOUND_TYPE_COUNT> pcmCache;
+
+  SpscQueue<PlayRequest, AudioConstants::Voices::REQUEST_QUEUE_CAPACITY> requests;
+  std::atomic<uint32_t> requestSignal{0};
+  std::atomic<bool> running{false};
+  std::thread worker;
+
+  std::array<Voice, AudioConstants::Voices::POOL_SIZE> voices;
+  uint64_t voiceClock = 0;
+
+  std::atomic<uint64_t> triggeredCount{0};
+  std::atomic<uint64_t> playedCount{0};
+  std::atomic<uint64_t> stolenCount{0};
+  std::atomic<uint64_t> droppedCount{0};
+  std::atomic<uint64_t> totalLatencyNanos{0};
+  std::atomic<uint64_t> maxLatencyNanos{0};
+  std::atomic<uint64_t> workerBusyNanos{0};
+};
@@ -0,0 +1,119 @@
+#include "BitGrid.hpp"
+#include <algorithm>
+
+namespace {
+// Spreads every set bit of seed across the run of open bits it sits in. Towards the high bits one add does
+// it: the carry from the lowest seed ripples up to the end of its run. Towards the low bits there is no
+// such trick, so that side uses Kogge-Stone occluded fill, six shift-and-mask doubling steps.
+uint64_t fillRuns(uint64_t seed, uint64_t open) {
+  const uint64_t start = seed & open;
+  const uint64_t up = (((start + open) ^ open) & open) | start;
+
+  uint64_t down = start;
+  uint64_t downOpen = open;
+  for (int shift = 1; shift < 64; shift <<= 1) {
+    down |= downOpen & (down >> shift);
+    downOpen &= downOpen >> shift;
+  }
+  return up | down;
+}
+}  // namespace
+
+BitGrid::BitGrid(int cols, int rows)
+    : cols(std::min(cols, MAX_COLS)),
+      rows(rows),
+      wordsPerRow((this->cols + 63) / 64),
+      words(static_cast<size_t>(rows) * wordsPerRow, 0) {}
+
+void BitGrid::clear() {
+  std::fill(words.begin(), words.end(), 0);
+}
+
+void BitGrid::fill() {
+  const int tailBits = cols % 64;
+  const uint64_t lastWord = tailBits == 0 ? ~uint64_t{0} : (uint64_t{1} << tailBits) - 1;
+  for (int row = 0; row < rows; ++row) {
+    uint64_t* rowWords = &words[static_cast<size_t>(row) * wordsPerRow];
+    std::fill(rowWords, rowWords + wordsPerRow, ~uint64_t{0});
+    rowWords[wordsPerRow - 1] = lastWord;
+  }
+}
+
+int BitGrid::count() const {
+  int total = 0;
+  for (const uint64_t word : words) {
+    total += std::popcount(word);
+  }
+  return total;
+}
+
+bool BitGrid::spreadRow(const uint64_t* open, const uint64_t* neighbour, uint64_t* row, int wordCount) {
+  uint64_t next[MAX_WORDS_PER_ROW];
+  bool grew = false;
+  for (int i = 0; i < wordCount; ++i) {
+    next[i] = row[i] | (neighbour[i] & open[i]);
+    grew |= next[i] != row[i];
+  }
+  if (!grew) {
+    return false;
+  }
+
+  fillRow(open, next, wordCount);
+  std::copy(next, next + wordCount, row);
+  return true;
+}
+
+void BitGrid::fillRow(const uint64_t* open, uint64_t* row, int wordCount) {
+  // fill within each word, then carry across word boundaries until the row settles
+  bool carried = true;
+  while (carried) {
+    carried = false;
+    for (int i = 0; i < wordCount; ++i) {
+      row[i] = fillRuns(row[i], open[i]);
+    }
+    for (int i = 0; i + 1 < wordCount; ++i) {
+      const uint64_t rightward = (row[i] >> 63) & open[i + 1] & ~row[i + 1] & 1;
+      const uint64_t leftward = ((row[i + 1] & 1) << 63) & open[i] & ~row[i];
+      row[i + 1] |= rightward;
+      row[i] |= leftward;
+      carried |= (rightward | leftward) != 0;
+    }
+  }
+}
+
+void BitGrid::floodFill(const BitGrid& open, sf::Vector2i start, BitGrid& reachable) {
+  reachable.clear();
+  if (!open.test(start)) {
+    return;
+  }
+
+  const int stride = open.wordsPerRow;
+  const uint64_t* openWords = open.words.data();
+  uint64_t* reachWords = reachable.words.data();
+
+  reachable.set(start);
+  const size_t startOffset = static_cast<size_t>(start.y) * stride;
+  fillRow(openWords + startOffset, reachWords + startOffset, stride);
+
+  // only rows inside [top, bottom] can hold reachable cells, so sweeps skip the rest of the board
+  int top = start.y;
+  int bottom = start.y;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int row = top + 1; row < open.rows && row <= bottom + 1; ++row) {
+      const size_t offset = static_cast<size_t>(row) * stride;
+      if (spreadRow(openWords + offset, reachWords + offset - stride, reachWords + offset, stride)) {
+        changed = true;
+        bottom = std::max(bottom, row);
+      }
+    }
+    for (int row = bottom - 1; row >= 0 && row >= top - 1; --row) {
+      const size_t offset = static_cast<size_t>(row) * stride;
+      if (spreadRow(openWords + offset, reachWords + offset + stride, reachWords + offset, stride)) {
+        changed = true;
+        top = std::min(top, row);
+      }
+    }
+  }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+// One bit per cell, each row packed into 64-bit words, so set operations and neighbour steps work on 64
+// cells per instruction. The word loops are plain enough for the compiler to vectorise on wide boards.
+class BitGrid {
+public:
+  static constexpr int MAX_COLS = 4096;
+
+  // cols is capped at MAX_COLS
+  BitGrid(int cols, int rows);
+
+  [[nodiscard]] int getCols() const { return cols; }
+  [[nodiscard]] int getRows() const { return rows; }
+
+  [[nodiscard]] bool isInside(sf::Vector2i cell) const {
+    return cell.x >= 0 && cell.y >= 0 && cell.x < cols && cell.y < rows;
+  }
+  [[nodiscard]] bool test(sf::Vector2i cell) const {
+    return isInside(cell) && (words[wordIndex(cell)] >> (cell.x % 64) & 1) != 0;
+  }
+  void set(sf::Vector2i cell) {
+    if (isInside(cell)) {
+      words[wordIndex(cell)] |= uint64_t{1} << (cell.x % 64);
+    }
+  }
+  void reset(sf::Vector2i cell) {
+    if (isInside(cell)) {
+      words[wordIndex(cell)] &= ~(uint64_t{1} << (cell.x % 64));
+    }
+  }
+
+  void clear();
+  // sets every cell on the board, leaving the padding bits of the last word in each row clear
+  void fill();
+
+  [[nodiscard]] int count() const;
+
+  // Cells of open reachable from start in four-connected steps, written to reachable (same size).
+  // Rows are filled sideways with shift-and-mask doubling, then spread to the row above and below;
+  // alternating downward and upward sweeps repeat until nothing changes.
+  static void floodFill(const BitGrid& open, sf::Vector2i start, BitGrid& reachable);
+
+private:
+  int cols;
+  int rows;
+  int wordsPerRow;
+  std::vector<uint64_t> words;
+
+  [[nodiscard]] size_t wordIndex(sf::Vector2i cell) const {
+    return static_cast<size_t>(cell.y) * wordsPerRow + static_cast<size_t>(cell.x / 64);
+  }
+
+  static constexpr int MAX_WORDS_PER_ROW = MAX_COLS / 64;
+
+  static bool spreadRow(const uint64_t* open, const uint64_t* neighbour, uint64_t* row, int wordCount);
+  static void fillRow(const uint64_t* open, uint64_t* row, int wordCount);
+};
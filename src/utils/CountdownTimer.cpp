@@ -1,5 +1,6 @@
 #include "CountdownTimer.hpp"
-#include "../config/AudioConstants.hpp"
+#include "AudioService.hpp"
+#include "FrameProfiler.hpp"
 #include "ResourceLoader.hpp"
 
 CountdownTimer::CountdownTimer(int totalSeconds, bool soundEnabled)
@@ -8,10 +9,9 @@ CountdownTimer::CountdownTimer(int totalSeconds, bool soundEnabled)
       isActive(false),
       isFinished(false),
       soundEnabled(soundEnabled),
-      countdownText(ResourceLoader::getFont(FontType::DebugFont)),
-      countdownSound(ResourceLoader::getSound(SoundType::Countdown)) {
+      countdownText(ResourceLoader::getFont(FontType::DebugFont)) {
 
-  countdownSound.setVolume(AudioConstants::SoundEffects::COUNTDOWN_VOLUME);
+  AudioService::getInstance().preload({SoundType::Countdown});
 
   countdownText.setCharacterSize(72.0f);
   countdownText.setFillColor(sf::Color(130, 73, 113, 255));
@@ -30,7 +30,7 @@ void CountdownTimer::start() {
   updateText();
 
   if (soundEnabled && currentSeconds > 0) {
-    countdownSound.play();
+    AudioService::getInstance().play(SoundType::Countdown);
   }
 }
 
@@ -47,7 +47,7 @@ void CountdownTimer::update() {
     updateText();
 
     if (soundEnabled && currentSeconds > 0) {
-      countdownSound.play();
+      AudioService::getInstance().play(SoundType::Countdown);
     }
   }
 
@@ -61,7 +61,7 @@ void CountdownTimer::update() {
 
 void CountdownTimer::render(sf::RenderWindow& window) {
   if (isActive) {
-    window.draw(countdownText);
+    FrameProfiler::draw(window, countdownText);
   }
 }
 
@@ -1,13 +1,11 @@
 #pragma once
 
-#include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 
 class CountdownTimer {
 private:
   sf::Clock clock;
   sf::Text countdownText;
-  sf::Sound countdownSound;
   int totalSeconds;
   int currentSeconds;
   bool isActive;
@@ -1,5 +1,6 @@
 #include "DebugUI.hpp"
 #include <SFML/Graphics.hpp>
+#include "FrameProfiler.hpp"
 #include "ResourceLoader.hpp"
 
 std::string DebugUI::debugLines;
@@ -32,7 +33,7 @@ void DebugUI::render(sf::RenderWindow& window) {
   text.setOutlineThickness(1.0f);
   text.setPosition(sf::Vector2f(10.0f, 10.0f));
 
-  window.draw(text);
+  FrameProfiler::draw(window, text);
 }
 
 void DebugUI::clear() {
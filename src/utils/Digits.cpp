@@ -1,6 +1,7 @@
 #include "Digits.hpp"
-#include <iomanip>
-#include <sstream>
+#include <algorithm>
+#include <cstdio>
+#include "FrameProfiler.hpp"
 #include "ResourceLoader.hpp"
 
 Digits::Digits() : scale(1.0f), color(sf::Color::White) {
@@ -26,21 +27,22 @@ void Digits::renderDigit(sf::RenderTarget& target, int digit, const sf::Vector2f
   sprite.setScale(sf::Vector2f(scale, scale));
   sprite.setColor(color);
 
-  target.draw(sprite);
+  FrameProfiler::draw(target, sprite);
 }
 
 void Digits::renderNumber(sf::RenderTarget& target, int number, const sf::Vector2f& position, int maxDigits) const {
-  std::stringstream ss;
-  if (maxDigits > 0) {
-    ss << std::setfill('0') << std::setw(maxDigits) << number;
-  } else {
-    ss << number;
-  }
+  NumberBuffer buffer;
+  renderDigitString(target, formatNumber(number, maxDigits, buffer), position);
+}
 
-  renderDigitString(target, ss.str(), position);
+std::string_view Digits::formatNumber(int number, int maxDigits, NumberBuffer& buffer) {
+  // an int takes at most 11 characters with its sign, so the output always fits
+  const int width = std::clamp(maxDigits, 0, static_cast<int>(NUMBER_CAPACITY) - 1);
+  const int length = std::snprintf(buffer.data(), buffer.size(), "%0*d", width, number);
+  return std::string_view(buffer.data(), static_cast<size_t>(std::max(length, 0)));
 }
 
-void Digits::renderDigitString(sf::RenderTarget& target, const std::string& digitString,
+void Digits::renderDigitString(sf::RenderTarget& target, std::string_view digitString,
                                const sf::Vector2f& position) const {
   float currentX = position.x;
   const float digitSpacing = 4.0f * scale;  // 2 pixel spacing between digits
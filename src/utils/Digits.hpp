@@ -1,9 +1,14 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <string>
+#include <array>
+#include <string_view>
 
 class Digits {
 public:
+  // room for any int, or for zero padding up to NUMBER_CAPACITY - 1 digits
+  static constexpr size_t NUMBER_CAPACITY = 16;
+  using NumberBuffer = std::array<char, NUMBER_CAPACITY>;
+
   explicit Digits();
 
   void setScale(float scale) const;
@@ -14,7 +19,10 @@ public:
 
   void renderNumber(sf::RenderTarget& target, int number, const sf::Vector2f& position, int maxDigits = 0) const;
 
-  void renderDigitString(sf::RenderTarget& target, const std::string& digitString, const sf::Vector2f& position) const;
+  // the digits renderNumber draws, zero-padded to maxDigits; written into buffer, so it never allocates
+  static std::string_view formatNumber(int number, int maxDigits, NumberBuffer& buffer);
+
+  void renderDigitString(sf::RenderTarget& target, std::string_view digitString, const sf::Vector2f& position) const;
 
   float getDigitWidth() const;
 
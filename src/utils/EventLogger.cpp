@@ -1,9 +1,11 @@
 #include "EventLogger.hpp"
+#include <array>
 #include "DebugUI.hpp"
+#include "Logger.hpp"
 
 bool EventLogger::debugMode = false;
 namespace {
-std::string getKeyName(const sf::Keyboard::Key key) {
+const char* getKeyName(const sf::Keyboard::Key key) {
   switch (key) {
     case sf::Keyboard::Key::A:
       return "A";
@@ -108,29 +110,47 @@ std::string getKeyName(const sf::Keyboard::Key key) {
     case sf::Keyboard::Key::RSystem:
       return "Win";
     default:
-      return "Unknown(" + std::to_string(static_cast<int>(key)) + ")";
+      return "Unknown";
   }
 }
 
-std::string getModifiers() {
-  std::string result;
+const char* getModifiers() {
+  static constexpr std::array<const char*, 16> MODIFIER_NAMES = {
+      "",           "Ctrl+",           "Alt+",           "Ctrl+Alt+",
+      "Shift+",     "Ctrl+Shift+",     "Alt+Shift+",     "Ctrl+Alt+Shift+",
+      "Win+",       "Ctrl+Win+",       "Alt+Win+",       "Ctrl+Alt+Win+",
+      "Shift+Win+", "Ctrl+Shift+Win+", "Alt+Shift+Win+", "Ctrl+Alt+Shift+Win+"};
 
+  size_t mask = 0;
   if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LControl) ||
       sf::Keyboard::isKeyPressed(sf::Keyboard::Key::RControl)) {
-    result += "Ctrl+";
+    mask |= 1;
   }
   if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LAlt) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::RAlt)) {
-    result += "Alt+";
+    mask |= 2;
   }
   if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LShift) || sf::Keyboard::isKeyPressed(sf::Keyboard::Key::RShift)) {
-    result += "Shift+";
+    mask |= 4;
   }
   if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::LSystem) ||
       sf::Keyboard::isKeyPressed(sf::Keyboard::Key::RSystem)) {
-    result += "Win+";
+    mask |= 8;
   }
 
-  return result;
+  return MODIFIER_NAMES[mask];
+}
+
+const char* getButtonName(const sf::Mouse::Button button) {
+  switch (button) {
+    case sf::Mouse::Button::Left:
+      return "Left";
+    case sf::Mouse::Button::Right:
+      return "Right";
+    case sf::Mouse::Button::Middle:
+      return "Middle";
+    default:
+      return "Other";
+  }
 }
 
 bool isModifierKey(const sf::Keyboard::Key key) {
@@ -144,82 +164,41 @@ void EventLogger::setDebugMode(const bool enabled) {
   debugMode = enabled;
 }
 
-void EventLogger::logEvent(const sf::Event& event) {
-  std::string eventText;
+template <typename... Args>
+void EventLogger::emit(const char* format, const Args&... args) {
+  if (debugMode) {
+    DebugUI::addDebugText(Logger::format(format, args...));
+  } else {
+    LOG_DEBUG(format, args...);
+  }
+}
 
-  if (event.is<sf::Event::KeyPressed>()) {
-    const auto keyEvent = event.getIf<sf::Event::KeyPressed>();
-    if (isModifierKey(keyEvent->code)) {
-      eventText = "KeyPressed: " + getKeyName(keyEvent->code);
-    } else {
-      std::string modifiers = getModifiers();
-      eventText = "KeyPressed: " + modifiers + getKeyName(keyEvent->code);
-    }
-  } else if (event.is<sf::Event::KeyReleased>()) {
-    const auto keyEvent = event.getIf<sf::Event::KeyReleased>();
-    if (isModifierKey(keyEvent->code)) {
-      eventText = "KeyReleased: " + getKeyName(keyEvent->code);
-    } else {
-      std::string modifiers = getModifiers();
-      eventText = "KeyReleased: " + modifiers + getKeyName(keyEvent->code);
-    }
-  } else if (event.is<sf::Event::MouseButtonPressed>()) {
-    const auto mouseEvent = event.getIf<sf::Event::MouseButtonPressed>();
-    std::string buttonName;
-    switch (mouseEvent->button) {
-      case sf::Mouse::Button::Left:
-        buttonName = "Left";
-        break;
-      case sf::Mouse::Button::Right:
-        buttonName = "Right";
-        break;
-      case sf::Mouse::Button::Middle:
-        buttonName = "Middle";
-        break;
-      default:
-        buttonName = "Other";
-        break;
-    }
-    eventText = "MousePressed: " + buttonName + " at (" + std::to_string(mouseEvent->position.x) + ", " +
-                std::to_string(mouseEvent->position.y) + ")";
-  } else if (event.is<sf::Event::MouseButtonReleased>()) {
-    const auto mouseEvent = event.getIf<sf::Event::MouseButtonReleased>();
-    std::string buttonName;
-    switch (mouseEvent->button) {
-      case sf::Mouse::Button::Left:
-        buttonName = "Left";
-        break;
-      case sf::Mouse::Button::Right:
-        buttonName = "Right";
-        break;
-      case sf::Mouse::Button::Middle:
-        buttonName = "Middle";
-        break;
-      default:
-        buttonName = "Other";
-        break;
+void EventLogger::logEvent(const sf::Event& event) {
+  if constexpr (LOG_LEVEL > LOG_LEVEL_DEBUG) {
+    if (!debugMode) {
+      return;
     }
-    eventText = "MouseReleased: " + buttonName + " at (" + std::to_string(mouseEvent->position.x) + ", " +
-                std::to_string(mouseEvent->position.y) + ")";
-  } else if (event.is<sf::Event::MouseMoved>()) {
-    const auto mouseEvent = event.getIf<sf::Event::MouseMoved>();
-    eventText =
-        "MouseMoved: (" + std::to_string(mouseEvent->position.x) + ", " + std::to_string(mouseEvent->position.y) + ")";
-  } else if (event.is<sf::Event::Closed>()) {
-    eventText = "WindowClosed";
-  } else if (event.is<sf::Event::Resized>()) {
-    const auto resizeEvent = event.getIf<sf::Event::Resized>();
-    eventText = "WindowResized: " + std::to_string(resizeEvent->size.x) + "x" + std::to_string(resizeEvent->size.y);
-  } else if (event.is<sf::Event::TextEntered>()) {
-    const auto textEvent = event.getIf<sf::Event::TextEntered>();
-    eventText = "TextEntered: " + std::string(1, static_cast<char>(textEvent->unicode));
-  } else {
-    eventText = "Other Event";
   }
 
-  if (debugMode) {
-    DebugUI::addDebugText(eventText);
+  if (const auto* keyEvent = event.getIf<sf::Event::KeyPressed>()) {
+    emit("Event: KeyPressed: {}{}", isModifierKey(keyEvent->code) ? "" : getModifiers(), getKeyName(keyEvent->code));
+  } else if (const auto* keyEvent = event.getIf<sf::Event::KeyReleased>()) {
+    emit("Event: KeyReleased: {}{}", isModifierKey(keyEvent->code) ? "" : getModifiers(), getKeyName(keyEvent->code));
+  } else if (const auto* mouseEvent = event.getIf<sf::Event::MouseButtonPressed>()) {
+    emit("Event: MousePressed: {} at ({}, {})", getButtonName(mouseEvent->button), mouseEvent->position.x,
+         mouseEvent->position.y);
+  } else if (const auto* mouseEvent = event.getIf<sf::Event::MouseButtonReleased>()) {
+    emit("Event: MouseReleased: {} at ({}, {})", getButtonName(mouseEvent->button), mouseEvent->position.x,
+         mouseEvent->position.y);
+  } else if (const auto* mouseEvent = event.getIf<sf::Event::MouseMoved>()) {
+    emit("Event: MouseMoved: ({}, {})", mouseEvent->position.x, mouseEvent->position.y);
+  } else if (event.is<sf::Event::Closed>()) {
+    emit("Event: WindowClosed");
+  } else if (const auto* resizeEvent = event.getIf<sf::Event::Resized>()) {
+    emit("Event: WindowResized: {}x{}", resizeEvent->size.x, resizeEvent->size.y);
+  } else if (const auto* textEvent = event.getIf<sf::Event::TextEntered>()) {
+    emit("Event: TextEntered: {}", static_cast<uint32_t>(textEvent->unicode));
   } else {
-    std::cout << "Event: " << eventText << std::endl;
+    emit("Event: Other Event");
   }
 }
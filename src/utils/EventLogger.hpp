@@ -1,6 +1,5 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <iostream>
 
 class EventLogger {
 public:
@@ -8,5 +7,8 @@ public:
   static void setDebugMode(const bool enabled);
 
 private:
+  template <typename... Args>
+  static void emit(const char* format, const Args&... args);
+
   static bool debugMode;
 };
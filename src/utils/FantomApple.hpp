@@ -5,7 +5,8 @@ class FantomApple : public GameItem {
 public:
   FantomApple(sf::Vector2i position, float lifetimeMultiplier = 1.0f);
 
-  void render(sf::RenderWindow& window, const GameGrid& grid) const override;
+  GameItemType getType() const override { return GameItemType::FantomApple; }
+  TextureType getTextureType() const override;
   int getPoints() const override { return 0; }
   int getSpeedBonus() const override { return 2; }
   float getSpeedBonusDuration() const override { return 0.0f; }
@@ -0,0 +1,219 @@
+#include "FrameProfiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include "ResourceLoader.hpp"
+
+namespace {
+constexpr std::array<const char*, static_cast<size_t>(ProfileZone::Count)> ZONE_NAMES = {
+    "events", "update", "simulation", "render", "walls", "items", "snake", "display"};
+// nested zones are indented under the zone that contains them
+constexpr std::array<bool, static_cast<size_t>(ProfileZone::Count)> ZONE_NESTED = {
+    false, false, true, false, true, true, true, false};
+
+constexpr unsigned int FONT_SIZE = 14;
+constexpr float PADDING = 8.0f;
+constexpr float GRAPH_HEIGHT = 60.0f;
+constexpr float TARGET_FRAME_MILLISECONDS = 1000.0f / 60.0f;
+
+struct ZoneStats {
+  float min = 0.0f;
+  float avg = 0.0f;
+  float p99 = 0.0f;
+};
+
+ZoneStats computeStats(const std::array<float, FrameProfiler::HISTORY_FRAMES>& history, size_t size) {
+  ZoneStats stats;
+  if (size == 0) {
+    return stats;
+  }
+
+  std::array<float, FrameProfiler::HISTORY_FRAMES> sorted{};
+  std::copy_n(history.begin(), size, sorted.begin());
+  const size_t p99Index = (size * 99 + 99) / 100 - 1;
+  std::nth_element(sorted.begin(), sorted.begin() + p99Index, sorted.begin() + size);
+  stats.p99 = sorted[p99Index];
+
+  float sum = 0.0f;
+  stats.min = history[0];
+  for (size_t i = 0; i < size; ++i) {
+    stats.min = std::min(stats.min, history[i]);
+    sum += history[i];
+  }
+  stats.avg = sum / static_cast<float>(size);
+  return stats;
+}
+
+// heap allocations per frame
+struct AllocationStats {
+  float avg = 0.0f;
+  uint32_t max = 0;
+};
+
+AllocationStats computeAllocationStats(const std::array<uint32_t, FrameProfiler::HISTORY_FRAMES>& history,
+                                       size_t size) {
+  AllocationStats stats;
+  if (size == 0) {
+    return stats;
+  }
+
+  uint64_t sum = 0;
+  for (size_t i = 0; i < size; ++i) {
+    stats.max = std::max(stats.max, history[i]);
+    sum += history[i];
+  }
+  stats.avg = static_cast<float>(sum) / static_cast<float>(size);
+  return stats;
+}
+
+float toMilliseconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration<float, std::milli>(duration).count();
+}
+}  // namespace
+
+const char* FrameProfiler::getZoneName(ProfileZone zone) {
+  return ZONE_NAMES[static_cast<size_t>(zone)];
+}
+
+FrameProfiler& FrameProfiler::getInstance() {
+  static FrameProfiler instance;
+  return instance;
+}
+
+void FrameProfiler::toggle() {
+  overlayVisible = !overlayVisible;
+  if (overlayVisible) {
+    font = ResourceLoader::acquireFont(FontType::DebugFont);
+  } else {
+    font.reset();
+  }
+  updateEnabled();
+}
+
+void FrameProfiler::setRecording(bool record) {
+  recording = record;
+  updateEnabled();
+}
+
+void FrameProfiler::updateEnabled() {
+  const bool wasEnabled = enabled;
+  enabled = overlayVisible || recording;
+  if (enabled && !wasEnabled) {
+    resetHistory();
+  }
+}
+
+void FrameProfiler::resetHistory() {
+  zoneTotals.fill(std::chrono::steady_clock::duration::zero());
+  zoneAllocations.fill(0);
+  lastZoneAllocations.fill(0);
+  historyCursor = 0;
+  historySize = 0;
+  drawCalls = 0;
+  textureSwitches = 0;
+  lastTexture = nullptr;
+  framesUntilRefresh = 0;
+  lastFrameEnd = std::chrono::steady_clock::now();
+}
+
+void FrameProfiler::endFrame() {
+  if (!enabled) {
+    return;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+  frameHistory[historyCursor] = toMilliseconds(now - lastFrameEnd);
+  lastFrameEnd = now;
+  for (size_t zone = 0; zone < ZONE_COUNT; ++zone) {
+    zoneHistory[zone][historyCursor] = toMilliseconds(zoneTotals[zone]);
+    allocationHistory[zone][historyCursor] =
+        static_cast<uint32_t>(std::min<uint64_t>(zoneAllocations[zone], UINT32_MAX));
+  }
+  zoneTotals.fill(std::chrono::steady_clock::duration::zero());
+  lastZoneAllocations = zoneAllocations;
+  zoneAllocations.fill(0);
+  historyCursor = (historyCursor + 1) % HISTORY_FRAMES;
+  historySize = std::min(historySize + 1, HISTORY_FRAMES);
+
+  lastDrawCalls = drawCalls;
+  lastTextureSwitches = textureSwitches;
+  drawCalls = 0;
+  textureSwitches = 0;
+  lastTexture = nullptr;
+}
+
+void FrameProfiler::refreshStatsText() {
+  char line[96];
+  statsText.clear();
+  std::snprintf(line, sizeof(line), "%-12s %6s %6s %6s ms %7s %6s\n", "zone", "min", "avg", "p99", "allocs",
+                "max");
+  statsText += line;
+  for (size_t zone = 0; zone < ZONE_COUNT; ++zone) {
+    const ZoneStats stats = computeStats(zoneHistory[zone], historySize);
+    const AllocationStats allocations = computeAllocationStats(allocationHistory[zone], historySize);
+    std::snprintf(line, sizeof(line), "%s%-*s %6.2f %6.2f %6.2f    %7.1f %6u\n", ZONE_NESTED[zone] ? " " : "",
+                  ZONE_NESTED[zone] ? 11 : 12, ZONE_NAMES[zone], stats.min, stats.avg, stats.p99, allocations.avg,
+                  allocations.max);
+    statsText += line;
+  }
+
+  const ZoneStats frame = computeStats(frameHistory, historySize);
+  std::snprintf(line, sizeof(line), "%-12s %6.2f %6.2f %6.2f  %.0f fps\n", "frame", frame.min, frame.avg, frame.p99,
+                frame.avg > 0.0f ? 1000.0f / frame.avg : 0.0f);
+  statsText += line;
+  std::snprintf(line, sizeof(line), "draws %u, texture switches %u", lastDrawCalls, lastTextureSwitches);
+  statsText += line;
+  framesUntilRefresh = STATS_REFRESH_FRAMES;
+}
+
+void FrameProfiler::render(sf::RenderTarget& target) {
+  if (!overlayVisible || !font) {
+    return;
+  }
+  if (--framesUntilRefresh <= 0) {
+    refreshStatsText();
+  }
+
+  // drawn straight to the target, so the overlay's own draws never show up in its counts
+  sf::Text text(*font, statsText, FONT_SIZE);
+  text.setFillColor(sf::Color::White);
+  text.setPosition(sf::Vector2f(PADDING * 2.0f, PADDING * 2.0f));
+
+  const sf::FloatRect textBounds = text.getGlobalBounds();
+  const float width = std::max(textBounds.size.x, static_cast<float>(HISTORY_FRAMES)) + PADDING * 2.0f;
+  const float height = textBounds.size.y + GRAPH_HEIGHT + PADDING * 4.0f;
+
+  sf::RectangleShape background(sf::Vector2f(width, height));
+  background.setPosition(sf::Vector2f(PADDING, PADDING));
+  background.setFillColor(sf::Color(0, 0, 0, 180));
+  target.draw(background);
+  target.draw(text);
+
+  renderGraph(target, sf::Vector2f(PADDING * 2.0f, textBounds.position.y + textBounds.size.y + PADDING * 2.0f),
+              sf::Vector2f(static_cast<float>(HISTORY_FRAMES), GRAPH_HEIGHT));
+}
+
+void FrameProfiler::renderGraph(sf::RenderTarget& target, sf::Vector2f position, sf::Vector2f size) const {
+  const float bottom = position.y + size.y;
+  const float pixelsPerMillisecond = size.y / GRAPH_MAX_MILLISECONDS;
+
+  sf::VertexArray lines(sf::PrimitiveType::Lines);
+  // oldest frame on the left, one pixel column per frame
+  for (size_t i = 0; i < historySize; ++i) {
+    const size_t index = (historyCursor + HISTORY_FRAMES - historySize + i) % HISTORY_FRAMES;
+    const float milliseconds = frameHistory[index];
+    const sf::Color color = milliseconds <= TARGET_FRAME_MILLISECONDS * 1.1f   ? sf::Color::Green
+                            : milliseconds <= TARGET_FRAME_MILLISECONDS * 2.1f ? sf::Color::Yellow
+                                                                                : sf::Color::Red;
+    const float x = position.x + static_cast<float>(i);
+    const float top = bottom - std::min(milliseconds, GRAPH_MAX_MILLISECONDS) * pixelsPerMillisecond;
+    lines.append(sf::Vertex{sf::Vector2f(x, bottom), color});
+    lines.append(sf::Vertex{sf::Vector2f(x, top), color});
+  }
+
+  const float targetY = bottom - TARGET_FRAME_MILLISECONDS * pixelsPerMillisecond;
+  const sf::Color guideColor(255, 255, 255, 120);
+  lines.append(sf::Vertex{sf::Vector2f(position.x, targetY), guideColor});
+  lines.append(sf::Vertex{sf::Vector2f(position.x + size.x, targetY), guideColor});
+  target.draw(lines);
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include "AllocationTracker.hpp"
+#include "ResourceManager.hpp"
+#include "TraceRecorder.hpp"
+
+enum class ProfileZone : uint8_t { Events, Update, Simulation, Render, Walls, Items, Snake, Display, Count };
+
+// Per-frame timings of the main loop, shown as an overlay toggled with F3. Zones are timed by ProfileScope
+// and summed per frame, together with the heap allocations the main thread made inside them; the last
+// HISTORY_FRAMES frames give each zone's min/avg/p99 and the frame-time graph. SFML keeps no draw
+// statistics, so draws that go through FrameProfiler::draw are counted here, with a texture switch whenever
+// a draw binds a different texture than the one before. Zones can be recorded without the overlay, which is
+// how the allocation check reads them. While neither is on, a scope or a counted draw costs one test of a
+// static flag. Zones also land in a running trace capture.
+class FrameProfiler {
+public:
+  static constexpr size_t HISTORY_FRAMES = 240;
+
+  static FrameProfiler& getInstance();
+
+  [[nodiscard]] static bool isEnabled() { return enabled; }
+  static const char* getZoneName(ProfileZone zone);
+  // shows or hides the overlay
+  void toggle();
+  // records zones while the overlay is hidden
+  void setRecording(bool record);
+
+  void addZoneSample(ProfileZone zone, std::chrono::steady_clock::duration elapsed, uint64_t allocations) {
+    zoneTotals[static_cast<size_t>(zone)] += elapsed;
+    zoneAllocations[static_cast<size_t>(zone)] += allocations;
+  }
+
+  // heap allocations made inside the zone during the last closed frame
+  [[nodiscard]] uint64_t getLastFrameAllocations(ProfileZone zone) const {
+    return lastZoneAllocations[static_cast<size_t>(zone)];
+  }
+
+  void countDraw(const sf::Texture* texture) {
+    drawCalls++;
+    if (texture != lastTexture) {
+      textureSwitches++;
+      lastTexture = texture;
+    }
+  }
+
+  template <typename T>
+  static void draw(sf::RenderTarget& target, const T& drawable,
+                   const sf::RenderStates& states = sf::RenderStates::Default) {
+    if (enabled) {
+      getInstance().countDraw(getDrawTexture(drawable, states));
+    }
+    target.draw(drawable, states);
+  }
+
+  // closes the frame: stores this frame's zone times, frame time and draw counts in the history
+  void endFrame();
+  void render(sf::RenderTarget& target);
+
+private:
+  static constexpr size_t ZONE_COUNT = static_cast<size_t>(ProfileZone::Count);
+  static constexpr int STATS_REFRESH_FRAMES = 15;
+  static constexpr float GRAPH_MAX_MILLISECONDS = 50.0f;
+
+  inline static bool enabled = false;
+  bool overlayVisible = false;
+  bool recording = false;
+
+  std::array<std::chrono::steady_clock::duration, ZONE_COUNT> zoneTotals{};
+  std::array<uint64_t, ZONE_COUNT> zoneAllocations{};
+  std::array<uint64_t, ZONE_COUNT> lastZoneAllocations{};
+  std::array<std::array<float, HISTORY_FRAMES>, ZONE_COUNT> zoneHistory{};
+  std::array<std::array<uint32_t, HISTORY_FRAMES>, ZONE_COUNT> allocationHistory{};
+  std::array<float, HISTORY_FRAMES> frameHistory{};
+  size_t historyCursor = 0;
+  size_t historySize = 0;
+  std::chrono::steady_clock::time_point lastFrameEnd;
+
+  uint32_t drawCalls = 0;
+  uint32_t textureSwitches = 0;
+  uint32_t lastDrawCalls = 0;
+  uint32_t lastTextureSwitches = 0;
+  const sf::Texture* lastTexture = nullptr;
+
+  ResourceHandle<sf::Font> font;
+  std::string statsText;
+  int framesUntilRefresh = 0;
+
+  FrameProfiler() = default;
+  FrameProfiler(const FrameProfiler&) = delete;
+  FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+  void updateEnabled();
+  void resetHistory();
+  void refreshStatsText();
+  void renderGraph(sf::RenderTarget& target, sf::Vector2f position, sf::Vector2f size) const;
+
+  static const sf::Texture* getDrawTexture(const sf::Sprite& sprite, const sf::RenderStates&) {
+    return &sprite.getTexture();
+  }
+  static const sf::Texture* getDrawTexture(const sf::Shape& shape, const sf::RenderStates&) {
+    return shape.getTexture();
+  }
+  static const sf::Texture* getDrawTexture(const sf::Text& text, const sf::RenderStates&) {
+    return &text.getFont().getTexture(text.getCharacterSize());
+  }
+  static const sf::Texture* getDrawTexture(const sf::Drawable&, const sf::RenderStates& states) {
+    return states.texture;
+  }
+};
+
+class ProfileScope {
+public:
+  explicit ProfileScope(ProfileZone zone)
+      : zone(zone), active(FrameProfiler::isEnabled() || TraceRecorder::isCapturing()) {
+    if (active) {
+      allocationsAtStart = AllocationTracker::getThreadCounts().allocations;
+      start = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ProfileScope() {
+    if (!active) {
+      return;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    if (FrameProfiler::isEnabled()) {
+      FrameProfiler::getInstance().addZoneSample(zone, end - start,
+                                                 AllocationTracker::getThreadCounts().allocations - allocationsAtStart);
+    }
+    if (TraceRecorder::isCapturing()) {
+      TraceRecorder::getInstance().recordComplete(FrameProfiler::getZoneName(zone), TraceRecorder::toTraceTime(start),
+                                                  TraceRecorder::toTraceTime(end));
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+  ProfileZone zone;
+  bool active;
+  uint64_t allocationsAtStart = 0;
+  std::chrono::steady_clock::time_point start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_ZONE(zone) const ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(ProfileZone::zone)
@@ -1,14 +1,16 @@
 #include "GameItem.hpp"
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
+#include "FrameProfiler.hpp"
+#include "GameGrid.hpp"
 #include "ResourceLoader.hpp"
+#include "GameSnapshot.hpp"
 
 GameItem::GameItem(sf::Vector2i position, float lifetime)
     : position(position),
       lifetime(lifetime),
       remainingTime(lifetime),
-      expired(false),
-      sprite(ResourceLoader::getTexture(TextureType::GreenApple)) {}
+      expired(false) {}
 
 bool GameItem::update(float deltaTime) {
   if (expired) {
@@ -24,6 +26,19 @@ bool GameItem::update(float deltaTime) {
   return true;
 }
 
+void GameItem::render(sf::RenderWindow& window, const GameGrid& grid) const {
+  if (expired)
+    return;
+
+  sf::Sprite sprite(ResourceLoader::getTexture(getTextureType()));
+  sprite.setPosition(grid.getCellPosition(position.y, position.x));
+  const auto scale = grid.getScaledCellSize() / static_cast<float>(sprite.getTexture().getSize().x);
+  sprite.setScale(sf::Vector2f(scale, scale));
+  sprite.setColor(sf::Color(255, 255, 255, getAlpha()));
+
+  FrameProfiler::draw(window, sprite);
+}
+
 bool GameItem::checkCollision(sf::Vector2i position) const {
   return this->position == position;
 }
@@ -43,3 +58,17 @@ unsigned char GameItem::getAlpha() const {
     return static_cast<unsigned char>(100 * alphaPercent);
   }
 }
+
+void GameItem::saveState(SnapshotWriter& writer) const {
+  writer.writePosition(position);
+  writer.write(lifetime);
+  writer.write(remainingTime);
+  writer.write(expired);
+}
+
+void GameItem::restoreState(SnapshotReader& reader) {
+  position = reader.readPosition();
+  lifetime = reader.read<float>();
+  remainingTime = reader.read<float>();
+  expired = reader.read<uint8_t>() != 0;
+}
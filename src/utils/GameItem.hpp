@@ -1,7 +1,13 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 
 class GameGrid;
+class SnapshotReader;
+class SnapshotWriter;
+enum class TextureType;
+
+enum class GameItemType : uint8_t { RedApple, GreenApple, WaterBubble, FantomApple };
 
 class GameItem {
 public:
@@ -11,7 +17,11 @@ public:
 
   virtual bool update(float deltaTime);
 
-  virtual void render(sf::RenderWindow& window, const GameGrid& grid) const = 0;
+  void render(sf::RenderWindow& window, const GameGrid& grid) const;
+
+  virtual GameItemType getType() const = 0;
+
+  virtual TextureType getTextureType() const = 0;
 
   unsigned char getAlpha() const;
 
@@ -31,8 +41,10 @@ public:
 
   virtual void applySpecialEffects(class Snake& snake) const = 0;
 
+  void saveState(SnapshotWriter& writer) const;
+  void restoreState(SnapshotReader& reader);
+
 protected:
-  sf::Sprite sprite;
   sf::Vector2i position;
   float lifetime;
   float remainingTime;
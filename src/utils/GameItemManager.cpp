@@ -2,19 +2,25 @@
 #include <algorithm>
 #include "../Snake.hpp"
 #include "FantomApple.hpp"
+#include "GameSnapshot.hpp"
 #include "GreenApple.hpp"
 #include "RedApple.hpp"
+#include "WallManager.hpp"
 #include "WaterBubble.hpp"
+#include "ZobristHash.hpp"
 
 class GameGrid;
 
-GameItemManager::GameItemManager(const GameGrid& grid, const DifficultySettings& difficultySettings)
+GameItemManager::GameItemManager(const GameGrid& grid, const DifficultySettings& difficultySettings,
+                                 GameRandom& random, const WallManager& wallManager,
+                                 std::pmr::memory_resource* resource)
     : grid(grid),
-      difficultySettings(difficultySettings),
-      randomGenerator(std::random_device{}()),
-      itemTypeDistribution(0, 3),
-      positionDistributionX(0, grid.getCols() - 1),
-      positionDistributionY(0, grid.getRows() - 1) {}
+      resource(resource),
+      items(resource),
+      random(random),
+      wallManager(wallManager),
+      reachableCells(grid.getCols(), grid.getRows()),
+      difficultySettings(difficultySettings) {}
 
 void GameItemManager::update(float deltaTime, const Snake& snake) {
   removeExpiredItems();
@@ -23,10 +29,11 @@ void GameItemManager::update(float deltaTime, const Snake& snake) {
     item->update(deltaTime);
   }
 
-  if (spawnTimer.getElapsedTime().asSeconds() >= difficultySettings.getItemSpawnInterval() &&
+  spawnElapsed += deltaTime;
+  if (spawnElapsed >= difficultySettings.getItemSpawnInterval() &&
       items.size() < difficultySettings.getMaxItemsOnBoard()) {
     spawnRandomItem(snake);
-    spawnTimer.restart();
+    spawnElapsed = 0.0f;
   }
 }
 
@@ -46,8 +53,7 @@ GameItem* GameItemManager::checkCollision(sf::Vector2i snakeHead) {
 }
 
 bool GameItemManager::spawnRandomItem(const Snake& snake) {
-  std::uniform_real_distribution<float> probabilityDistribution(0.0f, 1.0f);
-  float randomValue = probabilityDistribution(randomGenerator);
+  float randomValue = random.nextFloat(RandomStream::Items, 0.0f, 1.0f);
 
   GameItemType type;
   float cumulativeChance = 0.0f;
@@ -82,24 +88,16 @@ bool GameItemManager::spawnItem(GameItemManager::GameItemType itemType, const Sn
     return false;
   }
 
-  std::unique_ptr<GameItem> item;
-  switch (itemType) {
-    case GameItemType::RedApple:
-      item = std::make_unique<RedApple>(position, grid.getCols(), grid.getRows(), snake.getSpeed(),
-                                        difficultySettings.getAppleLifetimeMultiplier());
-      break;
-    case GameItemType::GreenApple:
-      item = std::make_unique<GreenApple>(position, difficultySettings.getAppleLifetimeMultiplier());
-      break;
-    case GameItemType::WaterBubble:
-      item = std::make_unique<WaterBubble>(position, difficultySettings.getAppleLifetimeMultiplier());
-      break;
-    case GameItemType::FantomApple:
-      item = std::make_unique<FantomApple>(position, difficultySettings.getAppleLifetimeMultiplier());
-      break;
+  // an item walled off from the snake could only expire
+  wallManager.computeReachable(snake.getHead(), reachableCells);
+  if (!reachableCells.test(position)) {
+    return false;
   }
 
+  ArenaPtr<GameItem> item = createItem(itemType, position, snake.getSpeed());
+
   if (item) {
+    zobristHash ^= getZobristKey(*item);
     items.push_back(std::move(item));
     return true;
   }
@@ -107,8 +105,25 @@ bool GameItemManager::spawnItem(GameItemManager::GameItemType itemType, const Sn
   return false;
 }
 
-sf::Vector2i GameItemManager::generateRandomPosition(const Snake& snake) const {
-  return sf::Vector2i(positionDistributionX(randomGenerator), positionDistributionY(randomGenerator));
+ArenaPtr<GameItem> GameItemManager::createItem(GameItemType itemType, sf::Vector2i position, float snakeSpeed) const {
+  switch (itemType) {
+    case GameItemType::RedApple:
+      return makeArenaObject<RedApple>(resource, position, grid.getCols(), grid.getRows(), snakeSpeed,
+                                       difficultySettings.getAppleLifetimeMultiplier());
+    case GameItemType::GreenApple:
+      return makeArenaObject<GreenApple>(resource, position, difficultySettings.getAppleLifetimeMultiplier());
+    case GameItemType::WaterBubble:
+      return makeArenaObject<WaterBubble>(resource, position, difficultySettings.getAppleLifetimeMultiplier());
+    case GameItemType::FantomApple:
+      return makeArenaObject<FantomApple>(resource, position, difficultySettings.getAppleLifetimeMultiplier());
+  }
+  return nullptr;
+}
+
+sf::Vector2i GameItemManager::generateRandomPosition(const Snake& snake) {
+  const int x = random.nextInt(RandomStream::Items, 0, grid.getCols() - 1);
+  const int y = random.nextInt(RandomStream::Items, 0, grid.getRows() - 1);
+  return sf::Vector2i(x, y);
 }
 
 bool GameItemManager::isValidPosition(sf::Vector2i position, const Snake& snake) const {
@@ -131,19 +146,71 @@ bool GameItemManager::isValidPosition(sf::Vector2i position, const Snake& snake)
 
 template <typename Predicate>
 void GameItemManager::removeItemsIf(Predicate predicate) {
-  items.erase(std::remove_if(items.begin(), items.end(), predicate), items.end());
+  items.erase(std::remove_if(items.begin(), items.end(),
+                             [this, &predicate](const ArenaPtr<GameItem>& item) {
+                               if (!predicate(item)) {
+                                 return false;
+                               }
+                               zobristHash ^= getZobristKey(*item);
+                               return true;
+                             }),
+              items.end());
 }
 
 void GameItemManager::removeItem(GameItem* item) {
   if (item) {
-    removeItemsIf([item](const std::unique_ptr<GameItem>& gameItem) { return gameItem.get() == item; });
+    removeItemsIf([item](const ArenaPtr<GameItem>& gameItem) { return gameItem.get() == item; });
   }
 }
 
 void GameItemManager::removeExpiredItems() {
-  removeItemsIf([](const std::unique_ptr<GameItem>& item) { return item->isExpired(); });
+  removeItemsIf([](const ArenaPtr<GameItem>& item) { return item->isExpired(); });
 }
 
 void GameItemManager::clear() {
   items.clear();
+  zobristHash = 0;
+}
+
+uint64_t GameItemManager::getZobristKey(const GameItem& item) {
+  const auto feature = static_cast<ZobristFeature>(static_cast<uint8_t>(ZobristFeature::RedApple) +
+                                                   static_cast<uint8_t>(item.getType()));
+  return zobrist::key(feature, item.getPosition());
+}
+
+uint64_t GameItemManager::computeZobristHash() const {
+  uint64_t hash = 0;
+  for (const auto& item : items) {
+    hash ^= getZobristKey(*item);
+  }
+  return hash;
+}
+
+void GameItemManager::saveState(SnapshotWriter& writer) const {
+  writer.write(spawnElapsed);
+  writer.write(static_cast<uint8_t>(items.size()));
+  for (const auto& item : items) {
+    writer.write(item->getType());
+    item->saveState(writer);
+  }
+}
+
+void GameItemManager::restoreState(SnapshotReader& reader) {
+  spawnElapsed = reader.read<float>();
+  const auto count = reader.read<uint8_t>();
+
+  items.resize(count);
+  for (auto& item : items) {
+    const auto type = reader.read<uint8_t>();
+    if (type > static_cast<uint8_t>(GameItemType::FantomApple)) {
+      reader.fail();
+      return;
+    }
+    // an item of the same kind already in this slot is overwritten in place
+    if (!item || item->getType() != static_cast<GameItemType>(type)) {
+      item = createItem(static_cast<GameItemType>(type), sf::Vector2i(0, 0), 1.0f);
+    }
+    item->restoreState(reader);
+  }
+  zobristHash = computeZobristHash();
 }
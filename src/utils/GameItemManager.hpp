@@ -1,19 +1,28 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include <memory>
-#include <random>
+#include <memory_resource>
 #include <vector>
+#include "BitGrid.hpp"
 #include "GameGrid.hpp"
 #include "GameItem.hpp"
+#include "GameRandom.hpp"
+#include "SessionArena.hpp"
 #include "difficulty/DifficultySettings.hpp"
 
 class GameGrid;
 class GameItem;
 class Snake;
+class WallManager;
+class SnapshotReader;
+class SnapshotWriter;
 
 class GameItemManager {
 public:
-  explicit GameItemManager(const GameGrid& grid, const DifficultySettings& difficultySettings);
+  // items are allocated from resource
+  explicit GameItemManager(const GameGrid& grid, const DifficultySettings& difficultySettings, GameRandom& random,
+                           const WallManager& wallManager,
+                           std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
   void update(float deltaTime, const Snake& snake);
 
@@ -21,33 +30,46 @@ public:
 
   GameItem* checkCollision(sf::Vector2i snakeHead);
 
-  enum class GameItemType { RedApple, GreenApple, WaterBubble, FantomApple };
+  using GameItemType = ::GameItemType;
 
   bool spawnRandomItem(const Snake& snake);
 
   bool spawnItem(GameItemType itemType, const Snake& snake);
 
   int getItemCount() const { return static_cast<int>(items.size()); }
+  const std::pmr::vector<ArenaPtr<GameItem>>& getItems() const { return items; }
 
   void removeItem(GameItem* item);
 
   void clear();
 
+  void saveState(SnapshotWriter& writer) const;
+  void restoreState(SnapshotReader& reader);
+
+  // updated as items spawn, get eaten and expire
+  uint64_t getZobristHash() const { return zobristHash; }
+  uint64_t computeZobristHash() const;
+
 private:
   const GameGrid& grid;
-  std::vector<std::unique_ptr<GameItem>> items;
-  mutable std::mt19937 randomGenerator;
-  mutable std::uniform_int_distribution<int> itemTypeDistribution;
-  mutable std::uniform_int_distribution<int> positionDistributionX;
-  mutable std::uniform_int_distribution<int> positionDistributionY;
+  std::pmr::memory_resource* resource;
+  std::pmr::vector<ArenaPtr<GameItem>> items;
+  uint64_t zobristHash = 0;
+  GameRandom& random;
+  const WallManager& wallManager;
+  BitGrid reachableCells;
 
   const DifficultySettings& difficultySettings;
-  sf::Clock spawnTimer;
+  float spawnElapsed = 0.0f;
 
-  sf::Vector2i generateRandomPosition(const Snake& snake) const;
+  sf::Vector2i generateRandomPosition(const Snake& snake);
+
+  ArenaPtr<GameItem> createItem(GameItemType itemType, sf::Vector2i position, float snakeSpeed) const;
 
   bool isValidPosition(sf::Vector2i position, const Snake& snake) const;
 
+  static uint64_t getZobristKey(const GameItem& item);
+
   void removeExpiredItems();
 
   template <typename Predicate>
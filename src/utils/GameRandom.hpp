@@ -0,0 +1,122 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+// xoshiro256** by Blackman and Vigna: 32 bytes of state, a handful of shifts and one multiply per
+// draw, and it passes BigCrush. Satisfies UniformRandomBitGenerator, so std algorithms accept it.
+class Xoshiro256 {
+public:
+  using result_type = uint64_t;
+  using State = std::array<uint64_t, 4>;
+
+  explicit Xoshiro256(uint64_t seed = 0) { this->seed(seed); }
+
+  // expands the seed with splitmix64, the initialisation the authors recommend
+  void seed(uint64_t value) {
+    for (auto& word : state) {
+      word = splitMix64(value);
+    }
+  }
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  result_type operator()() {
+    const uint64_t result = rotl(state[1] * 5, 7) * 9;
+    const uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+    return result;
+  }
+
+  [[nodiscard]] const State& getState() const { return state; }
+  void setState(const State& newState) { state = newState; }
+
+  static uint64_t splitMix64(uint64_t& value) {
+    uint64_t z = (value += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+private:
+  static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+  State state{};
+};
+
+// uniform in [0, range) without modulo bias (Lemire, "Fast Random Integer Generation in an Interval").
+// The multiply maps 32 random bits onto the range; only the rare low products that would over-represent
+// some values are redrawn, and the division that finds them runs only on that slow path.
+template <typename Engine>
+uint32_t boundedRandom(Engine& engine, uint32_t range) {
+  uint64_t product = static_cast<uint64_t>(static_cast<uint32_t>(engine() >> 32)) * range;
+  auto low = static_cast<uint32_t>(product);
+  if (low < range) {
+    const uint32_t threshold = (0u - range) % range;
+    while (low < threshold) {
+      product = static_cast<uint64_t>(static_cast<uint32_t>(engine() >> 32)) * range;
+      low = static_cast<uint32_t>(product);
+    }
+  }
+  return static_cast<uint32_t>(product >> 32);
+}
+
+// uniform in [0, 1) from the top 24 bits, every value exactly representable as a float
+template <typename Engine>
+float unitRandom(Engine& engine) {
+  return static_cast<float>(engine() >> 40) * (1.0f / 16777216.0f);
+}
+
+enum class RandomStream { Walls, Items, Cosmetics, Count };
+
+// All gameplay randomness of one game comes from independent streams derived from one 64-bit seed, so a
+// session can be reproduced from its seed alone. Consumers draw from their own stream only; cosmetic
+// effects that depend on the frame rate must never touch a gameplay stream.
+class GameRandom {
+public:
+  explicit GameRandom(uint64_t seed = 0) { reseed(seed); }
+
+  void reseed(uint64_t newSeed) {
+    seed = newSeed;
+    uint64_t state = newSeed;
+    for (auto& engine : engines) {
+      engine.seed(Xoshiro256::splitMix64(state));
+    }
+  }
+
+  [[nodiscard]] uint64_t getSeed() const { return seed; }
+
+  Xoshiro256& getEngine(RandomStream stream) { return engines[static_cast<size_t>(stream)]; }
+  [[nodiscard]] const Xoshiro256& getEngine(RandomStream stream) const {
+    return engines[static_cast<size_t>(stream)];
+  }
+
+  // uniform in [min, max]
+  int nextInt(RandomStream stream, int min, int max) {
+    const auto range = static_cast<uint32_t>(static_cast<int64_t>(max) - min + 1);
+    return static_cast<int>(min + static_cast<int64_t>(boundedRandom(getEngine(stream), range)));
+  }
+
+  // uniform in [min, max)
+  float nextFloat(RandomStream stream, float min, float max) {
+    return min + unitRandom(getEngine(stream)) * (max - min);
+  }
+
+  uint64_t nextSeed(RandomStream stream) { return getEngine(stream)(); }
+
+  static uint64_t generateSeed() {
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) | device();
+  }
+
+private:
+  uint64_t seed = 0;
+  std::array<Xoshiro256, static_cast<size_t>(RandomStream::Count)> engines;
+};
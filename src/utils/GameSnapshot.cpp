@@ -0,0 +1,44 @@
+#include "GameSnapshot.hpp"
+#include <filesystem>
+#include <fstream>
+#include "Logger.hpp"
+
+bool GameSnapshot::saveToFile(const std::string& path) const {
+  const std::string temporaryPath = path + ".tmp";
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      LOG_WARN("Failed to create snapshot '{}'", temporaryPath);
+      return false;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), size);
+    if (!file.flush()) {
+      LOG_WARN("Failed to write snapshot '{}'", temporaryPath);
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporaryPath, path, error);
+  if (error) {
+    LOG_WARN("Failed to replace snapshot '{}': {}", path, error.message());
+    return false;
+  }
+  return true;
+}
+
+std::optional<GameSnapshot> GameSnapshot::loadFromFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return std::nullopt;
+  }
+
+  GameSnapshot snapshot;
+  file.read(reinterpret_cast<char*>(snapshot.bytes.data()), CAPACITY);
+  snapshot.size = static_cast<uint32_t>(file.gcount());
+  if (snapshot.size == CAPACITY && file.peek() != std::ifstream::traits_type::eof()) {
+    LOG_WARN("Snapshot '{}' is larger than {} bytes", path, CAPACITY);
+    return std::nullopt;
+  }
+  return snapshot;
+}
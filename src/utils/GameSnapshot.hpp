@@ -0,0 +1,97 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+static_assert(std::endian::native == std::endian::little, "Snapshots are stored in little-endian order");
+
+// Fixed-capacity buffer holding one serialised GameSimulation. It owns no heap memory, so snapshots
+// can be kept in preallocated rings and overwritten in place; taking one is a linear copy of the state.
+struct GameSnapshot {
+  // a snake filling the whole 32x32 board is 4 KB of cells, everything else is far smaller
+  static constexpr size_t CAPACITY = 8192;
+  static constexpr uint16_t FORMAT_VERSION = 1;
+
+  uint32_t size = 0;
+  std::array<uint8_t, CAPACITY> bytes;
+
+  [[nodiscard]] uint64_t computeHash() const {
+    uint64_t hash = 14695981039346656037ull;
+    for (uint32_t i = 0; i < size; ++i) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+
+  // written to a temporary file and renamed over the target, so a crash never leaves half a save
+  bool saveToFile(const std::string& path) const;
+  static std::optional<GameSnapshot> loadFromFile(const std::string& path);
+};
+
+class SnapshotWriter {
+public:
+  explicit SnapshotWriter(GameSnapshot& snapshot) : snapshot(snapshot) { snapshot.size = 0; }
+
+  template <typename T>
+  void write(T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (snapshot.size + sizeof(T) > GameSnapshot::CAPACITY) {
+      overflow = true;
+      return;
+    }
+    std::memcpy(snapshot.bytes.data() + snapshot.size, &value, sizeof(T));
+    snapshot.size += sizeof(T);
+  }
+
+  void writePosition(sf::Vector2i position) {
+    write(static_cast<int16_t>(position.x));
+    write(static_cast<int16_t>(position.y));
+  }
+
+  [[nodiscard]] bool succeeded() const { return !overflow; }
+
+private:
+  GameSnapshot& snapshot;
+  bool overflow = false;
+};
+
+class SnapshotReader {
+public:
+  explicit SnapshotReader(const GameSnapshot& snapshot) : snapshot(snapshot) {}
+
+  // a failed read leaves value untouched and makes succeeded() false for the rest of the snapshot
+  template <typename T>
+  T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    if (offset + sizeof(T) > snapshot.size) {
+      failed = true;
+      return value;
+    }
+    std::memcpy(&value, snapshot.bytes.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+  }
+
+  sf::Vector2i readPosition() {
+    const auto x = read<int16_t>();
+    const auto y = read<int16_t>();
+    return sf::Vector2i(x, y);
+  }
+
+  void fail() { failed = true; }
+
+  [[nodiscard]] bool succeeded() const { return !failed; }
+  [[nodiscard]] bool atEnd() const { return offset == snapshot.size; }
+
+private:
+  const GameSnapshot& snapshot;
+  uint32_t offset = 0;
+  bool failed = false;
+};
@@ -1,5 +1,6 @@
 #include "GameUI.hpp"
 #include "Digits.hpp"
+#include "FrameProfiler.hpp"
 #include "ResourceLoader.hpp"
 
 GameUI::GameUI() : scale(1.0f), color(sf::Color::White), score(0), apples(0), speed(0) {
@@ -94,5 +95,5 @@ void GameUI::renderTextElement(sf::RenderTarget& target, const sf::Vector2f& pos
   textSprite.setPosition(position);
   textSprite.setScale(sf::Vector2f(scale, scale));
   textSprite.setColor(color);
-  target.draw(textSprite);
+  FrameProfiler::draw(target, textSprite);
 }
@@ -5,7 +5,8 @@ class GreenApple : public GameItem {
 public:
   GreenApple(sf::Vector2i position, float lifetimeMultiplier = 1.0f);
 
-  void render(sf::RenderWindow& window, const GameGrid& grid) const override;
+  GameItemType getType() const override { return GameItemType::GreenApple; }
+  TextureType getTextureType() const override;
   int getPoints() const override { return 10; }
   int getSpeedBonus() const override { return 5; }
   float getSpeedBonusDuration() const override { return 5.0f; }
@@ -0,0 +1,148 @@
+#include "Logger.hpp"
+#include <charconv>
+#include <cstdio>
+#include "TraceRecorder.hpp"
+
+const std::chrono::steady_clock::time_point Logger::startTime = std::chrono::steady_clock::now();
+
+namespace {
+constexpr auto IDLE_POLL_INTERVAL = std::chrono::milliseconds(2);
+
+const char* getLevelName(LogLevel level) {
+  switch (level) {
+    case LogLevel::Debug:
+      return "DEBUG";
+    case LogLevel::Info:
+      return "INFO ";
+    case LogLevel::Warn:
+      return "WARN ";
+    case LogLevel::Error:
+      return "ERROR";
+    default:
+      return "?    ";
+  }
+}
+
+void appendArg(std::string& out, const LogRecord& record, const LogArg& arg) {
+  char buffer[32];
+  std::to_chars_result result{buffer, {}};
+
+  switch (arg.type) {
+    case LogArg::Type::Int:
+      result = std::to_chars(buffer, buffer + sizeof(buffer), arg.intValue);
+      break;
+    case LogArg::Type::Unsigned:
+      result = std::to_chars(buffer, buffer + sizeof(buffer), arg.unsignedValue);
+      break;
+    case LogArg::Type::Float:
+      result = std::to_chars(buffer, buffer + sizeof(buffer), arg.floatValue, std::chars_format::fixed, 3);
+      break;
+    case LogArg::Type::Text:
+      out.append(record.text.data() + arg.text.offset, arg.text.length);
+      return;
+  }
+  out.append(buffer, result.ptr);
+}
+}  // namespace
+
+Logger& Logger::getInstance() {
+  static Logger instance;
+  return instance;
+}
+
+Logger::Logger() {
+  running.store(true, std::memory_order_release);
+  worker = std::thread(&Logger::workerLoop, this);
+}
+
+Logger::~Logger() {
+  shutdown();
+}
+
+void Logger::shutdown() {
+  if (!running.exchange(false)) {
+    return;
+  }
+  worker.join();
+
+  std::string buffer;
+  drain(buffer);
+
+  const uint64_t dropped = droppedCount.load(std::memory_order_relaxed);
+  if (dropped > 0) {
+    std::fprintf(stderr, "Logger: dropped %llu record(s) because the queue was full\n",
+                 static_cast<unsigned long long>(dropped));
+  }
+}
+
+void Logger::workerLoop() {
+  TraceRecorder::nameThread("logger");
+  std::string buffer;
+  buffer.reserve(16 * 1024);
+
+  while (running.load(std::memory_order_acquire)) {
+    if (!drain(buffer)) {
+      std::this_thread::sleep_for(IDLE_POLL_INTERVAL);
+    }
+  }
+}
+
+bool Logger::drain(std::string& buffer) {
+  bool any = false;
+  bool anyError = false;
+
+  buffer.clear();
+  while (queue.consume([&](const LogRecord& record) {
+    if (record.level >= LogLevel::Warn) {
+      // keep stdout and stderr ordered relative to each other
+      if (!buffer.empty()) {
+        std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+        std::fflush(stdout);
+        buffer.clear();
+      }
+      writeRecord(record);
+      anyError = true;
+    } else {
+      appendLine(buffer, record);
+    }
+  })) {
+    any = true;
+  }
+
+  if (!buffer.empty()) {
+    std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+    std::fflush(stdout);
+  }
+  if (anyError) {
+    std::fflush(stderr);
+  }
+  return any;
+}
+
+void Logger::writeRecord(const LogRecord& record) {
+  std::string line;
+  appendLine(line, record);
+  std::FILE* stream = record.level >= LogLevel::Warn ? stderr : stdout;
+  std::fwrite(line.data(), 1, line.size(), stream);
+}
+
+void Logger::appendLine(std::string& out, const LogRecord& record) {
+  char prefix[48];
+  const int length = std::snprintf(prefix, sizeof(prefix), "[%10.3f] %s ", record.timestampNanos / 1e9,
+                                   getLevelName(record.level));
+  out.append(prefix, static_cast<size_t>(std::max(length, 0)));
+  appendMessage(out, record);
+  out.push_back('\n');
+}
+
+void Logger::appendMessage(std::string& out, const LogRecord& record) {
+  size_t nextArg = 0;
+  for (const char* c = record.format; *c != '\0'; ++c) {
+    if (c[0] == '{' && c[1] == '}' && nextArg < record.argCount) {
+      appendArg(out, record, record.args[nextArg++]);
+      ++c;
+    } else {
+      out.push_back(*c);
+    }
+  }
+}
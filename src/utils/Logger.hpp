@@ -0,0 +1,186 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include "MpscQueue.hpp"
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_OFF 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+enum class LogLevel : uint8_t { Debug, Info, Warn, Error };
+
+// Call sites only copy a format literal and up to MAX_ARGS arguments into a fixed-size
+// record; a background thread does all formatting and I/O. Levels below LOG_LEVEL expand
+// to nothing, so their arguments are never evaluated.
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) Logger::log(LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(...) Logger::log(LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(...) Logger::log(LogLevel::Warn, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) Logger::log(LogLevel::Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+struct LogArg {
+  enum class Type : uint8_t { Int, Unsigned, Float, Text };
+
+  Type type = Type::Int;
+  union {
+    int64_t intValue;
+    uint64_t unsignedValue;
+    double floatValue;
+    struct {
+      uint16_t offset;
+      uint16_t length;
+    } text;
+  };
+};
+
+// 192 bytes, three cache lines. Strings are copied into the inline text area and truncated
+// when it runs out, so a record never points at memory owned by the caller.
+struct LogRecord {
+  static constexpr size_t MAX_ARGS = 4;
+  static constexpr size_t TEXT_CAPACITY = 104;
+
+  int64_t timestampNanos = 0;
+  const char* format = nullptr;
+  std::array<LogArg, MAX_ARGS> args{};
+  LogLevel level = LogLevel::Info;
+  uint8_t argCount = 0;
+  uint16_t textLength = 0;
+  std::array<char, TEXT_CAPACITY> text{};
+};
+
+class Logger {
+public:
+  static constexpr size_t QUEUE_CAPACITY = 4096;
+
+  static Logger& getInstance();
+
+  // format must be a string literal; "{}" marks where the next argument goes
+  template <typename... Args>
+  static void log(LogLevel level, const char* format, const Args&... args) {
+    static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "Too many log arguments");
+    getInstance().push(level, format, args...);
+  }
+
+  template <typename... Args>
+  static std::string format(const char* format, const Args&... args) {
+    LogRecord record;
+    fillRecord(record, LogLevel::Info, format, args...);
+    std::string result;
+    appendMessage(result, record);
+    return result;
+  }
+
+  void shutdown();
+
+  [[nodiscard]] uint64_t getDroppedCount() const { return droppedCount.load(std::memory_order_relaxed); }
+
+private:
+  Logger();
+  ~Logger();
+  Logger(const Logger&) = delete;
+  Logger& operator=(const Logger&) = delete;
+
+  template <typename... Args>
+  void push(LogLevel level, const char* format, const Args&... args) {
+    if (!running.load(std::memory_order_acquire)) {
+      LogRecord record;
+      fillRecord(record, level, format, args...);
+      writeRecord(record);
+      return;
+    }
+
+    const bool queued = queue.emplace([&](LogRecord& record) { fillRecord(record, level, format, args...); });
+    if (!queued) {
+      droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  template <typename... Args>
+  static void fillRecord(LogRecord& record, LogLevel level, const char* format, const Args&... args) {
+    record.timestampNanos =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count();
+    record.format = format;
+    record.level = level;
+    record.argCount = 0;
+    record.textLength = 0;
+    (addArg(record, args), ...);
+  }
+
+  template <typename T>
+  static void addArg(LogRecord& record, const T& value) {
+    LogArg& arg = record.args[record.argCount++];
+    if constexpr (std::is_same_v<T, bool>) {
+      arg.type = LogArg::Type::Text;
+      addText(record, arg, value ? "true" : "false");
+    } else if constexpr (std::is_enum_v<T>) {
+      arg.type = LogArg::Type::Int;
+      arg.intValue = static_cast<int64_t>(value);
+    } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+      arg.type = LogArg::Type::Int;
+      arg.intValue = value;
+    } else if constexpr (std::is_integral_v<T>) {
+      arg.type = LogArg::Type::Unsigned;
+      arg.unsignedValue = value;
+    } else if constexpr (std::is_floating_point_v<T>) {
+      arg.type = LogArg::Type::Float;
+      arg.floatValue = value;
+    } else {
+      arg.type = LogArg::Type::Text;
+      addText(record, arg, std::string_view(value));
+    }
+  }
+
+  static void addText(LogRecord& record, LogArg& arg, std::string_view value) {
+    const size_t length = std::min(value.size(), LogRecord::TEXT_CAPACITY - record.textLength);
+    std::memcpy(record.text.data() + record.textLength, value.data(), length);
+    arg.text.offset = record.textLength;
+    arg.text.length = static_cast<uint16_t>(length);
+    record.textLength = static_cast<uint16_t>(record.textLength + length);
+  }
+
+  static void appendMessage(std::string& out, const LogRecord& record);
+  static void appendLine(std::string& out, const LogRecord& record);
+  static void writeRecord(const LogRecord& record);
+
+  void workerLoop();
+  bool drain(std::string& buffer);
+
+  static const std::chrono::steady_clock::time_point startTime;
+
+  MpscQueue<LogRecord, QUEUE_CAPACITY> queue;
+  std::atomic<bool> running{false};
+  std::atomic<uint64_t> droppedCount{0};
+  std::thread worker;
+};
@@ -1,13 +1,8 @@
 #include "MenuSoundManager.hpp"
-#include "../config/AudioConstants.hpp"
-#include "ResourceLoader.hpp"
+#include "AudioService.hpp"
 
-MenuSoundManager::MenuSoundManager()
-    : setActiveMenuItemSound(ResourceLoader::getSound(SoundType::SetActiveMenuItem)),
-      selectMenuItemSound(ResourceLoader::getSound(SoundType::SelectMenuItem)) {
-
-  setActiveMenuItemSound.setVolume(AudioConstants::SoundEffects::MENU_NAVIGATION_VOLUME);
-  selectMenuItemSound.setVolume(AudioConstants::SoundEffects::MENU_SELECTION_VOLUME);
+MenuSoundManager::MenuSoundManager() {
+  AudioService::getInstance().preload({SoundType::SetActiveMenuItem, SoundType::SelectMenuItem});
 }
 
 void MenuSoundManager::setSoundEnabled(bool enabled) {
@@ -16,12 +11,12 @@ void MenuSoundManager::setSoundEnabled(bool enabled) {
 
 void MenuSoundManager::playNavigationSound() {
   if (soundEnabled) {
-    setActiveMenuItemSound.play();
+    AudioService::getInstance().play(SoundType::SetActiveMenuItem);
   }
 }
 
 void MenuSoundManager::playSelectionSound() {
   if (soundEnabled) {
-    selectMenuItemSound.play();
+    AudioService::getInstance().play(SoundType::SelectMenuItem);
   }
 }
@@ -1,11 +1,7 @@
 #pragma once
 
-#include <SFML/Audio.hpp>
-
 class MenuSoundManager {
 private:
-  sf::Sound setActiveMenuItemSound;
-  sf::Sound selectMenuItemSound;
   bool soundEnabled = true;
 
 public:
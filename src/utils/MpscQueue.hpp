@@ -0,0 +1,76 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for any number of producer threads and one consumer thread.
+// Every slot carries a sequence number (Vyukov's bounded queue), so producers only contend
+// on a single fetch of the enqueue position and never wait on each other's copies.
+template <typename T, size_t Capacity>
+class MpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+  MpscQueue() {
+    for (size_t i = 0; i < Capacity; ++i) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Fills the claimed slot in place, so large records are written once without a temporary.
+  template <typename Writer>
+  bool emplace(Writer&& writer) {
+    size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true) {
+      cell = &cells[position & (Capacity - 1)];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+      if (difference == 0) {
+        if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        position = enqueuePosition.load(std::memory_order_relaxed);
+      }
+    }
+
+    writer(cell->value);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool push(const T& value) {
+    return emplace([&value](T& slot) { slot = value; });
+  }
+
+  // Hands the front element to the reader without copying it out of the ring.
+  template <typename Reader>
+  bool consume(Reader&& reader) {
+    Cell& cell = cells[dequeuePosition & (Capacity - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+      return false;
+    }
+
+    reader(cell.value);
+    cell.sequence.store(dequeuePosition + Capacity, std::memory_order_release);
+    dequeuePosition++;
+    return true;
+  }
+
+  bool pop(T& value) {
+    return consume([&value](const T& slot) { value = slot; });
+  }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::array<Cell, Capacity> cells;
+  alignas(64) std::atomic<size_t> enqueuePosition{0};
+  alignas(64) size_t dequeuePosition = 0;
+};
@@ -0,0 +1,172 @@
+#include "MusicStream.hpp"
+#include <algorithm>
+#include <iostream>
+#include "../config/AudioConstants.hpp"
+#include "TraceRecorder.hpp"
+
+MusicStream::~MusicStream() {
+  stop();
+  stopDecoder();
+}
+
+bool MusicStream::openFromFile(const std::filesystem::path& filename) {
+  stop();
+  stopDecoder();
+
+  if (!file.openFromFile(filename)) {
+    std::cerr << "Failed to open music stream '" << filename.string() << "'" << std::endl;
+    return false;
+  }
+
+  channelCount = file.getChannelCount();
+  sampleRate = file.getSampleRate();
+  duration = file.getDuration();
+
+  const size_t blockSamples = static_cast<size_t>(AudioConstants::Music::DECODE_BLOCK_FRAMES) * channelCount;
+  const auto prefetchFrames = static_cast<size_t>(sampleRate * AudioConstants::Music::PREFETCH_SECONDS);
+  ring.assign(std::max(prefetchFrames * channelCount, blockSamples * 2), 0);
+  chunkBuffer.assign(static_cast<size_t>(AudioConstants::Music::CHUNK_FRAMES) * channelCount, 0);
+
+  readPos = 0;
+  writePos = 0;
+  bufferedSamples = 0;
+  endOfFile = false;
+  seekPending = false;
+  seekTarget = sf::Time::Zero;
+  consumedSinceSeek = false;
+
+  initialize(channelCount, sampleRate, file.getChannelMap());
+  startDecoder();
+  return true;
+}
+
+bool MusicStream::onGetData(Chunk& data) {
+  std::unique_lock lock(mutex);
+
+  if (bufferedSamples == 0) {
+    if (endOfFile && !seekPending) {
+      return false;
+    }
+
+    lock.unlock();
+    underrunCount.fetch_add(1, std::memory_order_relaxed);
+    std::fill(chunkBuffer.begin(), chunkBuffer.end(), 0);
+    data.samples = chunkBuffer.data();
+    data.sampleCount = chunkBuffer.size();
+    return true;
+  }
+
+  const size_t count = std::min(bufferedSamples, chunkBuffer.size());
+  const size_t firstPart = std::min(count, ring.size() - readPos);
+  std::copy_n(ring.begin() + readPos, firstPart, chunkBuffer.begin());
+  std::copy_n(ring.begin(), count - firstPart, chunkBuffer.begin() + firstPart);
+
+  readPos = (readPos + count) % ring.size();
+  bufferedSamples -= count;
+  consumedSinceSeek = true;
+  lock.unlock();
+
+  decoderWakeup.notify_one();
+
+  data.samples = chunkBuffer.data();
+  data.sampleCount = count;
+  return true;
+}
+
+void MusicStream::onSeek(sf::Time timeOffset) {
+  {
+    std::lock_guard lock(mutex);
+
+    // stop() and play() from a stopped state both seek to the start; keep what is already
+    // prefetched there instead of throwing it away and decoding it again
+    if (!consumedSinceSeek && timeOffset == seekTarget) {
+      return;
+    }
+
+    readPos = 0;
+    writePos = 0;
+    bufferedSamples = 0;
+    endOfFile = false;
+    seekPending = true;
+    seekTarget = timeOffset;
+    seekGeneration++;
+    consumedSinceSeek = false;
+  }
+  decoderWakeup.notify_one();
+}
+
+void MusicStream::startDecoder() {
+  stopRequested = false;
+  decoder = std::thread(&MusicStream::decoderLoop, this);
+}
+
+void MusicStream::stopDecoder() {
+  {
+    std::lock_guard lock(mutex);
+    stopRequested = true;
+  }
+  decoderWakeup.notify_one();
+
+  if (decoder.joinable()) {
+    decoder.join();
+  }
+}
+
+void MusicStream::decoderLoop() {
+  std::vector<std::int16_t> block(static_cast<size_t>(AudioConstants::Music::DECODE_BLOCK_FRAMES) * channelCount);
+
+  TraceRecorder::nameThread("music decoder");
+  std::unique_lock lock(mutex);
+  while (!stopRequested) {
+    if (seekPending) {
+      file.seek(seekTarget);
+      seekPending = false;
+    }
+
+    if (endOfFile || ring.size() - bufferedSamples < block.size()) {
+      decoderWakeup.wait(lock);
+      continue;
+    }
+
+    const uint64_t generation = seekGeneration;
+    lock.unlock();
+
+    const int64_t decodeStart = TraceRecorder::isCapturing() ? TraceRecorder::now() : -1;
+    size_t filled = file.read(block.data(), block.size());
+    bool reachedEnd = false;
+    while (filled < block.size()) {
+      if (!isLooping()) {
+        reachedEnd = true;
+        break;
+      }
+
+      file.seek(sf::Time::Zero);
+      const size_t read = file.read(block.data() + filled, block.size() - filled);
+      if (read == 0) {
+        reachedEnd = true;
+        break;
+      }
+      filled += read;
+    }
+    if (decodeStart >= 0 && TraceRecorder::isCapturing()) {
+      TraceRecorder::getInstance().recordComplete("decode block", decodeStart, TraceRecorder::now());
+    }
+
+    lock.lock();
+    if (generation != seekGeneration) {
+      continue;
+    }
+
+    writeToRing(block.data(), filled);
+    endOfFile = reachedEnd;
+  }
+}
+
+void MusicStream::writeToRing(const std::int16_t* samples, size_t count) {
+  const size_t firstPart = std::min(count, ring.size() - writePos);
+  std::copy_n(samples, firstPart, ring.begin() + writePos);
+  std::copy_n(samples + firstPart, count - firstPart, ring.begin());
+
+  writePos = (writePos + count) % ring.size();
+  bufferedSamples += count;
+}
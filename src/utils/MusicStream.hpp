@@ -0,0 +1,67 @@
+#pragma once
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Streams a compressed music file like sf::Music, but decoding runs on a worker thread that
+// keeps a ring buffer of PCM filled ahead of playback. onGetData only copies prefetched
+// samples, so starting playback costs no decoding. pause()/play() resume from the same
+// position without reopening or seeking the file; looping is done by the decoder so the
+// wrap-around is gapless.
+class MusicStream final : public sf::SoundStream {
+public:
+  MusicStream() = default;
+  ~MusicStream() override;
+
+  MusicStream(const MusicStream&) = delete;
+  MusicStream& operator=(const MusicStream&) = delete;
+
+  bool openFromFile(const std::filesystem::path& filename);
+
+  // Hides sf::SoundStream::setLooping: the base stream never loops, the decoder wraps instead
+  void setLooping(bool looping) { this->looping.store(looping, std::memory_order_relaxed); }
+  bool isLooping() const { return looping.load(std::memory_order_relaxed); }
+
+  sf::Time getDuration() const { return duration; }
+  size_t getPrefetchCapacityBytes() const { return ring.size() * sizeof(std::int16_t); }
+  uint64_t getUnderrunCount() const { return underrunCount.load(std::memory_order_relaxed); }
+
+protected:
+  bool onGetData(Chunk& data) override;
+  void onSeek(sf::Time timeOffset) override;
+
+private:
+  void startDecoder();
+  void stopDecoder();
+  void decoderLoop();
+  void writeToRing(const std::int16_t* samples, size_t count);
+
+  sf::InputSoundFile file;
+  sf::Time duration;
+  unsigned channelCount = 0;
+  unsigned sampleRate = 0;
+
+  std::mutex mutex;
+  std::condition_variable decoderWakeup;
+  std::vector<std::int16_t> ring;
+  size_t readPos = 0;
+  size_t writePos = 0;
+  size_t bufferedSamples = 0;
+  bool endOfFile = false;
+  bool seekPending = false;
+  sf::Time seekTarget;
+  uint64_t seekGeneration = 0;
+  bool consumedSinceSeek = false;
+  bool stopRequested = false;
+
+  std::vector<std::int16_t> chunkBuffer;
+  std::atomic<bool> looping{false};
+  std::atomic<uint64_t> underrunCount{0};
+  std::thread decoder;
+};
@@ -1,29 +1,12 @@
 #include "RedApple.hpp"
 #include "../Snake.hpp"
-#include "GameGrid.hpp"
 #include "ResourceLoader.hpp"
 
 RedApple::RedApple(sf::Vector2i position, int boardWidth, int boardHeight, float snakeSpeed, float lifetimeMultiplier)
-    : GameItem(position, calculateLifetime(boardWidth, boardHeight, snakeSpeed) * lifetimeMultiplier) {
-  sprite = sf::Sprite(ResourceLoader::getTexture(TextureType::RedApple));
+    : GameItem(position, calculateLifetime(boardWidth, boardHeight, snakeSpeed) * lifetimeMultiplier) {}
 
-  float scale = 32.0f / static_cast<float>(sprite.getTexture().getSize().x);
-  sprite.setScale(sf::Vector2f(scale, scale));
-}
-
-void RedApple::render(sf::RenderWindow& window, const GameGrid& grid) const {
-  if (expired)
-    return;
-
-  sf::Vector2f worldPos = grid.getCellPosition(position.y, position.x);
-  const_cast<sf::Sprite&>(sprite).setPosition(worldPos);
-  const auto scale = grid.getScaledCellSize() / static_cast<float>(sprite.getTexture().getSize().x);
-  const_cast<sf::Sprite&>(sprite).setScale(sf::Vector2f(scale, scale));
-
-  unsigned char alpha = getAlpha();
-  const_cast<sf::Sprite&>(sprite).setColor(sf::Color(255, 255, 255, alpha));
-
-  window.draw(sprite);
+TextureType RedApple::getTextureType() const {
+  return TextureType::RedApple;
 }
 
 void RedApple::applySpecialEffects(Snake& snake) const {
@@ -5,7 +5,8 @@ class RedApple : public GameItem {
 public:
   RedApple(sf::Vector2i position, int boardWidth, int boardHeight, float snakeSpeed, float lifetimeMultiplier = 1.0f);
 
-  void render(sf::RenderWindow& window, const GameGrid& grid) const override;
+  GameItemType getType() const override { return GameItemType::RedApple; }
+  TextureType getTextureType() const override;
   int getPoints() const override { return 50; }
   int getSpeedBonus() const override { return 1; }
   float getSpeedBonusDuration() const override { return 0.0f; }
@@ -1,9 +1,12 @@
 #include "ResourceLoader.hpp"
-#include <SFML/Audio/Music.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <deque>
+#include <filesystem>
 #include <iostream>
 #include <map>
+#include "../config/ResourceConstants.hpp"
+#include "TraceRecorder.hpp"
 
 const std::map<FontType, std::string> FONT_NAMES = {{FontType::DebugFont, "debug_font"}, {FontType::UIFont, "ui_font"}};
 const std::map<TextureType, std::string> TEXTURE_NAMES = {{TextureType::Snake, "snake"},
@@ -30,96 +33,114 @@ const std::map<SoundType, std::string> SOUND_NAMES = {{SoundType::EatApple, "eat
                                                       {SoundType::StartGame, "start_game"}};
 
 bool ResourceLoader::initializeAllResources() {
-  std::cout << "Loading all game resources..." << std::endl;
+  TRACE_SCOPE("register resources");
+  std::cout << "Registering all game resources..." << std::endl;
 
   bool success = true;
-  success &= loadTextures();
-  success &= loadFonts();
-  success &= loadSounds();
-  success &= loadMusic();
+  success &= registerTextures();
+  success &= registerFonts();
+  success &= registerSounds();
+  success &= registerMusic();
+
+  applyMemoryBudgets();
 
   if (success) {
-    std::cout << "All resources loaded successfully!" << std::endl;
+    std::cout << "All resources registered successfully!" << std::endl;
   } else {
-    std::cerr << "Some resources failed to load!" << std::endl;
+    std::cerr << "Some resources are missing!" << std::endl;
   }
 
   return success;
 }
 
-bool ResourceLoader::loadTextures() {
-  std::cout << "Loading textures..." << std::endl;
+bool ResourceLoader::registerTextures() {
+  std::cout << "Registering textures..." << std::endl;
 
   bool success = true;
-  success &= loadTexture(textureTypeToString(TextureType::Snake), "resources/Snake.png");
-  success &= loadTexture(textureTypeToString(TextureType::GreenApple), "resources/GreenApple.png");
-  success &= loadTexture(textureTypeToString(TextureType::RedApple), "resources/RedApple.png");
-  success &= loadTexture(textureTypeToString(TextureType::FantomApple), "resources/FantomApple.png");
-  success &= loadTexture(textureTypeToString(TextureType::BoardBorder), "resources/BoardBorder.png");
-  success &= loadTexture(textureTypeToString(TextureType::BoardGrid), "resources/BoardGrid.png");
-  success &= loadTexture(textureTypeToString(TextureType::Portal), "resources/Portal.png");
-  success &= loadTexture(textureTypeToString(TextureType::WaterBubble), "resources/WaterBubble.png");
-  success &= loadTexture(textureTypeToString(TextureType::Wall_1), "resources/Wall_1.png");
-  success &= loadTexture(textureTypeToString(TextureType::Wall_2), "resources/Wall_2.png");
-  success &= loadTexture(textureTypeToString(TextureType::Wall_3), "resources/Wall_3.png");
-  success &= loadTexture(textureTypeToString(TextureType::Wall_4), "resources/Wall_4.png");
-
-  success &= loadTexture(textureTypeToString(TextureType::GameUI), "resources/GameUI.png");
-  success &= loadTexture(textureTypeToString(TextureType::Digits), "resources/Digits.png");
-  success &= loadTexture(textureTypeToString(TextureType::GameIcon), "resources/GameIcon.png");
+  success &= registerTexture(textureTypeToString(TextureType::Snake), "resources/Snake.png");
+  success &= registerTexture(textureTypeToString(TextureType::GreenApple), "resources/GreenApple.png");
+  success &= registerTexture(textureTypeToString(TextureType::RedApple), "resources/RedApple.png");
+  success &= registerTexture(textureTypeToString(TextureType::FantomApple), "resources/FantomApple.png");
+  success &= registerTexture(textureTypeToString(TextureType::BoardBorder), "resources/BoardBorder.png");
+  success &= registerTexture(textureTypeToString(TextureType::BoardGrid), "resources/BoardGrid.png");
+  success &= registerTexture(textureTypeToString(TextureType::Portal), "resources/Portal.png");
+  success &= registerTexture(textureTypeToString(TextureType::WaterBubble), "resources/WaterBubble.png");
+  success &= registerTexture(textureTypeToString(TextureType::Wall_1), "resources/Wall_1.png");
+  success &= registerTexture(textureTypeToString(TextureType::Wall_2), "resources/Wall_2.png");
+  success &= registerTexture(textureTypeToString(TextureType::Wall_3), "resources/Wall_3.png");
+  success &= registerTexture(textureTypeToString(TextureType::Wall_4), "resources/Wall_4.png");
+
+  success &= registerTexture(textureTypeToString(TextureType::GameUI), "resources/GameUI.png");
+  success &= registerTexture(textureTypeToString(TextureType::Digits), "resources/Digits.png");
+  success &= registerTexture(textureTypeToString(TextureType::GameIcon), "resources/GameIcon.png");
 
   return success;
 }
 
-bool ResourceLoader::loadFonts() {
-  std::cout << "Loading fonts..." << std::endl;
+bool ResourceLoader::registerFonts() {
+  std::cout << "Registering fonts..." << std::endl;
 
   bool success = true;
-  success &= loadFont(fontTypeToString(FontType::DebugFont),
-                      "resources/fonts/JetBrainsMono"
-                      "/fonts/ttf/JetBrainsMono-Regular.ttf");
-  success &= loadFont(fontTypeToString(FontType::UIFont), "resources/fonts/Jersey_10/Jersey10-Regular.ttf");
+  success &= registerFont(fontTypeToString(FontType::DebugFont),
+                          "resources/fonts/JetBrainsMono"
+                          "/fonts/ttf/JetBrainsMono-Regular.ttf");
+  success &= registerFont(fontTypeToString(FontType::UIFont), "resources/fonts/Jersey_10/Jersey10-Regular.ttf");
 
   return success;
 }
 
-bool ResourceLoader::loadSounds() {
-  std::cout << "Loading sounds..." << std::endl;
+bool ResourceLoader::registerSounds() {
+  std::cout << "Registering sounds..." << std::endl;
 
   bool success = true;
-  success &= loadSound(soundTypeToString(SoundType::EatApple), "resources/sound/eat_apple.mp3");
-  success &= loadSound(soundTypeToString(SoundType::GameOver), "resources/sound/game_over.mp3");
-  success &= loadSound(soundTypeToString(SoundType::Countdown), "resources/sound/countdown.mp3");
-  success &= loadSound(soundTypeToString(SoundType::SelectMenuItem), "resources/sound/select_menu_item.mp3");
-  success &= loadSound(soundTypeToString(SoundType::SetActiveMenuItem), "resources/sound/set_active_menu_item.mp3");
-  success &= loadSound(soundTypeToString(SoundType::StartGame), "resources/sound/start_game.mp3");
+  success &= registerSound(soundTypeToString(SoundType::EatApple), "resources/sound/eat_apple.mp3");
+  success &= registerSound(soundTypeToString(SoundType::GameOver), "resources/sound/game_over.mp3");
+  success &= registerSound(soundTypeToString(SoundType::Countdown), "resources/sound/countdown.mp3");
+  success &= registerSound(soundTypeToString(SoundType::SelectMenuItem), "resources/sound/select_menu_item.mp3");
+  success &=
+      registerSound(soundTypeToString(SoundType::SetActiveMenuItem), "resources/sound/set_active_menu_item.mp3");
+  success &= registerSound(soundTypeToString(SoundType::StartGame), "resources/sound/start_game.mp3");
 
   return success;
 }
 
-bool ResourceLoader::loadMusic() {
-  std::cout << "Loading music..." << std::endl;
+bool ResourceLoader::registerMusic() {
+  std::cout << "Registering music..." << std::endl;
 
   bool success = true;
-  success &= loadMusicFile(musicTypeToString(MusicType::BackgroundMusic), "resources/sound/background_music.mp3");
+  success &= registerMusicFile(musicTypeToString(MusicType::BackgroundMusic), "resources/sound/background_music.mp3");
 
   return success;
 }
 
-bool ResourceLoader::loadTexture(const std::string& name, const std::string& path) {
-  return getTextureManager().loadResource(name, path);
+namespace {
+bool checkResourceFile(const std::string& name, const std::string& path) {
+  if (!std::filesystem::exists(path)) {
+    std::cerr << "Resource '" << name << "' is missing at '" << path << "'" << std::endl;
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+bool ResourceLoader::registerTexture(const std::string& name, const std::string& path) {
+  getTextureManager().registerResource(name, path);
+  return checkResourceFile(name, path);
 }
 
-bool ResourceLoader::loadFont(const std::string& name, const std::string& path) {
-  return getFontManager().loadResource(name, path);
+bool ResourceLoader::registerFont(const std::string& name, const std::string& path) {
+  getFontManager().registerResource(name, path);
+  return checkResourceFile(name, path);
 }
 
-bool ResourceLoader::loadSound(const std::string& name, const std::string& path) {
-  return getSoundManager().loadResource(name, path);
+bool ResourceLoader::registerSound(const std::string& name, const std::string& path) {
+  getSoundManager().registerResource(name, path);
+  return checkResourceFile(name, path);
 }
 
-bool ResourceLoader::loadMusicFile(const std::string& name, const std::string& path) {
-  return getMusicManager().loadResource(name, path);
+bool ResourceLoader::registerMusicFile(const std::string& name, const std::string& path) {
+  getMusicManager().registerResource(name, path);
+  return checkResourceFile(name, path);
 }
 
 ResourceManager<sf::Texture>& ResourceLoader::getTextureManager() {
@@ -138,19 +159,19 @@ MusicManager& ResourceLoader::getMusicManager() {
   return MusicManager::getInstance();
 }
 
-std::string ResourceLoader::fontTypeToString(const FontType fontType) {
+const std::string& ResourceLoader::fontTypeToString(const FontType fontType) {
   return FONT_NAMES.at(fontType);
 }
 
-std::string ResourceLoader::textureTypeToString(const TextureType textureType) {
+const std::string& ResourceLoader::textureTypeToString(const TextureType textureType) {
   return TEXTURE_NAMES.at(textureType);
 }
 
-std::string ResourceLoader::musicTypeToString(const MusicType musicType) {
+const std::string& ResourceLoader::musicTypeToString(const MusicType musicType) {
   return MUSIC_NAMES.at(musicType);
 }
 
-std::string ResourceLoader::soundTypeToString(const SoundType soundType) {
+const std::string& ResourceLoader::soundTypeToString(const SoundType soundType) {
   return SOUND_NAMES.at(soundType);
 }
 
@@ -162,10 +183,135 @@ const sf::Texture& ResourceLoader::getTexture(const TextureType textureType) {
   return getTextureManager().getResource(textureTypeToString(textureType));
 }
 
-sf::Music& ResourceLoader::getMusic(const MusicType musicType) {
+MusicStream& ResourceLoader::getMusic(const MusicType musicType) {
   return getMusicManager().getResource(musicTypeToString(musicType));
 }
 
 const sf::SoundBuffer& ResourceLoader::getSound(const SoundType soundType) {
   return getSoundManager().getResource(soundTypeToString(soundType));
 }
+
+ResourceHandle<sf::Texture> ResourceLoader::acquireTexture(const TextureType textureType) {
+  return getTextureManager().acquire(textureTypeToString(textureType));
+}
+
+ResourceHandle<sf::Font> ResourceLoader::acquireFont(const FontType fontType) {
+  return getFontManager().acquire(fontTypeToString(fontType));
+}
+
+ResourceHandle<sf::SoundBuffer> ResourceLoader::acquireSound(const SoundType soundType) {
+  return getSoundManager().acquire(soundTypeToString(soundType));
+}
+
+ResourceHandle<MusicStream> ResourceLoader::acquireMusic(const MusicType musicType) {
+  return getMusicManager().acquire(musicTypeToString(musicType));
+}
+
+namespace {
+enum class PrefetchKind { Texture, Font, Sound, Music };
+
+std::deque<std::pair<PrefetchKind, std::string>> prefetchQueue;
+}  // namespace
+
+void ResourceLoader::prefetch(const ResourceSet& resourceSet) {
+  for (const auto textureType : resourceSet.textures) {
+    prefetchQueue.emplace_back(PrefetchKind::Texture, textureTypeToString(textureType));
+  }
+  for (const auto fontType : resourceSet.fonts) {
+    prefetchQueue.emplace_back(PrefetchKind::Font, fontTypeToString(fontType));
+  }
+  for (const auto soundType : resourceSet.sounds) {
+    prefetchQueue.emplace_back(PrefetchKind::Sound, soundTypeToString(soundType));
+  }
+  for (const auto musicType : resourceSet.music) {
+    prefetchQueue.emplace_back(PrefetchKind::Music, musicTypeToString(musicType));
+  }
+}
+
+bool ResourceLoader::prefetchNext() {
+  while (!prefetchQueue.empty()) {
+    const auto [kind, name] = prefetchQueue.front();
+    prefetchQueue.pop_front();
+
+    switch (kind) {
+      case PrefetchKind::Texture:
+        if (!getTextureManager().hasResource(name)) {
+          return getTextureManager().loadResource(name);
+        }
+        break;
+      case PrefetchKind::Font:
+        if (!getFontManager().hasResource(name)) {
+          return getFontManager().loadResource(name);
+        }
+        break;
+      case PrefetchKind::Sound:
+        if (!getSoundManager().hasResource(name)) {
+          return getSoundManager().loadResource(name);
+        }
+        break;
+      case PrefetchKind::Music:
+        if (!getMusicManager().hasResource(name)) {
+          return getMusicManager().loadResource(name);
+        }
+        break;
+    }
+  }
+  return false;
+}
+
+void ResourceLoader::evictUnused() {
+  prefetchQueue.clear();
+
+  size_t evicted = 0;
+  evicted += getTextureManager().evictUnused();
+  evicted += getFontManager().evictUnused();
+  evicted += getSoundManager().evictUnused();
+  evicted += getMusicManager().evictUnused();
+
+  if (evicted > 0) {
+    logMemoryStats();
+  }
+}
+
+void ResourceLoader::applyMemoryBudgets() {
+  getTextureManager().setMemoryBudget(ResourceConstants::MemoryBudget::TEXTURES);
+  getFontManager().setMemoryBudget(ResourceConstants::MemoryBudget::FONTS);
+  getSoundManager().setMemoryBudget(ResourceConstants::MemoryBudget::SOUNDS);
+  getMusicManager().setMemoryBudget(ResourceConstants::MemoryBudget::MUSIC);
+}
+
+void ResourceLoader::logMemoryStats() {
+  const auto logKind = [](const char* kind, const ResourceMemoryStats& stats) {
+    std::cout << "  " << kind << ": " << stats.residentCount << "/" << stats.registeredCount << " resident, "
+              << stats.referencedCount << " referenced, " << stats.residentBytes / 1024 << " KiB (budget "
+              << stats.memoryBudget / 1024 << " KiB), " << stats.evictionCount << " evicted" << std::endl;
+  };
+
+  std::cout << "Resource memory:" << std::endl;
+  logKind("textures", getTextureManager().getMemoryStats());
+  logKind("fonts", getFontManager().getMemoryStats());
+  logKind("sounds", getSoundManager().getMemoryStats());
+  logKind("music", getMusicManager().getMemoryStats());
+}
+
+ResourceScope::ResourceScope(const ResourceSet& resourceSet) {
+  textures.reserve(resourceSet.textures.size());
+  for (const auto textureType : resourceSet.textures) {
+    textures.push_back(ResourceLoader::acquireTexture(textureType));
+  }
+
+  fonts.reserve(resourceSet.fonts.size());
+  for (const auto fontType : resourceSet.fonts) {
+    fonts.push_back(ResourceLoader::acquireFont(fontType));
+  }
+
+  sounds.reserve(resourceSet.sounds.size());
+  for (const auto soundType : resourceSet.sounds) {
+    sounds.push_back(ResourceLoader::acquireSound(soundType));
+  }
+
+  music.reserve(resourceSet.music.size());
+  for (const auto musicType : resourceSet.music) {
+    music.push_back(ResourceLoader::acquireMusic(musicType));
+  }
+}
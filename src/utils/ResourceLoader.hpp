@@ -1,5 +1,6 @@
 #pragma once
 #include <string>
+#include <vector>
 #include "ResourceManager.hpp"
 
 enum class FontType { DebugFont, UIFont };
@@ -26,17 +27,37 @@ enum class MusicType { BackgroundMusic };
 
 enum class SoundType { EatApple, GameOver, Countdown, SelectMenuItem, SetActiveMenuItem, StartGame };
 
+struct ResourceSet {
+  std::vector<TextureType> textures;
+  std::vector<FontType> fonts;
+  std::vector<SoundType> sounds;
+  std::vector<MusicType> music;
+};
+
+// Keeps every resource of a ResourceSet resident for as long as the scope lives.
+class ResourceScope {
+public:
+  ResourceScope() = default;
+  explicit ResourceScope(const ResourceSet& resourceSet);
+
+private:
+  std::vector<ResourceHandle<sf::Texture>> textures;
+  std::vector<ResourceHandle<sf::Font>> fonts;
+  std::vector<ResourceHandle<sf::SoundBuffer>> sounds;
+  std::vector<ResourceHandle<MusicStream>> music;
+};
+
 class ResourceLoader {
 public:
   static bool initializeAllResources();
 
-  static bool loadTextures();
+  static bool registerTextures();
 
-  static bool loadFonts();
+  static bool registerFonts();
 
-  static bool loadSounds();
+  static bool registerSounds();
 
-  static bool loadMusic();
+  static bool registerMusic();
 
   static TextureManager& getTextureManager();
 
@@ -50,24 +71,42 @@ public:
 
   static const sf::Texture& getTexture(const TextureType textureType);
 
-  static sf::Music& getMusic(const MusicType musicType);
+  static MusicStream& getMusic(const MusicType musicType);
 
   static const sf::SoundBuffer& getSound(const SoundType soundType);
 
+  static ResourceHandle<sf::Texture> acquireTexture(const TextureType textureType);
+
+  static ResourceHandle<sf::Font> acquireFont(const FontType fontType);
+
+  static ResourceHandle<sf::SoundBuffer> acquireSound(const SoundType soundType);
+
+  static ResourceHandle<MusicStream> acquireMusic(const MusicType musicType);
+
+  static void prefetch(const ResourceSet& resourceSet);
+
+  static bool prefetchNext();
+
+  static void evictUnused();
+
+  static void applyMemoryBudgets();
+
+  static void logMemoryStats();
+
 private:
-  static bool loadTexture(const std::string& name, const std::string& path);
+  static bool registerTexture(const std::string& name, const std::string& path);
 
-  static bool loadFont(const std::string& name, const std::string& path);
+  static bool registerFont(const std::string& name, const std::string& path);
 
-  static bool loadSound(const std::string& name, const std::string& path);
+  static bool registerSound(const std::string& name, const std::string& path);
 
-  static bool loadMusicFile(const std::string& name, const std::string& path);
+  static bool registerMusicFile(const std::string& name, const std::string& path);
 
-  static std::string fontTypeToString(const FontType fontType);
+  static const std::string& fontTypeToString(const FontType fontType);
 
-  static std::string textureTypeToString(const TextureType textureType);
+  static const std::string& textureTypeToString(const TextureType textureType);
 
-  static std::string musicTypeToString(const MusicType musicType);
+  static const std::string& musicTypeToString(const MusicType musicType);
 
-  static std::string soundTypeToString(const SoundType soundType);
+  static const std::string& soundTypeToString(const SoundType soundType);
 };
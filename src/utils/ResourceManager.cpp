@@ -1,6 +1,10 @@
 #include "ResourceManager.hpp"
+#include <algorithm>
+#include <filesystem>
 #include <iostream>
 #include <type_traits>
+#include <vector>
+#include "TraceRecorder.hpp"
 
 template <typename T>
 ResourceManager<T>& ResourceManager<T>::getInstance() {
@@ -8,6 +12,15 @@ ResourceManager<T>& ResourceManager<T>::getInstance() {
   return instance;
 }
 
+template <typename T>
+void ResourceManager<T>::registerResource(const std::string& name, const std::string& filePath) {
+  auto& entry = resources[name];
+  if (entry.resource && entry.filePath != filePath) {
+    std::cout << "Resource '" << name << "' re-registered while loaded, keeping loaded copy" << std::endl;
+  }
+  entry.filePath = filePath;
+}
+
 template <typename T>
 bool ResourceManager<T>::loadResource(const std::string& name, const std::string& filePath) {
   if (hasResource(name)) {
@@ -15,7 +28,30 @@ bool ResourceManager<T>::loadResource(const std::string& name, const std::string
     return true;
   }
 
+  registerResource(name, filePath);
+  return loadEntry(name, resources[name]);
+}
+
+template <typename T>
+bool ResourceManager<T>::loadResource(const std::string& name) {
+  auto it = resources.find(name);
+  if (it == resources.end()) {
+    std::cerr << "Resource '" << name << "' is not registered" << std::endl;
+    return false;
+  }
+
+  if (it->second.resource) {
+    return true;
+  }
+
+  return loadEntry(name, it->second);
+}
+
+template <typename T>
+bool ResourceManager<T>::loadEntry(const std::string& name, Entry& entry) {
+  TRACE_SCOPE("load resource", name);
   auto resource = std::make_unique<T>();
+  const std::string& filePath = entry.filePath;
 
   if constexpr (std::is_same_v<T, sf::Font>) {
     if (!resource->openFromFile(filePath)) {
@@ -32,64 +68,182 @@ bool ResourceManager<T>::loadResource(const std::string& name, const std::string
       std::cerr << "Failed to load resource '" << name << "' from '" << filePath << "'" << std::endl;
       return false;
     }
-  } else if constexpr (std::is_same_v<T, sf::Music>) {
+  } else if constexpr (std::is_same_v<T, MusicStream>) {
     if (!resource->openFromFile(filePath)) {
       std::cerr << "Failed to load resource '" << name << "' from '" << filePath << "'" << std::endl;
       return false;
     }
   }
 
-  resources[name] = std::move(resource);
+  entry.residentBytes = estimateResidentBytes(*resource, filePath);
+  entry.resource = std::move(resource);
+  entry.lastUse = ++useCounter;
+  residentBytes += entry.residentBytes;
+
   std::cout << "Successfully loaded resource '" << name << "' from '" << filePath << "'" << std::endl;
   return true;
 }
 
 template <typename T>
-T& ResourceManager<T>::getResource(const std::string& name) {
+typename ResourceManager<T>::Entry* ResourceManager<T>::findResident(const std::string& name) {
   auto it = resources.find(name);
   if (it == resources.end()) {
     std::cerr << "Resource '" << name << "' not found!" << std::endl;
-    assert(false && "Resource not found - use assert for critical resources");
+    return nullptr;
+  }
+
+  Entry& entry = it->second;
+  if (!entry.resource && !loadEntry(name, entry)) {
+    return nullptr;
   }
-  return *it->second;
+
+  entry.lastUse = ++useCounter;
+  return &entry;
 }
 
 template <typename T>
-const T& ResourceManager<T>::getResource(const std::string& name) const {
-  auto it = resources.find(name);
-  if (it == resources.end()) {
-    std::cerr << "Resource '" << name << "' not found!" << std::endl;
-    assert(false && "Resource not found - use assert for critical resources");
+ResourceHandle<T> ResourceManager<T>::acquire(const std::string& name) {
+  Entry* entry = findResident(name);
+  if (!entry) {
+    return {};
   }
-  return *it->second;
+  return ResourceHandle<T>(this, entry);
+}
+
+template <typename T>
+T& ResourceManager<T>::getResource(const std::string& name) {
+  Entry* entry = findResident(name);
+  assert(entry && "Resource not found - use assert for critical resources");
+  return *entry->resource;
+}
+
+template <typename T>
+const T& ResourceManager<T>::getResource(const std::string& name) const {
+  return const_cast<ResourceManager<T>*>(this)->getResource(name);
 }
 
 template <typename T>
 bool ResourceManager<T>::hasResource(const std::string& name) const {
+  auto it = resources.find(name);
+  return it != resources.end() && it->second.resource != nullptr;
+}
+
+template <typename T>
+bool ResourceManager<T>::isRegistered(const std::string& name) const {
   return resources.find(name) != resources.end();
 }
 
+template <typename T>
+void ResourceManager<T>::unloadEntry(const std::string& name, Entry& entry) {
+  residentBytes -= entry.residentBytes;
+  entry.residentBytes = 0;
+  entry.resource.reset();
+  std::cout << "Unloaded resource '" << name << "'" << std::endl;
+}
+
 template <typename T>
 void ResourceManager<T>::unloadResource(const std::string& name) {
   auto it = resources.find(name);
-  if (it != resources.end()) {
-    resources.erase(it);
-    std::cout << "Unloaded resource '" << name << "'" << std::endl;
+  if (it == resources.end() || !it->second.resource) {
+    return;
   }
+
+  if (it->second.refCount > 0) {
+    std::cerr << "Resource '" << name << "' is still referenced by " << it->second.refCount << " handle(s)"
+              << std::endl;
+    return;
+  }
+
+  unloadEntry(name, it->second);
 }
 
 template <typename T>
 void ResourceManager<T>::clear() {
-  resources.clear();
-  std::cout << "Cleared all resources" << std::endl;
+  for (auto& [name, entry] : resources) {
+    if (entry.resource && entry.refCount == 0) {
+      unloadEntry(name, entry);
+    }
+  }
+  std::cout << "Cleared all unreferenced resources" << std::endl;
 }
 
 template <typename T>
 size_t ResourceManager<T>::getResourceCount() const {
-  return resources.size();
+  return std::count_if(resources.begin(), resources.end(),
+                       [](const auto& resource) { return resource.second.resource != nullptr; });
+}
+
+template <typename T>
+size_t ResourceManager<T>::evictUnused() {
+  if (residentBytes <= memoryBudget) {
+    return 0;
+  }
+
+  std::vector<std::pair<uint64_t, const std::string*>> candidates;
+  for (const auto& [name, entry] : resources) {
+    if (entry.resource && entry.refCount == 0) {
+      candidates.emplace_back(entry.lastUse, &name);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+
+  size_t evicted = 0;
+  for (const auto& [lastUse, name] : candidates) {
+    if (residentBytes <= memoryBudget) {
+      break;
+    }
+    unloadEntry(*name, resources.at(*name));
+    evicted++;
+  }
+
+  evictionCount += evicted;
+  return evicted;
+}
+
+template <typename T>
+void ResourceManager<T>::release(Entry& entry) {
+  assert(entry.refCount > 0 && "Resource handle released more times than acquired");
+  entry.refCount--;
+  entry.lastUse = ++useCounter;
+}
+
+template <typename T>
+ResourceMemoryStats ResourceManager<T>::getMemoryStats() const {
+  ResourceMemoryStats stats;
+  stats.registeredCount = resources.size();
+  stats.residentBytes = residentBytes;
+  stats.memoryBudget = memoryBudget;
+  stats.evictionCount = evictionCount;
+
+  for (const auto& [name, entry] : resources) {
+    if (entry.resource) {
+      stats.residentCount++;
+    }
+    if (entry.refCount > 0) {
+      stats.referencedCount++;
+    }
+  }
+  return stats;
+}
+
+template <typename T>
+size_t ResourceManager<T>::estimateResidentBytes(const T& resource, const std::string& filePath) {
+  if constexpr (std::is_same_v<T, sf::Texture>) {
+    const sf::Vector2u size = resource.getSize();
+    return static_cast<size_t>(size.x) * size.y * 4;
+  } else if constexpr (std::is_same_v<T, sf::SoundBuffer>) {
+    return static_cast<size_t>(resource.getSampleCount()) * sizeof(std::int16_t);
+  } else if constexpr (std::is_same_v<T, MusicStream>) {
+    // music streams from disk, only the prefetch ring buffer is resident
+    return resource.getPrefetchCapacityBytes();
+  } else {
+    std::error_code error;
+    const auto fileSize = std::filesystem::file_size(filePath, error);
+    return error ? 0 : static_cast<size_t>(fileSize);
+  }
 }
 
 template class ResourceManager<sf::Texture>;
 template class ResourceManager<sf::Font>;
 template class ResourceManager<sf::SoundBuffer>;
-template class ResourceManager<sf::Music>;
\ No newline at end of file
+template class ResourceManager<MusicStream>;
@@ -2,21 +2,45 @@
 #include <SFML/Audio.hpp>
 #include <SFML/Graphics.hpp>
 #include <cassert>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include "MusicStream.hpp"
 
+template <typename T>
+class ResourceHandle;
+
+struct ResourceMemoryStats {
+  size_t registeredCount = 0;
+  size_t residentCount = 0;
+  size_t referencedCount = 0;
+  size_t residentBytes = 0;
+  size_t memoryBudget = 0;
+  size_t evictionCount = 0;
+};
+
+// Resources are registered by name and path up front and loaded lazily on first use.
+// Live ResourceHandles keep a resource resident; unreferenced resources stay cached
+// until evictUnused() needs to bring the manager back under its memory budget.
 template <typename T>
 class ResourceManager {
 public:
   static ResourceManager& getInstance();
 
+  void registerResource(const std::string& name, const std::string& filePath);
+
   bool loadResource(const std::string& name, const std::string& filePath);
+  bool loadResource(const std::string& name);
+
+  ResourceHandle<T> acquire(const std::string& name);
 
   T& getResource(const std::string& name);
   const T& getResource(const std::string& name) const;
 
   bool hasResource(const std::string& name) const;
+  bool isRegistered(const std::string& name) const;
 
   void unloadResource(const std::string& name);
 
@@ -24,16 +48,97 @@ public:
 
   size_t getResourceCount() const;
 
+  void setMemoryBudget(size_t bytes) { memoryBudget = bytes; }
+  size_t getMemoryBudget() const { return memoryBudget; }
+
+  size_t evictUnused();
+
+  ResourceMemoryStats getMemoryStats() const;
+
 private:
+  friend class ResourceHandle<T>;
+
+  struct Entry {
+    std::string filePath;
+    std::unique_ptr<T> resource;
+    size_t refCount = 0;
+    size_t residentBytes = 0;
+    uint64_t lastUse = 0;
+  };
+
   ResourceManager() = default;
   ~ResourceManager() = default;
   ResourceManager(const ResourceManager&) = delete;
   ResourceManager& operator=(const ResourceManager&) = delete;
 
-  std::unordered_map<std::string, std::unique_ptr<T>> resources;
+  Entry* findResident(const std::string& name);
+  bool loadEntry(const std::string& name, Entry& entry);
+  void unloadEntry(const std::string& name, Entry& entry);
+  void release(Entry& entry);
+
+  static size_t estimateResidentBytes(const T& resource, const std::string& filePath);
+
+  std::unordered_map<std::string, Entry> resources;
+  size_t memoryBudget = std::numeric_limits<size_t>::max();
+  size_t residentBytes = 0;
+  size_t evictionCount = 0;
+  uint64_t useCounter = 0;
+};
+
+template <typename T>
+class ResourceHandle {
+public:
+  ResourceHandle() = default;
+
+  ResourceHandle(const ResourceHandle& other) : manager(other.manager), entry(other.entry) {
+    if (entry) {
+      entry->refCount++;
+    }
+  }
+
+  ResourceHandle(ResourceHandle&& other) noexcept : manager(other.manager), entry(other.entry) {
+    other.manager = nullptr;
+    other.entry = nullptr;
+  }
+
+  ResourceHandle& operator=(ResourceHandle other) noexcept {
+    std::swap(manager, other.manager);
+    std::swap(entry, other.entry);
+    return *this;
+  }
+
+  ~ResourceHandle() { reset(); }
+
+  void reset() {
+    if (entry) {
+      manager->release(*entry);
+    }
+    manager = nullptr;
+    entry = nullptr;
+  }
+
+  T& get() const {
+    assert(entry && entry->resource && "Dereferencing an empty resource handle");
+    return *entry->resource;
+  }
+
+  T& operator*() const { return get(); }
+  T* operator->() const { return &get(); }
+  explicit operator bool() const { return entry != nullptr && entry->resource != nullptr; }
+
+private:
+  friend class ResourceManager<T>;
+
+  ResourceHandle(ResourceManager<T>* manager, typename ResourceManager<T>::Entry* entry)
+      : manager(manager), entry(entry) {
+    entry->refCount++;
+  }
+
+  ResourceManager<T>* manager = nullptr;
+  typename ResourceManager<T>::Entry* entry = nullptr;
 };
 
 using TextureManager = ResourceManager<sf::Texture>;
 using FontManager = ResourceManager<sf::Font>;
 using SoundBufferManager = ResourceManager<sf::SoundBuffer>;
-using MusicManager = ResourceManager<sf::Music>;
\ No newline at end of file
+using MusicManager = ResourceManager<MusicStream>;
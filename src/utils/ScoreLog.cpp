@@ -0,0 +1,220 @@
+#include "ScoreLog.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+
+namespace {
+constexpr std::array<char, 4> LOG_MAGIC = {'S', 'N', 'K', 'S'};
+constexpr size_t REPLAY_BLOCK_RECORDS = 4096;
+constexpr size_t CHECKSUM_OFFSET = 24;
+
+void writeLittleEndian(uint8_t* out, uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+uint64_t readLittleEndian(const uint8_t* in, size_t bytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < bytes; ++i) {
+    value |= static_cast<uint64_t>(in[i]) << (8 * i);
+  }
+  return value;
+}
+
+uint32_t checksum(const uint8_t* data, size_t size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+}  // namespace
+
+ScoreLog::ScoreLog(std::string filePath) : filePath(std::move(filePath)) {}
+
+bool ScoreLog::open() {
+  appendStream.close();
+  recordCount = 0;
+  corruptRecordCount = 0;
+  for (auto& heap : topScores) {
+    heap.clear();
+  }
+
+  if (!replayLog()) {
+    return false;
+  }
+
+  appendStream.open(filePath, std::ios::binary | std::ios::app);
+  if (!appendStream.is_open()) {
+    std::cerr << "Failed to open score log '" << filePath << "' for appending" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+bool ScoreLog::replayLog() {
+  std::error_code error;
+  if (!std::filesystem::exists(filePath, error)) {
+    return writeHeader();
+  }
+
+  std::ifstream file(filePath, std::ios::binary);
+  if (!file.is_open()) {
+    std::cerr << "Failed to open score log '" << filePath << "'" << std::endl;
+    return false;
+  }
+
+  std::array<uint8_t, HEADER_SIZE> header{};
+  file.read(reinterpret_cast<char*>(header.data()), HEADER_SIZE);
+  if (file.gcount() != static_cast<std::streamsize>(HEADER_SIZE)) {
+    file.close();
+    return writeHeader();
+  }
+
+  const bool magicMatches = std::equal(LOG_MAGIC.begin(), LOG_MAGIC.end(), header.begin());
+  if (!magicMatches || readLittleEndian(header.data() + 4, 2) != FORMAT_VERSION ||
+      readLittleEndian(header.data() + 6, 2) != RECORD_SIZE) {
+    file.close();
+    const std::string corruptPath = filePath + ".corrupt";
+    std::cerr << "Score log '" << filePath << "' has an unknown format, moving it to '" << corruptPath << "'"
+              << std::endl;
+    std::filesystem::rename(filePath, corruptPath, error);
+    return writeHeader();
+  }
+
+  std::vector<uint8_t> block(RECORD_SIZE * REPLAY_BLOCK_RECORDS);
+  uint64_t completeBytes = HEADER_SIZE;
+  ScoreRecord record;
+
+  while (file) {
+    file.read(reinterpret_cast<char*>(block.data()), static_cast<std::streamsize>(block.size()));
+    const auto bytesRead = static_cast<size_t>(file.gcount());
+    const size_t records = bytesRead / RECORD_SIZE;
+
+    for (size_t i = 0; i < records; ++i) {
+      if (decodeRecord(block.data() + i * RECORD_SIZE, record)) {
+        insertIntoIndex(RankedScore{record, recordCount++});
+      } else {
+        corruptRecordCount++;
+      }
+    }
+    completeBytes += records * RECORD_SIZE;
+  }
+  file.close();
+
+  const auto fileSize = std::filesystem::file_size(filePath, error);
+  if (!error && fileSize > completeBytes) {
+    std::cerr << "Score log ends with a partial record, truncating " << (fileSize - completeBytes) << " byte(s)"
+              << std::endl;
+    std::filesystem::resize_file(filePath, completeBytes, error);
+  }
+
+  if (corruptRecordCount > 0) {
+    std::cerr << "Score log: skipped " << corruptRecordCount << " corrupt record(s)" << std::endl;
+  }
+  return true;
+}
+
+bool ScoreLog::writeHeader() {
+  std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    std::cerr << "Failed to create score log '" << filePath << "'" << std::endl;
+    return false;
+  }
+
+  std::array<uint8_t, HEADER_SIZE> header{};
+  std::copy(LOG_MAGIC.begin(), LOG_MAGIC.end(), header.begin());
+  writeLittleEndian(header.data() + 4, FORMAT_VERSION, 2);
+  writeLittleEndian(header.data() + 6, RECORD_SIZE, 2);
+  file.write(reinterpret_cast<const char*>(header.data()), HEADER_SIZE);
+  return static_cast<bool>(file.flush());
+}
+
+std::optional<uint64_t> ScoreLog::append(const ScoreRecord& record) {
+  if (!appendStream.is_open()) {
+    return std::nullopt;
+  }
+
+  std::array<uint8_t, RECORD_SIZE> bytes{};
+  encodeRecord(record, bytes.data());
+  appendStream.write(reinterpret_cast<const char*>(bytes.data()), RECORD_SIZE);
+  if (!appendStream.flush()) {
+    std::cerr << "Failed to append to score log '" << filePath << "'" << std::endl;
+    appendStream.clear();
+    return std::nullopt;
+  }
+
+  const uint64_t sequence = recordCount++;
+  insertIntoIndex(RankedScore{record, sequence});
+  return sequence;
+}
+
+std::vector<RankedScore> ScoreLog::getTopScores(GameDifficultyLevel difficulty, size_t count) const {
+  std::vector<RankedScore> result = topScores[static_cast<size_t>(difficulty)];
+  std::sort(result.begin(), result.end(), ranksAbove);
+  if (result.size() > count) {
+    result.resize(count);
+  }
+  return result;
+}
+
+int64_t ScoreLog::currentTimestamp() {
+  return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+void ScoreLog::encodeRecord(const ScoreRecord& record, uint8_t* out) {
+  writeLittleEndian(out, static_cast<uint64_t>(record.timestamp), 8);
+  writeLittleEndian(out + 8, static_cast<uint32_t>(record.score), 4);
+  writeLittleEndian(out + 12, record.length, 4);
+  writeLittleEndian(out + 16, record.durationMillis, 4);
+  out[20] = static_cast<uint8_t>(record.difficulty);
+  out[21] = static_cast<uint8_t>(record.snakeType);
+  writeLittleEndian(out + 22, record.migrated ? 1 : 0, 2);
+  writeLittleEndian(out + CHECKSUM_OFFSET, checksum(out, CHECKSUM_OFFSET), 4);
+}
+
+bool ScoreLog::decodeRecord(const uint8_t* in, ScoreRecord& record) {
+  if (readLittleEndian(in + CHECKSUM_OFFSET, 4) != checksum(in, CHECKSUM_OFFSET)) {
+    return false;
+  }
+  if (in[20] >= DIFFICULTY_COUNT || in[21] > static_cast<uint8_t>(SnakeSprite::SnakeType::Black)) {
+    return false;
+  }
+
+  record.timestamp = static_cast<int64_t>(readLittleEndian(in, 8));
+  record.score = static_cast<int32_t>(readLittleEndian(in + 8, 4));
+  record.length = static_cast<uint32_t>(readLittleEndian(in + 12, 4));
+  record.durationMillis = static_cast<uint32_t>(readLittleEndian(in + 16, 4));
+  record.difficulty = static_cast<GameDifficultyLevel>(in[20]);
+  record.snakeType = static_cast<SnakeSprite::SnakeType>(in[21]);
+  record.migrated = (readLittleEndian(in + 22, 2) & 1) != 0;
+  return true;
+}
+
+bool ScoreLog::ranksAbove(const RankedScore& a, const RankedScore& b) {
+  if (a.record.score != b.record.score) {
+    return a.record.score > b.record.score;
+  }
+  return a.sequence < b.sequence;
+}
+
+void ScoreLog::insertIntoIndex(const RankedScore& rankedScore) {
+  // min-heap on rank: the front is the weakest entry still in the top K
+  auto& heap = topScores[static_cast<size_t>(rankedScore.record.difficulty)];
+
+  if (heap.size() < TOP_K) {
+    heap.push_back(rankedScore);
+    std::push_heap(heap.begin(), heap.end(), ranksAbove);
+    return;
+  }
+
+  if (ranksAbove(rankedScore, heap.front())) {
+    std::pop_heap(heap.begin(), heap.end(), ranksAbove);
+    heap.back() = rankedScore;
+    std::push_heap(heap.begin(), heap.end(), ranksAbove);
+  }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+#include "SettingStorage.hpp"
+
+struct ScoreRecord {
+  int64_t timestamp = 0;
+  int32_t score = 0;
+  uint32_t length = 0;
+  uint32_t durationMillis = 0;
+  GameDifficultyLevel difficulty = GameDifficultyLevel::Easy;
+  SnakeSprite::SnakeType snakeType = SnakeSprite::SnakeType::Purple;
+  bool migrated = false;
+};
+
+struct RankedScore {
+  ScoreRecord record;
+  uint64_t sequence = 0;
+};
+
+// Append-only binary log of every finished game. Records have a fixed size and carry their own
+// checksum, so a torn write at the end of the file is detected and cut off on the next open().
+// open() replays the log once into a bounded top-K heap per difficulty; inserts after that are
+// O(log K) and never rewrite the file.
+class ScoreLog {
+public:
+  static constexpr size_t TOP_K = 10;
+  static constexpr size_t RECORD_SIZE = 28;
+  static constexpr size_t HEADER_SIZE = 8;
+  static constexpr uint16_t FORMAT_VERSION = 1;
+
+  explicit ScoreLog(std::string filePath);
+  ~ScoreLog() = default;
+
+  ScoreLog(const ScoreLog&) = delete;
+  ScoreLog& operator=(const ScoreLog&) = delete;
+
+  bool open();
+
+  std::optional<uint64_t> append(const ScoreRecord& record);
+
+  [[nodiscard]] std::vector<RankedScore> getTopScores(GameDifficultyLevel difficulty, size_t count) const;
+
+  [[nodiscard]] uint64_t getRecordCount() const { return recordCount; }
+  [[nodiscard]] uint64_t getCorruptRecordCount() const { return corruptRecordCount; }
+
+  static int64_t currentTimestamp();
+
+  static void encodeRecord(const ScoreRecord& record, uint8_t* out);
+  static bool decodeRecord(const uint8_t* in, ScoreRecord& record);
+
+private:
+  static constexpr size_t DIFFICULTY_COUNT = static_cast<size_t>(GameDifficultyLevel::Hard) + 1;
+
+  static bool ranksAbove(const RankedScore& a, const RankedScore& b);
+  void insertIntoIndex(const RankedScore& rankedScore);
+
+  bool replayLog();
+  bool writeHeader();
+
+  std::string filePath;
+  std::ofstream appendStream;
+  uint64_t recordCount = 0;
+  uint64_t corruptRecordCount = 0;
+  std::array<std::vector<RankedScore>, DIFFICULTY_COUNT> topScores;
+};
@@ -0,0 +1,32 @@
+#include "SessionArena.hpp"
+#include <algorithm>
+
+SessionArena::SessionArena()
+    : heap(std::pmr::new_delete_resource()),
+      monotonic(initialBuffer.data(), initialBuffer.size(), &heap),
+      pool(&monotonic),
+      counted(&pool) {}
+
+SessionArenaStats SessionArena::getStats() const {
+  SessionArenaStats stats;
+  stats.liveBytes = counted.liveBytes;
+  stats.peakLiveBytes = counted.peakLiveBytes;
+  stats.reservedBytes = INITIAL_BYTES + heap.totalBytes;
+  stats.allocations = counted.allocations;
+  stats.upstreamAllocations = heap.allocations;
+  return stats;
+}
+
+void* SessionArena::CountingResource::do_allocate(size_t bytes, size_t alignment) {
+  void* memory = upstream->allocate(bytes, alignment);
+  allocations++;
+  totalBytes += bytes;
+  liveBytes += bytes;
+  peakLiveBytes = std::max(peakLiveBytes, liveBytes);
+  return memory;
+}
+
+void SessionArena::CountingResource::do_deallocate(void* memory, size_t bytes, size_t alignment) {
+  upstream->deallocate(memory, bytes, alignment);
+  liveBytes -= bytes;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+struct SessionArenaStats {
+  size_t liveBytes = 0;
+  size_t peakLiveBytes = 0;
+  // taken from the heap so far, the initial buffer included
+  size_t reservedBytes = 0;
+  uint64_t allocations = 0;
+  // times the arena itself had to go to the heap for another chunk
+  uint64_t upstreamAllocations = 0;
+};
+
+// Memory for one game session: walls, items, wall cell lists and the managers' scratch vectors. A pool
+// recycles the blocks of walls and items that expire during the game, so a long game settles into a fixed
+// footprint, and the pool draws its chunks from a monotonic buffer that starts in an inline block and only
+// grows. Nothing is returned to the heap before the arena is destroyed, which releases the whole session at
+// once. The owning screen declares the arena before the simulation, so the simulation goes first. Not
+// thread-safe; a session lives on the main thread.
+class SessionArena {
+public:
+  static constexpr size_t INITIAL_BYTES = 32 * 1024;
+
+  SessionArena();
+  SessionArena(const SessionArena&) = delete;
+  SessionArena& operator=(const SessionArena&) = delete;
+
+  [[nodiscard]] std::pmr::memory_resource* getResource() { return &counted; }
+  [[nodiscard]] SessionArenaStats getStats() const;
+
+private:
+  // counts what passes through to the resource below it
+  class CountingResource final : public std::pmr::memory_resource {
+  public:
+    explicit CountingResource(std::pmr::memory_resource* upstream) : upstream(upstream) {}
+
+    size_t liveBytes = 0;
+    size_t peakLiveBytes = 0;
+    size_t totalBytes = 0;
+    uint64_t allocations = 0;
+
+  private:
+    std::pmr::memory_resource* upstream;
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* memory, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+  };
+
+  alignas(std::max_align_t) std::array<std::byte, INITIAL_BYTES> initialBuffer;
+  CountingResource heap;
+  std::pmr::monotonic_buffer_resource monotonic;
+  std::pmr::unsynchronized_pool_resource pool;
+  CountingResource counted;
+};
+
+// Destroys an object made by makeArenaObject and hands its memory back to the resource it came from.
+// It remembers the size of the most derived type, so an ArenaPtr<GameItem> frees a RedApple correctly.
+struct ArenaDeleter {
+  std::pmr::memory_resource* resource = nullptr;
+  size_t size = 0;
+  size_t alignment = 0;
+
+  template <typename T>
+  void operator()(T* object) const {
+    object->~T();
+    resource->deallocate(object, size, alignment);
+  }
+};
+
+template <typename T>
+using ArenaPtr = std::unique_ptr<T, ArenaDeleter>;
+
+template <typename T, typename... Args>
+ArenaPtr<T> makeArenaObject(std::pmr::memory_resource* resource, Args&&... args) {
+  void* memory = resource->allocate(sizeof(T), alignof(T));
+  try {
+    return ArenaPtr<T>(new (memory) T(std::forward<Args>(args)...), ArenaDeleter{resource, sizeof(T), alignof(T)});
+  } catch (...) {
+    resource->deallocate(memory, sizeof(T), alignof(T));
+    throw;
+  }
+}
@@ -3,69 +3,80 @@
 #include <filesystem>
 #include <fstream>
 #include <functional>
-#include <iostream>
-#include <sstream>
 #include "../SnakeSprite.hpp"
+#include "Logger.hpp"
+#include "TraceRecorder.hpp"
 
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
+SettingStorage::SettingStorage() : writer(&SettingStorage::writerLoop, this) {}
+
+SettingStorage::~SettingStorage() {
+  {
+    std::lock_guard lock(writeMutex);
+    stopWriter = true;
+  }
+  writeRequested.notify_all();
+  writer.join();
+}
+
 bool SettingStorage::loadSettings() {
   try {
+    {
+      const auto writeTime = getFileWriteTime();
+      std::lock_guard lock(writeMutex);
+      knownWriteTime = writeTime;
+    }
+
     std::ifstream file(SETTINGS_FILE_PATH);
 
     if (!file.is_open()) {
-      std::cout << "Settings file not found at: " << SETTINGS_FILE_PATH << std::endl;
-      std::cout << "Current working directory: " << std::filesystem::current_path() << std::endl;
-      std::cout << "Creating default settings..." << std::endl;
+      LOG_INFO("Settings file not found at: {}, creating default settings",
+               std::filesystem::absolute(SETTINGS_FILE_PATH).string());
+      settings = GameSettings();
+      isInitialized = true;
       if (!createDefaultSettingsFile()) {
-        std::cerr << "Failed to create default settings file" << std::endl;
-        return false;
-      }
-      file.open(SETTINGS_FILE_PATH);
-      if (!file.is_open()) {
-        std::cerr << "Failed to open settings file after creation" << std::endl;
+        LOG_ERROR("Failed to create default settings file");
         return false;
       }
-    }
-
-    std::string filePath = std::filesystem::absolute(SETTINGS_FILE_PATH).string();
-    std::cout << "Settings file path: " << filePath << std::endl;
-
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    file.close();
-
-    std::string content = buffer.str();
-    std::cout << content << std::endl;
-
-    try {
-      json jsonData = json::parse(content);
-      std::cout << "JSON parsed successfully" << std::endl;
-
-      for (auto& [key, value] : jsonData.items()) {
-        std::cout << "Key: " << key << ", Type: " << value.type_name() << std::endl;
-      }
 
+      const auto writeTime = getFileWriteTime();
+      std::lock_guard lock(writeMutex);
+      knownWriteTime = writeTime;
+    } else {
       try {
-        settings.fromJson(jsonData);
+        settings.fromJson(json::parse(file));
         isInitialized = true;
-        return true;
       } catch (const json::exception& e) {
-        std::cerr << "Error in fromJson: " << e.what() << std::endl;
+        LOG_ERROR("Error parsing settings: {}", e.what());
         return false;
       }
-    } catch (const json::exception& e) {
-      std::cerr << "Error parsing JSON: " << e.what() << std::endl;
-      return false;
     }
+    return true;
   } catch (const std::exception& e) {
-    std::cerr << "Error loading settings: " << e.what() << std::endl;
+    LOG_ERROR("Error loading settings: {}", e.what());
     return false;
   }
 }
 
+bool SettingStorage::reloadIfChanged() {
+  const auto writeTime = getFileWriteTime();
+  {
+    std::lock_guard lock(writeMutex);
+    if (writePending || writeInProgress) {
+      return true;
+    }
+    if (writeTime == knownWriteTime) {
+      return true;
+    }
+  }
+
+  LOG_INFO("Settings file changed on disk, reloading");
+  return loadSettings();
+}
+
 SnakeSprite::SnakeType SettingStorage::parseSnakeType(const std::string& snakeTypeStr) {
   if (snakeTypeStr == "purple")
     return SnakeSprite::SnakeType::Purple;
@@ -78,7 +89,7 @@ SnakeSprite::SnakeType SettingStorage::parseSnakeType(const std::string& snakeTy
   if (snakeTypeStr == "black")
     return SnakeSprite::SnakeType::Black;
 
-  std::cerr << "Unknown snake type: " << snakeTypeStr << ", defaulting to purple" << std::endl;
+  LOG_WARN("Unknown snake type: {}, defaulting to purple", snakeTypeStr);
   return SnakeSprite::SnakeType::Purple;
 }
 
@@ -94,38 +105,12 @@ GameDifficultyLevel SettingStorage::parseGameDifficultyLevel(const std::string&
   if (gameDifficultyLevelStr == "hard")
     return GameDifficultyLevel::Hard;
 
-  std::cerr << "Unknown game difficulty level: " << gameDifficultyLevelStr << ", defaulting to easy" << std::endl;
+  LOG_WARN("Unknown game difficulty level: {}, defaulting to easy", gameDifficultyLevelStr);
   return GameDifficultyLevel::Easy;
 }
 
 bool SettingStorage::createDefaultSettingsFile() {
-  try {
-    std::ofstream file(SETTINGS_FILE_PATH);
-    if (!file.is_open()) {
-      std::cerr << "Failed to create settings file" << std::endl;
-      return false;
-    }
-
-    file << R"({)";
-    file << R"(    "snakeSpeed": 1,\n)";
-    file << R"(    "snakeType": "purple",\n)";
-    file << R"(    "snakeSize": 3,\n)";
-    file << R"(    "gameDifficultyLevel": "easy",\n)";
-    file << R"(    "gameMusic": true,\n)";
-    file << R"(    "gameSound": true,\n)";
-    file << R"(    "gameCountdownInSeconds": 3,\n)";
-    file << R"(    "gameRecordTable": [0]\n)";
-    file << R"(})";
-
-    file.close();
-
-    std::cout << "Default settings file created: " << SETTINGS_FILE_PATH << std::endl;
-    return true;
-
-  } catch (const std::exception& e) {
-    std::cerr << "Error creating default settings file: " << e.what() << std::endl;
-    return false;
-  }
+  return writeSettingsFile(GameSettings().toJson());
 }
 
 std::string SettingStorage::snakeTypeToString(SnakeSprite::SnakeType snakeType) {
@@ -163,8 +148,6 @@ std::string SettingStorage::gameDifficultyLevelToString(GameDifficultyLevel game
 }
 
 bool SettingStorage::addScoreToRecordTable(int score) {
-  loadSettings();
-
   if (settings.gameRecordTable.empty() || score > settings.gameRecordTable.back()) {
     settings.gameRecordTable.push_back(score);
     std::ranges::sort(settings.gameRecordTable, std::ranges::greater());
@@ -180,25 +163,86 @@ bool SettingStorage::addScoreToRecordTable(int score) {
 }
 
 bool SettingStorage::saveSettings() const {
+  {
+    std::lock_guard lock(writeMutex);
+    pendingWrite = settings.toJson();
+    writePending = true;
+  }
+  writeRequested.notify_all();
+  return true;
+}
+
+void SettingStorage::flush() const {
+  std::unique_lock lock(writeMutex);
+  writeRequested.wait(lock, [this] { return !writePending && !writeInProgress; });
+}
+
+void SettingStorage::writerLoop() {
+  TraceRecorder::nameThread("settings writer");
+  std::unique_lock lock(writeMutex);
+  while (true) {
+    writeRequested.wait(lock, [this] { return writePending || stopWriter; });
+    if (!writePending) {
+      break;
+    }
+
+    // give follow-up changes a moment to land so a burst of toggles ends up as one write
+    writeRequested.wait_for(lock, WRITE_COALESCE_DELAY, [this] { return stopWriter; });
+
+    const json snapshot = std::move(pendingWrite);
+    writePending = false;
+    writeInProgress = true;
+    lock.unlock();
+
+    const bool written = writeSettingsFile(snapshot);
+    const auto writeTime = getFileWriteTime();
+
+    lock.lock();
+    if (written) {
+      knownWriteTime = writeTime;
+    }
+    writeInProgress = false;
+    writeRequested.notify_all();
+  }
+}
+
+bool SettingStorage::writeSettingsFile(const json& settingsJson) {
+  TRACE_SCOPE("write settings");
   try {
-    std::ofstream file(SETTINGS_FILE_PATH);
-    if (!file.is_open()) {
-      std::cerr << "Failed to open settings file for writing" << std::endl;
-      return false;
+    {
+      std::ofstream file(SETTINGS_TEMP_FILE_PATH, std::ios::trunc);
+      if (!file.is_open()) {
+        LOG_ERROR("Failed to open settings file for writing");
+        return false;
+      }
+
+      file << settingsJson.dump(4);
+      if (!file.flush()) {
+        LOG_ERROR("Failed to write settings file");
+        return false;
+      }
     }
 
-    json j = settings.toJson();
-    file << j.dump(4);
-    file.close();
-    std::cout << "Settings saved successfully" << std::endl;
+    std::error_code error;
+    std::filesystem::rename(SETTINGS_TEMP_FILE_PATH, SETTINGS_FILE_PATH, error);
+    if (error) {
+      LOG_ERROR("Failed to replace settings file: {}", error.message());
+      return false;
+    }
     return true;
 
   } catch (const std::exception& e) {
-    std::cerr << "Error saving settings: " << e.what() << std::endl;
+    LOG_ERROR("Error saving settings: {}", e.what());
     return false;
   }
 }
 
+std::filesystem::file_time_type SettingStorage::getFileWriteTime() {
+  std::error_code error;
+  const auto writeTime = std::filesystem::last_write_time(SETTINGS_FILE_PATH, error);
+  return error ? std::filesystem::file_time_type::min() : writeTime;
+}
+
 json GameSettings::toJson() const {
   json j;
   j["snakeSpeed"] = snakeSpeed;
@@ -270,10 +314,10 @@ void GameSettings::fromJson(const json& j) {
       gameRecordTable = j.value("gameRecordTable", std::vector<int>{0});
     }
   } catch (const json::exception& e) {
-    std::cerr << "JSON exception in fromJson: " << e.what() << std::endl;
+    LOG_ERROR("JSON exception in fromJson: {}", e.what());
     throw;
   } catch (const std::exception& e) {
-    std::cerr << "Standard exception in fromJson: " << e.what() << std::endl;
+    LOG_ERROR("Standard exception in fromJson: {}", e.what());
     throw;
   }
 }
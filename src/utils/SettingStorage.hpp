@@ -1,7 +1,12 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <string>
+#include <thread>
 #include <vector>
 #include "../SnakeSprite.hpp"
 
@@ -23,16 +28,38 @@ struct GameSettings {
   void fromJson(const json& j);
 };
 
+// Settings live in memory once loaded. saveSettings() only hands a snapshot to a writer thread,
+// which coalesces bursts of changes and replaces the file through a temporary file + rename.
+// reloadIfChanged() rereads the file only when someone else modified it.
 class SettingStorage {
 private:
   static constexpr const char* SETTINGS_FILE_PATH = "settings.json";
+  static constexpr const char* SETTINGS_TEMP_FILE_PATH = "settings.json.tmp";
+  static constexpr std::chrono::milliseconds WRITE_COALESCE_DELAY{250};
+
   GameSettings settings;
   bool isInitialized = false;
 
+  mutable std::mutex writeMutex;
+  mutable std::condition_variable writeRequested;
+  mutable json pendingWrite;
+  mutable bool writePending = false;
+  mutable bool writeInProgress = false;
+  bool stopWriter = false;
+  std::filesystem::file_time_type knownWriteTime;
+  std::thread writer;
+
+  void writerLoop();
+  static bool writeSettingsFile(const json& settingsJson);
+  static std::filesystem::file_time_type getFileWriteTime();
+
 public:
-  SettingStorage() = default;
+  SettingStorage();
 
-  ~SettingStorage() = default;
+  ~SettingStorage();
+
+  SettingStorage(const SettingStorage&) = delete;
+  SettingStorage& operator=(const SettingStorage&) = delete;
 
   static SnakeSprite::SnakeType parseSnakeType(const std::string& snakeTypeStr);
 
@@ -42,6 +69,8 @@ public:
 
   bool loadSettings();
 
+  bool reloadIfChanged();
+
   [[nodiscard]] bool getIsInitialized() const { return isInitialized; }
 
   [[nodiscard]] int getSnakeSpeed() const { return settings.snakeSpeed; }
@@ -64,6 +93,8 @@ public:
 
   bool saveSettings() const;
 
+  void flush() const;
+
   static std::string snakeTypeToString(SnakeSprite::SnakeType snakeType);
 
   static std::string gameDifficultyLevelToString(GameDifficultyLevel gameDifficultyLevel);
@@ -0,0 +1,38 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded wait-free queue for exactly one producer thread and one consumer thread.
+template <typename T, size_t Capacity>
+class SpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+  bool push(const T& value) {
+    const size_t head = writeIndex.load(std::memory_order_relaxed);
+    if (head - readIndex.load(std::memory_order_acquire) == Capacity) {
+      return false;
+    }
+    slots[head & (Capacity - 1)] = value;
+    writeIndex.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& value) {
+    const size_t tail = readIndex.load(std::memory_order_relaxed);
+    if (tail == writeIndex.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = slots[tail & (Capacity - 1)];
+    readIndex.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const { return readIndex.load(std::memory_order_acquire) == writeIndex.load(std::memory_order_acquire); }
+
+private:
+  std::array<T, Capacity> slots{};
+  alignas(64) std::atomic<size_t> writeIndex{0};
+  alignas(64) std::atomic<size_t> readIndex{0};
+};
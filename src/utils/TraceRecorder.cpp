@@ -0,0 +1,152 @@
+#include "TraceRecorder.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include "Logger.hpp"
+#include "ScoreLog.hpp"
+
+const std::chrono::steady_clock::time_point TraceRecorder::startTime = std::chrono::steady_clock::now();
+
+namespace {
+constexpr auto DRAIN_INTERVAL = std::chrono::milliseconds(5);
+constexpr size_t FLUSH_BYTES = 64 * 1024;
+
+void appendEscaped(std::string& out, std::string_view text) {
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      out.push_back('\\');
+      out.push_back(c);
+    } else if (static_cast<unsigned char>(c) >= 0x20) {
+      out.push_back(c);
+    }
+  }
+}
+
+void appendEvent(std::string& out, const TraceEvent& event) {
+  char fields[96];
+  int length;
+  if (event.durationNanos < 0) {
+    length = std::snprintf(fields, sizeof(fields), "\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f",
+                           event.threadId, event.startNanos / 1e3);
+  } else {
+    length = std::snprintf(fields, sizeof(fields), "\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                           event.threadId, event.startNanos / 1e3, event.durationNanos / 1e3);
+  }
+
+  out += "{\"name\":\"";
+  appendEscaped(out, event.name);
+  out += "\",";
+  out.append(fields, static_cast<size_t>(std::max(length, 0)));
+  if (event.detailLength > 0) {
+    out += ",\"args\":{\"detail\":\"";
+    appendEscaped(out, std::string_view(event.detail.data(), event.detailLength));
+    out += "\"}";
+  }
+  out += "},\n";
+}
+}  // namespace
+
+TraceRecorder& TraceRecorder::getInstance() {
+  static TraceRecorder instance;
+  return instance;
+}
+
+TraceRecorder::~TraceRecorder() {
+  shutdown();
+}
+
+bool TraceRecorder::startCapture(std::chrono::milliseconds duration) {
+  if (writing.load(std::memory_order_acquire)) {
+    return false;
+  }
+  if (writer.joinable()) {
+    writer.join();
+  }
+
+  const std::string path =
+      std::string(DIRECTORY) + "/trace_" + std::to_string(ScoreLog::currentTimestamp()) + ".json";
+  const int64_t captureStart = now();
+  const int64_t captureEnd = captureStart + std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+
+  droppedCount.store(0, std::memory_order_relaxed);
+  stopRequested.store(false, std::memory_order_relaxed);
+  writing.store(true, std::memory_order_release);
+  capturing.store(true, std::memory_order_release);
+  writer = std::thread(&TraceRecorder::writerLoop, this, path, captureStart, captureEnd);
+  LOG_INFO("Capturing a {} ms trace into {}", static_cast<int64_t>(duration.count()), path);
+  return true;
+}
+
+void TraceRecorder::shutdown() {
+  stopRequested.store(true, std::memory_order_release);
+  if (writer.joinable()) {
+    writer.join();
+  }
+}
+
+void TraceRecorder::nameThread(const char* name) {
+  TraceRecorder& recorder = getInstance();
+  const uint32_t threadId = getThreadId();
+  std::lock_guard lock(recorder.threadNamesMutex);
+  recorder.threadNames.emplace_back(threadId, name);
+}
+
+uint32_t TraceRecorder::getThreadId() {
+  thread_local const uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+  return threadId;
+}
+
+void TraceRecorder::writerLoop(std::string path, int64_t captureStart, int64_t captureEnd) {
+  std::error_code error;
+  std::filesystem::create_directories(DIRECTORY, error);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+  std::string buffer;
+  buffer.reserve(FLUSH_BYTES * 2);
+  buffer += "{\"traceEvents\":[\n";
+  uint64_t eventCount = 0;
+
+  const auto drain = [&] {
+    // events queued before this capture began are leftovers of the previous one
+    while (queue.consume([&](const TraceEvent& event) {
+      if (event.startNanos >= captureStart && event.startNanos <= captureEnd) {
+        appendEvent(buffer, event);
+        eventCount++;
+      }
+    })) {
+    }
+    if (buffer.size() >= FLUSH_BYTES) {
+      file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      buffer.clear();
+    }
+  };
+
+  while (!stopRequested.load(std::memory_order_acquire) && now() < captureEnd) {
+    drain();
+    std::this_thread::sleep_for(DRAIN_INTERVAL);
+  }
+  capturing.store(false, std::memory_order_release);
+  drain();
+
+  {
+    std::lock_guard lock(threadNamesMutex);
+    for (const auto& [threadId, name] : threadNames) {
+      buffer += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(threadId) +
+                ",\"args\":{\"name\":\"";
+      appendEscaped(buffer, name);
+      buffer += "\"}},\n";
+    }
+  }
+  buffer += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"Snake Game\"}}\n";
+  buffer += "],\"displayTimeUnit\":\"ms\"}\n";
+  file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  file.close();
+
+  if (!file) {
+    LOG_WARN("Failed to write trace to {}", path);
+  } else {
+    LOG_INFO("Trace written to {}: {} events, {} dropped", path, eventCount,
+             droppedCount.load(std::memory_order_relaxed));
+  }
+  writing.store(false, std::memory_order_release);
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "MpscQueue.hpp"
+
+struct TraceEvent {
+  static constexpr size_t DETAIL_CAPACITY = 31;
+
+  int64_t startNanos = 0;
+  int64_t durationNanos = -1;  // negative for an instant event
+  const char* name = nullptr;
+  uint32_t threadId = 0;
+  uint8_t detailLength = 0;
+  std::array<char, DETAIL_CAPACITY> detail{};
+};
+
+// Captures a fixed span of timeline events into a Chrome trace-event JSON file that opens in Perfetto
+// or chrome://tracing. Any thread may record: an event is a name literal, times and a short inline detail
+// pushed into a lock-free queue, and a writer thread started with the capture formats and writes the file,
+// so the capture does not add I/O to the frames it measures. Outside a capture recording costs one test
+// of an atomic flag.
+class TraceRecorder {
+public:
+  static constexpr size_t QUEUE_CAPACITY = 16384;
+  static constexpr const char* DIRECTORY = "traces";
+
+  static TraceRecorder& getInstance();
+
+  [[nodiscard]] static bool isCapturing() { return capturing.load(std::memory_order_relaxed); }
+
+  // false while an earlier capture is still being written
+  bool startCapture(std::chrono::milliseconds duration);
+  void shutdown();
+
+  // names the calling thread in the trace; thread ids are handed out in the order threads first record
+  static void nameThread(const char* name);
+
+  static int64_t toTraceTime(std::chrono::steady_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time - startTime).count();
+  }
+  static int64_t now() { return toTraceTime(std::chrono::steady_clock::now()); }
+
+  void recordComplete(const char* name, int64_t startNanos, int64_t endNanos, std::string_view detail = {}) {
+    push(name, startNanos, endNanos - startNanos, detail);
+  }
+
+  void recordInstant(const char* name, std::string_view detail = {}) { push(name, now(), -1, detail); }
+
+private:
+  TraceRecorder() = default;
+  ~TraceRecorder();
+  TraceRecorder(const TraceRecorder&) = delete;
+  TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+  void push(const char* name, int64_t startNanos, int64_t durationNanos, std::string_view detail) {
+    const uint32_t threadId = getThreadId();
+    const bool queued = queue.emplace([&](TraceEvent& event) {
+      event.startNanos = startNanos;
+      event.durationNanos = durationNanos;
+      event.name = name;
+      event.threadId = threadId;
+      event.detailLength = static_cast<uint8_t>(std::min(detail.size(), TraceEvent::DETAIL_CAPACITY));
+      std::memcpy(event.detail.data(), detail.data(), event.detailLength);
+    });
+    if (!queued) {
+      droppedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  static uint32_t getThreadId();
+  void writerLoop(std::string path, int64_t captureStart, int64_t captureEnd);
+
+  static const std::chrono::steady_clock::time_point startTime;
+  inline static std::atomic<bool> capturing{false};
+  inline static std::atomic<uint32_t> nextThreadId{1};
+
+  MpscQueue<TraceEvent, QUEUE_CAPACITY> queue;
+  std::atomic<uint64_t> droppedCount{0};
+  std::atomic<bool> stopRequested{false};
+  std::atomic<bool> writing{false};
+  std::thread writer;
+
+  std::mutex threadNamesMutex;
+  std::vector<std::pair<uint32_t, std::string>> threadNames;
+};
+
+class TraceScope {
+public:
+  explicit TraceScope(const char* name, std::string_view detail = {})
+      : name(name), detail(detail), startNanos(TraceRecorder::isCapturing() ? TraceRecorder::now() : -1) {}
+
+  ~TraceScope() {
+    if (startNanos >= 0 && TraceRecorder::isCapturing()) {
+      TraceRecorder::getInstance().recordComplete(name, startNanos, TraceRecorder::now(), detail);
+    }
+  }
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+  const char* name;
+  std::string_view detail;
+  int64_t startNanos;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(...) const TraceScope TRACE_CONCAT(traceScope, __LINE__)(__VA_ARGS__)
@@ -1,41 +1,26 @@
 #include "Wall.hpp"
-#include <random>
+#include <algorithm>
+#include <cmath>
+#include "FrameProfiler.hpp"
 #include "GameGrid.hpp"
 #include "ResourceLoader.hpp"
+#include "GameSnapshot.hpp"
+#include "ZobristHash.hpp"
 
-Wall::Wall(const std::vector<sf::Vector2i>& positions, WallType type, const DifficultySettings* difficulty)
-    : positions(positions),
+Wall::Wall(std::span<const sf::Vector2i> positions, WallType type, float lifetime, std::pmr::memory_resource* resource)
+    : positions(positions.begin(), positions.end(), resource),
       type(type),
-      difficultySettings(difficulty),
+      lifetime(lifetime),
       expired(false),
       currentPhase(WallPhase::Appearing),
       blinking(false),
-      blinkCount(0) {
-
-  static std::random_device rd;
-  static std::mt19937 gen(rd());
-
-  float baseLifetime = 5.0f;
-  float maxLifetime = 10.0f;
-
-  if (difficultySettings) {
-    float difficultyMultiplier = 1.0f + (difficultySettings->getWallCount() * 0.5f);
-    baseLifetime *= difficultyMultiplier;
-    maxLifetime *= difficultyMultiplier;
-  }
-
-  static std::uniform_real_distribution<float> dis(baseLifetime, maxLifetime);
-  lifetime = dis(gen);
-
-  loadTexture();
-  lifetimeClock.restart();
-}
+      blinkCount(0) {}
 
 void Wall::update(float deltaTime) {
   if (expired)
     return;
 
-  float elapsedTime = lifetimeClock.getElapsedTime();
+  elapsedTime += deltaTime;
 
   if (currentPhase == WallPhase::Appearing && elapsedTime >= APPEARANCE_DURATION) {
     currentPhase = WallPhase::Active;
@@ -45,9 +30,10 @@ void Wall::update(float deltaTime) {
   }
 
   if (blinking && currentPhase == WallPhase::Disappearing) {
-    if (blinkTimer.getElapsedTime().asSeconds() >= BLINK_DURATION) {
+    blinkElapsed += deltaTime;
+    if (blinkElapsed >= BLINK_DURATION) {
       blinkCount++;
-      blinkTimer.restart();
+      blinkElapsed = 0.0f;
 
       if (blinkCount >= MAX_BLINKS) {
         expired = true;
@@ -64,29 +50,25 @@ void Wall::render(sf::RenderWindow& window, const GameGrid& grid) const {
   if (expired)
     return;
 
-  for (const auto& position : positions) {
-    sf::Sprite wallSprite(texture);
-
-    sf::Vector2f cellPosition = grid.getCellPosition(position.y, position.x);
-    sf::Vector2f centerOffset(grid.getScaledCellSize() / 2.0f, grid.getScaledCellSize() / 2.0f);
-    wallSprite.setPosition(cellPosition);
-
-    sf::Vector2u textureSize = texture.getSize();
-    float scale = grid.getScaledCellSize() / (float)textureSize.x;
+  const sf::Texture& texture = getTexture();
 
-    wallSprite.setScale(sf::Vector2f(scale, scale));
+  // every cell shares the texture, scale and colour, only the position changes
+  sf::Sprite wallSprite(texture);
+  const float scale = grid.getScaledCellSize() / static_cast<float>(texture.getSize().x);
+  wallSprite.setScale(sf::Vector2f(scale, scale));
 
-    if (currentPhase == WallPhase::Appearing) {
-      float elapsedTime = lifetimeClock.getElapsedTime();
-      float alpha = (elapsedTime / APPEARANCE_DURATION) * 255.0f;
-      wallSprite.setColor(sf::Color(255, 255, 255, static_cast<unsigned char>(alpha)));
-    } else if (blinking && currentPhase == WallPhase::Disappearing) {
-      wallSprite.setColor(getBlinkColor());
-    } else {
-      wallSprite.setColor(sf::Color::White);
-    }
+  if (currentPhase == WallPhase::Appearing) {
+    float alpha = (elapsedTime / APPEARANCE_DURATION) * 255.0f;
+    wallSprite.setColor(sf::Color(255, 255, 255, static_cast<unsigned char>(alpha)));
+  } else if (blinking && currentPhase == WallPhase::Disappearing) {
+    wallSprite.setColor(getBlinkColor());
+  } else {
+    wallSprite.setColor(sf::Color::White);
+  }
 
-    window.draw(wallSprite);
+  for (const auto& position : positions) {
+    wallSprite.setPosition(grid.getCellPosition(position.y, position.x));
+    FrameProfiler::draw(window, wallSprite);
   }
 }
 
@@ -98,7 +80,17 @@ bool Wall::canCollide() const {
   return currentPhase == WallPhase::Active;
 }
 
-void Wall::loadTexture() {
+uint64_t Wall::getZobristKey() const {
+  const auto phase = static_cast<uint8_t>(currentPhase);
+  const auto feature = static_cast<ZobristFeature>(static_cast<uint8_t>(ZobristFeature::WallAppearing) + phase);
+  uint64_t key = 0;
+  for (const auto& position : positions) {
+    key ^= zobrist::key(feature, position);
+  }
+  return key;
+}
+
+const sf::Texture& Wall::getTexture() const {
   TextureType textureType;
   switch (type) {
     case WallType::Wall_1:
@@ -115,18 +107,52 @@ void Wall::loadTexture() {
       break;
   }
 
-  const auto& textureRef = ResourceLoader::getTexture(textureType);
-  texture = textureRef;
+  return ResourceLoader::getTexture(textureType);
 }
 
 void Wall::startBlinking() {
   blinking = true;
   blinkCount = 0;
-  blinkTimer.restart();
+  blinkElapsed = 0.0f;
 }
 
 sf::Color Wall::getBlinkColor() const {
-  float time = blinkTimer.getElapsedTime().asSeconds();
-  float alpha = 128 + 127 * std::sin(time * 3.14159f * 4.0f);
+  float alpha = 128 + 127 * std::sin(blinkElapsed * 3.14159f * 4.0f);
   return sf::Color(255, 255, 255, static_cast<unsigned char>(alpha));
 }
+
+void Wall::saveState(SnapshotWriter& writer) const {
+  writer.write(static_cast<uint8_t>(positions.size()));
+  for (const auto& position : positions) {
+    writer.writePosition(position);
+  }
+  writer.write(static_cast<uint8_t>(type));
+  writer.write(static_cast<uint8_t>(currentPhase));
+  writer.write(elapsedTime);
+  writer.write(lifetime);
+  writer.write(expired);
+  writer.write(blinking);
+  writer.write(static_cast<uint8_t>(blinkCount));
+  writer.write(blinkElapsed);
+}
+
+void Wall::restoreState(SnapshotReader& reader) {
+  positions.resize(reader.read<uint8_t>());
+  for (auto& position : positions) {
+    position = reader.readPosition();
+  }
+  const auto wallType = reader.read<uint8_t>();
+  const auto phase = reader.read<uint8_t>();
+  if (wallType > static_cast<uint8_t>(WallType::Wall_4) || phase > static_cast<uint8_t>(WallPhase::Disappearing)) {
+    reader.fail();
+    return;
+  }
+  type = static_cast<WallType>(wallType);
+  currentPhase = static_cast<WallPhase>(phase);
+  elapsedTime = reader.read<float>();
+  lifetime = reader.read<float>();
+  expired = reader.read<uint8_t>() != 0;
+  blinking = reader.read<uint8_t>() != 0;
+  blinkCount = reader.read<uint8_t>();
+  blinkElapsed = reader.read<float>();
+}
@@ -1,11 +1,12 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <SFML/System/Clock.hpp>
+#include <memory_resource>
+#include <span>
 #include <vector>
-#include "PausableClock.hpp"
-#include "difficulty/DifficultySettings.hpp"
 
 class GameGrid;
+class SnapshotReader;
+class SnapshotWriter;
 
 enum class WallPhase { Appearing, Active, Disappearing };
 
@@ -13,8 +14,9 @@ class Wall {
 public:
   enum class WallType { Wall_1, Wall_2, Wall_3, Wall_4 };
 
-  explicit Wall(const std::vector<sf::Vector2i>& positions, WallType type = WallType::Wall_1,
-                const DifficultySettings* difficulty = nullptr);
+  // the cell list lives in resource, the session arena during a game
+  explicit Wall(std::span<const sf::Vector2i> positions, WallType type, float lifetime,
+                std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
   void update(float deltaTime);
   bool isExpired() const { return expired; }
@@ -22,20 +24,25 @@ public:
 
   void render(sf::RenderWindow& window, const GameGrid& grid) const;
 
-  const std::vector<sf::Vector2i>& getPositions() const { return positions; }
+  const std::pmr::vector<sf::Vector2i>& getPositions() const { return positions; }
   WallType getType() const { return type; }
 
   bool checkCollisionWithPosition(sf::Vector2i position) const;
   bool canCollide() const;
   WallPhase getCurrentPhase() const { return currentPhase; }
+  float getLifetime() const { return lifetime; }
+
+  // XOR of the Zobrist keys of its cells in the current phase
+  uint64_t getZobristKey() const;
+
+  void saveState(SnapshotWriter& writer) const;
+  void restoreState(SnapshotReader& reader);
 
 private:
-  std::vector<sf::Vector2i> positions;
+  std::pmr::vector<sf::Vector2i> positions;
   WallType type;
-  sf::Texture texture;
-  const DifficultySettings* difficultySettings;
 
-  PausableClock lifetimeClock;
+  float elapsedTime = 0.0f;
   float lifetime;
   bool expired;
 
@@ -47,9 +54,9 @@ private:
   int blinkCount;
   static constexpr int MAX_BLINKS = 3;
   static constexpr float BLINK_DURATION = 0.5f;
-  sf::Clock blinkTimer;
+  float blinkElapsed = 0.0f;
 
-  void loadTexture();
+  const sf::Texture& getTexture() const;
   void startBlinking();
   sf::Color getBlinkColor() const;
 };
@@ -1,27 +1,46 @@
 #include "WallManager.hpp"
 #include <algorithm>
 #include <cmath>
-#include <random>
 #include "../Snake.hpp"
 #include "GameGrid.hpp"
-
-WallManager::WallManager(const GameGrid& grid, const DifficultySettings& difficulty)
-    : grid(grid), difficultySettings(difficulty) {}
+#include "GameSnapshot.hpp"
+#include "ZobristHash.hpp"
+
+WallManager::WallManager(const GameGrid& grid, const DifficultySettings& difficulty, GameRandom& random,
+                         std::pmr::memory_resource* resource)
+    : grid(grid),
+      difficultySettings(difficulty),
+      random(random),
+      resource(resource),
+      walls(resource),
+      openCells(grid.getCols(), grid.getRows()),
+      reachableCells(grid.getCols(), grid.getRows()),
+      candidatePositions(resource),
+      wallPositions(resource) {
+  candidatePositions.reserve(static_cast<size_t>(grid.getRows() * grid.getCols()));
+  wallPositions.reserve(MAX_WALL_SIZE);
+}
 
 void WallManager::update(float deltaTime, const Snake& snake) {
   removeExpiredWalls();
 
   for (auto& wall : walls) {
+    const WallPhase phase = wall->getCurrentPhase();
+    const uint64_t key = wall->getZobristKey();
     wall->update(deltaTime);
+    if (wall->getCurrentPhase() != phase) {
+      zobristHash ^= key ^ wall->getZobristKey();
+    }
   }
 
   float baseInterval = 20.0f;
   float difficultyMultiplier = 1.0f + (difficultySettings.getWallCount() * 0.5f);
   float adjustedInterval = baseInterval / difficultyMultiplier;
 
-  if (wallGenerationTimer.getElapsedTime() >= adjustedInterval) {
+  wallGenerationElapsed += deltaTime;
+  if (wallGenerationElapsed >= adjustedInterval) {
     tryGenerateWall(snake);
-    wallGenerationTimer.restart();
+    wallGenerationElapsed = 0.0f;
   }
 }
 
@@ -42,17 +61,17 @@ bool WallManager::tryGenerateWall(const Snake& snake) {
     return false;
   }
 
-  auto positions = generateWallPositions(snake);
-  if (positions.empty()) {
+  if (!generateWallPositions(snake)) {
     return false;
   }
 
-  if (!isValidWallPosition(positions, snake)) {
+  if (!isValidWallPosition(wallPositions, snake)) {
     return false;
   }
 
   auto wallType = getRandomWallType();
-  walls.push_back(std::make_unique<Wall>(positions, wallType, &difficultySettings));
+  walls.push_back(makeArenaObject<Wall>(resource, wallPositions, wallType, getRandomWallLifetime(), resource));
+  zobristHash ^= walls.back()->getZobristKey();
 
   return true;
 }
@@ -72,14 +91,11 @@ float WallManager::getWallCoveragePercent() const {
   return (static_cast<float>(wallCells) / static_cast<float>(totalCells)) * 100.0f;
 }
 
-std::vector<sf::Vector2i> WallManager::generateWallPositions(const Snake& snake) const {
-  static std::random_device rd;
-  static std::mt19937 gen(rd());
-
+bool WallManager::generateWallPositions(const Snake& snake) {
   sf::Vector2i snakeHead = snake.getHead();
   Snake::Direction snakeDirection = snake.getDirection();
 
-  std::vector<sf::Vector2i> candidatePositions;
+  candidatePositions.clear();
 
   for (int row = 0; row < grid.getRows(); ++row) {
     for (int col = 0; col < grid.getCols(); ++col) {
@@ -99,16 +115,17 @@ std::vector<sf::Vector2i> WallManager::generateWallPositions(const Snake& snake)
   }
 
   if (candidatePositions.empty()) {
-    return {};
+    return false;
   }
 
-  std::uniform_int_distribution<int> posDis(0, static_cast<int>(candidatePositions.size()) - 1);
-  sf::Vector2i startPos = candidatePositions[posDis(gen)];
+  const int index = random.nextInt(RandomStream::Walls, 0, static_cast<int>(candidatePositions.size()) - 1);
+  sf::Vector2i startPos = candidatePositions[index];
 
-  return generateRandomWallShape(startPos, snake);
+  generateRandomWallShape(startPos, snake);
+  return true;
 }
 
-bool WallManager::isValidWallPosition(const std::vector<sf::Vector2i>& positions, const Snake& snake) const {
+bool WallManager::isValidWallPosition(std::span<const sf::Vector2i> positions, const Snake& snake) const {
   for (const auto& position : positions) {
     if (!grid.isValidPosition(position.y, position.x)) {
       return false;
@@ -123,7 +140,39 @@ bool WallManager::isValidWallPosition(const std::vector<sf::Vector2i>& positions
     }
   }
 
-  return true;
+  return !cutsOffBoard(positions, snake);
+}
+
+void WallManager::markOpenCells() const {
+  openCells.fill();
+  for (const auto& wall : walls) {
+    if (wall->getCurrentPhase() == WallPhase::Disappearing) {
+      continue;
+    }
+    for (const auto& position : wall->getPositions()) {
+      openCells.reset(position);
+    }
+  }
+}
+
+void WallManager::computeReachable(sf::Vector2i start, BitGrid& reachable) const {
+  markOpenCells();
+  BitGrid::floodFill(openCells, start, reachable);
+}
+
+bool WallManager::cutsOffBoard(std::span<const sf::Vector2i> positions, const Snake& snake) const {
+  markOpenCells();
+  BitGrid::floodFill(openCells, snake.getHead(), reachableCells);
+  const int regionBefore = reachableCells.count();
+
+  for (const auto& position : positions) {
+    openCells.reset(position);
+  }
+  BitGrid::floodFill(openCells, snake.getHead(), reachableCells);
+  const int regionAfter = reachableCells.count();
+
+  const int remaining = regionBefore - static_cast<int>(positions.size());
+  return static_cast<float>(remaining - regionAfter) > static_cast<float>(remaining) * MAX_CUT_OFF_SHARE;
 }
 
 bool WallManager::isPositionBehindSnake(sf::Vector2i position, const Snake& snake) const {
@@ -154,21 +203,16 @@ bool WallManager::isPositionInSnakeDirection(sf::Vector2i position, sf::Vector2i
   return false;
 }
 
-std::vector<sf::Vector2i> WallManager::generateRandomWallShape(sf::Vector2i startPos, const Snake& snake) const {
-  static std::random_device rd;
-  static std::mt19937 gen(rd());
-
-  std::vector<sf::Vector2i> wallPositions;
+void WallManager::generateRandomWallShape(sf::Vector2i startPos, const Snake& snake) {
+  wallPositions.clear();
   wallPositions.push_back(startPos);
 
   int minWallSize =
       std::min(MAX_WALL_SIZE - 1, MIN_WALL_SIZE + static_cast<int>(difficultySettings.getWallCount() / 2));
   int maxWallSize = std::max(minWallSize + 1, MAX_WALL_SIZE - static_cast<int>(difficultySettings.getWallCount() / 3));
-  std::uniform_int_distribution<int> sizeDis(minWallSize, maxWallSize);
-  int wallSize = sizeDis(gen);
+  int wallSize = random.nextInt(RandomStream::Walls, minWallSize, maxWallSize);
 
-  std::uniform_int_distribution<int> patternDis(0, 4);  // 5 different patterns
-  int pattern = patternDis(gen);
+  int pattern = random.nextInt(RandomStream::Walls, 0, 4);  // 5 different patterns
 
   sf::Vector2i currentPos = startPos;
 
@@ -204,8 +248,7 @@ std::vector<sf::Vector2i> WallManager::generateRandomWallShape(sf::Vector2i star
         }
         break;
       case 3: {
-        std::uniform_int_distribution<int> dirDis(0, 3);
-        int direction = dirDis(gen);
+        int direction = random.nextInt(RandomStream::Walls, 0, 3);
         switch (direction) {
           case 0:
             nextPos.y--;
@@ -247,8 +290,6 @@ std::vector<sf::Vector2i> WallManager::generateRandomWallShape(sf::Vector2i star
     wallPositions.push_back(nextPos);
     currentPos = nextPos;
   }
-
-  return wallPositions;
 }
 
 bool WallManager::isPositionFarFromWalls(sf::Vector2i position) const {
@@ -265,12 +306,13 @@ bool WallManager::isPositionFarFromWalls(sf::Vector2i position) const {
   return true;
 }
 
-Wall::WallType WallManager::getRandomWallType() const {
-  static std::random_device rd;
-  static std::mt19937 gen(rd());
-  static std::uniform_int_distribution<int> dis(0, 3);
+Wall::WallType WallManager::getRandomWallType() {
+  return static_cast<Wall::WallType>(random.nextInt(RandomStream::Walls, 0, 3));
+}
 
-  return static_cast<Wall::WallType>(dis(gen));
+float WallManager::getRandomWallLifetime() {
+  const float difficultyMultiplier = 1.0f + (difficultySettings.getWallCount() * 0.5f);
+  return random.nextFloat(RandomStream::Walls, 5.0f * difficultyMultiplier, 10.0f * difficultyMultiplier);
 }
 
 int WallManager::calculateTotalWallCells() const {
@@ -282,7 +324,44 @@ int WallManager::calculateTotalWallCells() const {
 }
 
 void WallManager::removeExpiredWalls() {
-  walls.erase(
-      std::remove_if(walls.begin(), walls.end(), [](const std::unique_ptr<Wall>& wall) { return wall->isExpired(); }),
-      walls.end());
-}
\ No newline at end of file
+  walls.erase(std::remove_if(walls.begin(), walls.end(),
+                             [this](const ArenaPtr<Wall>& wall) {
+                               if (!wall->isExpired()) {
+                                 return false;
+                               }
+                               zobristHash ^= wall->getZobristKey();
+                               return true;
+                             }),
+              walls.end());
+}
+
+uint64_t WallManager::computeZobristHash() const {
+  uint64_t hash = 0;
+  for (const auto& wall : walls) {
+    hash ^= wall->getZobristKey();
+  }
+  return hash;
+}
+
+void WallManager::saveState(SnapshotWriter& writer) const {
+  writer.write(wallGenerationElapsed);
+  writer.write(static_cast<uint8_t>(walls.size()));
+  for (const auto& wall : walls) {
+    wall->saveState(writer);
+  }
+}
+
+void WallManager::restoreState(SnapshotReader& reader) {
+  wallGenerationElapsed = reader.read<float>();
+  const auto count = reader.read<uint8_t>();
+
+  // walls are restored into the existing objects, so seeking back and forth does not allocate
+  walls.resize(count);
+  for (auto& wall : walls) {
+    if (!wall) {
+      wall = makeArenaObject<Wall>(resource, std::span<const sf::Vector2i>{}, Wall::WallType::Wall_1, 0.0f, resource);
+    }
+    wall->restoreState(reader);
+  }
+  zobristHash = computeZobristHash();
+}
@@ -1,18 +1,24 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <SFML/System/Clock.hpp>
 #include <memory>
+#include <memory_resource>
 #include <vector>
-#include "PausableClock.hpp"
+#include "BitGrid.hpp"
+#include "GameRandom.hpp"
+#include "SessionArena.hpp"
 #include "Wall.hpp"
 #include "difficulty/DifficultySettings.hpp"
 
 class GameGrid;
 class Snake;
+class SnapshotReader;
+class SnapshotWriter;
 
 class WallManager {
 public:
-  explicit WallManager(const GameGrid& grid, const DifficultySettings& difficulty);
+  // walls, their cells and the scratch vectors are allocated from resource
+  explicit WallManager(const GameGrid& grid, const DifficultySettings& difficulty, GameRandom& random,
+                       std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
   void update(float deltaTime, const Snake& snake);
   void render(sf::RenderWindow& window, const GameGrid& grid) const;
@@ -21,29 +27,56 @@ public:
 
   bool checkWallCollision(sf::Vector2i position) const;
 
+  // Cells reachable from start around the walls that are or will become solid. The snake's own body is
+  // treated as open, since it moves out of the way; only walls cut the board up for long.
+  void computeReachable(sf::Vector2i start, BitGrid& reachable) const;
+
   int getWallCount() const { return static_cast<int>(walls.size()); }
+  const std::pmr::vector<ArenaPtr<Wall>>& getWalls() const { return walls; }
   float getWallCoveragePercent() const;
 
+  void saveState(SnapshotWriter& writer) const;
+  void restoreState(SnapshotReader& reader);
+
+  // updated as walls appear, change phase and expire
+  uint64_t getZobristHash() const { return zobristHash; }
+  uint64_t computeZobristHash() const;
+
 private:
   const GameGrid& grid;
   const DifficultySettings& difficultySettings;
-  std::vector<std::unique_ptr<Wall>> walls;
+  GameRandom& random;
+  std::pmr::memory_resource* resource;
+  std::pmr::vector<ArenaPtr<Wall>> walls;
+  uint64_t zobristHash = 0;
 
-  PausableClock wallGenerationTimer;
+  float wallGenerationElapsed = 0.0f;
   static constexpr float WALL_GENERATION_INTERVAL = 10.0f;
 
   static constexpr float MAX_COVERAGE_PERCENT = 5.0f;
   static constexpr int MIN_WALL_SIZE = 1;
   static constexpr int MAX_WALL_SIZE = 7;
   static constexpr int MIN_DISTANCE_BETWEEN_WALLS = 1;
+  // a new wall may take its own cells off the snake's region, plus at most this share of the rest
+  static constexpr float MAX_CUT_OFF_SHARE = 0.05f;
+
+  mutable BitGrid openCells;
+  mutable BitGrid reachableCells;
+  // scratch for placing a wall, reserved up front so trying a wall never allocates
+  std::pmr::vector<sf::Vector2i> candidatePositions;
+  std::pmr::vector<sf::Vector2i> wallPositions;
 
-  std::vector<sf::Vector2i> generateWallPositions(const Snake& snake) const;
-  std::vector<sf::Vector2i> generateRandomWallShape(sf::Vector2i startPos, const Snake& snake) const;
-  bool isValidWallPosition(const std::vector<sf::Vector2i>& positions, const Snake& snake) const;
+  // fills wallPositions, false when no cell can start a wall
+  bool generateWallPositions(const Snake& snake);
+  void generateRandomWallShape(sf::Vector2i startPos, const Snake& snake);
+  bool isValidWallPosition(std::span<const sf::Vector2i> positions, const Snake& snake) const;
   bool isPositionBehindSnake(sf::Vector2i position, const Snake& snake) const;
   bool isPositionInSnakeDirection(sf::Vector2i position, sf::Vector2i snakeHead, int direction) const;
   bool isPositionFarFromWalls(sf::Vector2i position) const;
-  Wall::WallType getRandomWallType() const;
+  bool cutsOffBoard(std::span<const sf::Vector2i> positions, const Snake& snake) const;
+  void markOpenCells() const;
+  Wall::WallType getRandomWallType();
+  float getRandomWallLifetime();
 
   int calculateTotalWallCells() const;
   void removeExpiredWalls();
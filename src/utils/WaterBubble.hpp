@@ -5,7 +5,8 @@ class WaterBubble : public GameItem {
 public:
   WaterBubble(sf::Vector2i position, float lifetimeMultiplier = 1.0f);
 
-  void render(sf::RenderWindow& window, const GameGrid& grid) const override;
+  GameItemType getType() const override { return GameItemType::WaterBubble; }
+  TextureType getTextureType() const override;
   int getPoints() const override { return 100; }
   int getSpeedBonus() const override { return 0; }
   float getSpeedBonusDuration() const override { return 0.0f; }
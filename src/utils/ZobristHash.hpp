@@ -0,0 +1,34 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include "GameRandom.hpp"
+
+enum class ZobristFeature : uint8_t {
+  SnakeBody,
+  SnakeHead,
+  WallAppearing,
+  WallActive,
+  WallDisappearing,
+  RedApple,
+  GreenApple,
+  WaterBubble,
+  FantomApple
+};
+
+// Zobrist hashing: every (feature, cell) pair has a random 64-bit key and a board hashes to the XOR of
+// the keys of what is on it, so adding or removing a piece is one XOR. Keys are derived by hashing the
+// pair instead of read from a table, which works for any board size and for the cell just off the board
+// where a dead snake's head ends up.
+namespace zobrist {
+inline uint64_t key(ZobristFeature feature, sf::Vector2i cell) {
+  uint64_t value = (static_cast<uint64_t>(feature) << 48) ^
+                   (static_cast<uint64_t>(static_cast<uint16_t>(cell.x)) << 24) ^ static_cast<uint16_t>(cell.y);
+  return Xoshiro256::splitMix64(value);
+}
+
+// order-dependent combination for the scalar parts of a state
+inline uint64_t combine(uint64_t hash, uint64_t value) {
+  uint64_t mixed = hash ^ value;
+  return Xoshiro256::splitMix64(mixed);
+}
+}  // namespace zobrist
@@ -0,0 +1,318 @@
+#include "Autopilot.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include "../GameItem.hpp"
+
+namespace {
+constexpr sf::Vector2i NEIGHBOUR_OFFSETS[] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+Snake::Direction opposite(Snake::Direction direction) {
+  switch (direction) {
+    case Snake::Direction::Up:
+      return Snake::Direction::Down;
+    case Snake::Direction::Down:
+      return Snake::Direction::Up;
+    case Snake::Direction::Left:
+      return Snake::Direction::Right;
+    case Snake::Direction::Right:
+      return Snake::Direction::Left;
+  }
+  return direction;
+}
+}  // namespace
+
+Autopilot::Autopilot(int cols, int rows)
+    : cols(cols),
+      rows(rows),
+      enteredAt(static_cast<size_t>(cols * rows), NEVER_ENTERED),
+      blocked(static_cast<size_t>(cols * rows), 0),
+      targetAt(static_cast<size_t>(cols * rows), NO_TARGET),
+      visitedGeneration(static_cast<size_t>(cols * rows), 0),
+      parent(static_cast<size_t>(cols * rows), 0),
+      distance(static_cast<size_t>(cols * rows), 0) {
+  queue.reserve(static_cast<size_t>(cols * rows));
+  path.reserve(static_cast<size_t>(cols * rows));
+}
+
+std::optional<ReplayInput> Autopilot::update(const GameSimulation& simulation) {
+  if (simulation.isCountdownActive() || simulation.isGameOver()) {
+    return std::nullopt;
+  }
+
+  const Snake& snake = simulation.getSnake();
+  const sf::Vector2i head = snake.getHead();
+  if (tracking && head == lastHead) {
+    return std::nullopt;
+  }
+
+  // one cell since the last call is an ordinary move; anything else (a restored snapshot) resyncs
+  const sf::Vector2i step = head - lastHead;
+  if (tracking && std::abs(step.x) + std::abs(step.y) == 1 && snake.getLength() - length <= 1) {
+    advanceHead(head, snake.getLength());
+  } else {
+    resetBody(snake.getBody());
+  }
+  tracking = true;
+  lastHead = head;
+
+  syncWalls(simulation.getWallManager());
+  syncItems(simulation.getGameItemManager());
+
+  const auto direction = decide(snake.getDirection());
+  if (!direction || *direction == snake.getDirection()) {
+    return std::nullopt;
+  }
+
+  const Snake::Direction pressed = snake.isDisoriented() ? opposite(*direction) : *direction;
+  return static_cast<ReplayInput>(pressed);
+}
+
+void Autopilot::resetBody(const std::vector<sf::Vector2i>& body) {
+  std::fill(enteredAt.begin(), enteredAt.end(), NEVER_ENTERED);
+  moveCount = 0;
+  length = static_cast<int>(body.size());
+
+  // the head entered its cell on the current move, the segment behind it one move earlier, and so on
+  for (size_t i = body.size(); i-- > 0;) {
+    if (isInside(body[i])) {
+      enteredAt[toCell(body[i])] = -static_cast<int32_t>(i);
+    }
+  }
+  headCell = body.empty() || !isInside(body.front()) ? 0 : toCell(body.front());
+  path.clear();
+}
+
+void Autopilot::advanceHead(sf::Vector2i head, int newLength) {
+  moveCount++;
+  length = newLength;
+  if (!isInside(head)) {
+    path.clear();
+    return;
+  }
+
+  headCell = toCell(head);
+  enteredAt[headCell] = moveCount;
+  if (!path.empty() && path.back() == headCell) {
+    path.pop_back();
+  } else {
+    path.clear();
+  }
+}
+
+void Autopilot::clearBlocked() {
+  std::fill(blocked.begin(), blocked.end(), 0);
+  path.clear();
+}
+
+void Autopilot::setBlocked(sf::Vector2i cell) {
+  if (isInside(cell)) {
+    blocked[toCell(cell)] = 1;
+  }
+}
+
+void Autopilot::setTargets(const std::vector<AutopilotTarget>& newTargets) {
+  for (const auto& target : targets) {
+    targetAt[toCell(target.cell)] = NO_TARGET;
+  }
+
+  targets.clear();
+  maxTargetValue = 0.0f;
+  for (const auto& target : newTargets) {
+    if (target.value <= 0.0f || !isInside(target.cell)) {
+      continue;
+    }
+    targetAt[toCell(target.cell)] = static_cast<int32_t>(targets.size());
+    targets.push_back(target);
+    maxTargetValue = std::max(maxTargetValue, target.value);
+  }
+  path.clear();
+}
+
+std::optional<Snake::Direction> Autopilot::decide(Snake::Direction currentDirection) {
+  if (!path.empty() && !isOpenAfter(path.back(), 1)) {
+    path.clear();
+  }
+  if (path.empty() && !planPath()) {
+    return chooseSurvivalMove(currentDirection);
+  }
+  return directionTo(path.back());
+}
+
+void Autopilot::beginSearch() {
+  if (++generation == 0) {
+    std::fill(visitedGeneration.begin(), visitedGeneration.end(), 0);
+    generation = 1;
+  }
+  queue.clear();
+}
+
+bool Autopilot::planPath() {
+  path.clear();
+  if (targets.empty()) {
+    return false;
+  }
+
+  searchCount++;
+  beginSearch();
+  queue.push_back(headCell);
+  visitedGeneration[headCell] = generation;
+  distance[headCell] = 0;
+
+  int32_t bestCell = NO_TARGET;
+  float bestScore = 0.0f;
+  for (size_t i = 0; i < queue.size(); ++i) {
+    const int32_t cell = queue[i];
+    const int32_t moves = distance[cell] + 1;
+    // nothing further out can beat the best target found so far
+    if (bestCell != NO_TARGET && maxTargetValue / (static_cast<float>(moves) + DISTANCE_BIAS) <= bestScore) {
+      break;
+    }
+
+    const sf::Vector2i position(cell % cols, cell / cols);
+    for (const auto& offset : NEIGHBOUR_OFFSETS) {
+      const sf::Vector2i next = position + offset;
+      if (!isInside(next)) {
+        continue;
+      }
+      const int32_t nextCell = toCell(next);
+      if (visitedGeneration[nextCell] == generation || !isOpenAfter(nextCell, moves)) {
+        continue;
+      }
+      visitedGeneration[nextCell] = generation;
+      distance[nextCell] = moves;
+      parent[nextCell] = cell;
+      queue.push_back(nextCell);
+
+      if (targetAt[nextCell] != NO_TARGET) {
+        const float score = targets[targetAt[nextCell]].value / (static_cast<float>(moves) + DISTANCE_BIAS);
+        if (score > bestScore) {
+          bestScore = score;
+          bestCell = nextCell;
+        }
+      }
+    }
+  }
+
+  if (bestCell == NO_TARGET) {
+    return false;
+  }
+  for (int32_t cell = bestCell; cell != headCell; cell = parent[cell]) {
+    path.push_back(cell);
+  }
+
+  // an item behind a gap narrower than the body is a trap; play for time instead
+  if (countReachable(path.back(), length) < length) {
+    path.clear();
+    return false;
+  }
+  return true;
+}
+
+int Autopilot::countReachable(int32_t start, int limit) {
+  beginSearch();
+  queue.push_back(start);
+  visitedGeneration[start] = generation;
+  distance[start] = 1;
+
+  for (size_t i = 0; i < queue.size() && static_cast<int>(queue.size()) < limit; ++i) {
+    const int32_t cell = queue[i];
+    const int32_t moves = distance[cell] + 1;
+    const sf::Vector2i position(cell % cols, cell / cols);
+    for (const auto& offset : NEIGHBOUR_OFFSETS) {
+      const sf::Vector2i next = position + offset;
+      if (!isInside(next)) {
+        continue;
+      }
+      const int32_t nextCell = toCell(next);
+      if (visitedGeneration[nextCell] == generation || !isOpenAfter(nextCell, moves)) {
+        continue;
+      }
+      visitedGeneration[nextCell] = generation;
+      distance[nextCell] = moves;
+      queue.push_back(nextCell);
+    }
+  }
+  return static_cast<int>(queue.size());
+}
+
+std::optional<Snake::Direction> Autopilot::chooseSurvivalMove(Snake::Direction currentDirection) {
+  const sf::Vector2i head(headCell % cols, headCell / cols);
+  std::optional<Snake::Direction> best;
+  int bestRoom = 0;
+
+  for (const auto& offset : NEIGHBOUR_OFFSETS) {
+    const sf::Vector2i next = head + offset;
+    if (!isInside(next) || !isOpenAfter(toCell(next), 1)) {
+      continue;
+    }
+    const Snake::Direction direction = directionTo(toCell(next));
+    if (direction == opposite(currentDirection)) {
+      continue;
+    }
+    const int room = countReachable(toCell(next), length * 2);
+    if (room > bestRoom || (room == bestRoom && direction == currentDirection)) {
+      bestRoom = room;
+      best = direction;
+    }
+  }
+  return best;
+}
+
+Snake::Direction Autopilot::directionTo(int32_t cell) const {
+  const int dx = cell % cols - headCell % cols;
+  const int dy = cell / cols - headCell / cols;
+  if (dx > 0) {
+    return Snake::Direction::Right;
+  }
+  if (dx < 0) {
+    return Snake::Direction::Left;
+  }
+  return dy < 0 ? Snake::Direction::Up : Snake::Direction::Down;
+}
+
+void Autopilot::syncWalls(const WallManager& wallManager) {
+  if (wallManager.getZobristHash() == wallsHash) {
+    return;
+  }
+  wallsHash = wallManager.getZobristHash();
+
+  // appearing walls turn solid within seconds, so only fading ones are treated as open
+  clearBlocked();
+  for (const auto& wall : wallManager.getWalls()) {
+    if (wall->getCurrentPhase() == WallPhase::Disappearing) {
+      continue;
+    }
+    for (const auto& position : wall->getPositions()) {
+      setBlocked(position);
+    }
+  }
+}
+
+void Autopilot::syncItems(const GameItemManager& itemManager) {
+  if (itemManager.getZobristHash() == itemsHash) {
+    return;
+  }
+  itemsHash = itemManager.getZobristHash();
+
+  std::vector<AutopilotTarget> itemTargets;
+  itemTargets.reserve(itemManager.getItems().size());
+  for (const auto& item : itemManager.getItems()) {
+    itemTargets.push_back(AutopilotTarget{item->getPosition(), getItemValue(*item)});
+  }
+  setTargets(itemTargets);
+}
+
+float Autopilot::getItemValue(const GameItem& item) {
+  // slowing down buys time, invincibility is worth about an apple, reversed controls are a real risk
+  switch (item.getType()) {
+    case GameItemType::RedApple:
+      return static_cast<float>(item.getPoints()) + 10.0f;
+    case GameItemType::GreenApple:
+      return static_cast<float>(item.getPoints()) + 20.0f;
+    case GameItemType::WaterBubble:
+      return static_cast<float>(item.getPoints()) * 0.5f;
+    case GameItemType::FantomApple:
+      return static_cast<float>(item.getPoints()) + 40.0f;
+  }
+  return static_cast<float>(item.getPoints());
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "../../GameSimulation.hpp"
+#include "../replay/ReplayFile.hpp"
+
+struct AutopilotTarget {
+  sf::Vector2i cell;
+  float value = 0.0f;
+};
+
+// Steers the snake to the item with the best value per distance. The body is tracked as the move on which
+// the head entered each cell, so a head move is one store and "is this cell free after d more moves" is one
+// subtraction; searches treat body cells as open once the tail will have left them. A planned path is kept
+// and followed until the board changes under it, so most moves cost no search at all.
+class Autopilot {
+public:
+  Autopilot(int cols, int rows);
+
+  // Call once per tick. Returns an input only when the snake has to turn, already inverted when the snake
+  // is disoriented, so it can be recorded and applied like a key press.
+  std::optional<ReplayInput> update(const GameSimulation& simulation);
+
+  // board-level interface, used by update() and by the benchmark on boards larger than the game's
+  void resetBody(const std::vector<sf::Vector2i>& body);
+  void advanceHead(sf::Vector2i head, int length);
+  void clearBlocked();
+  void setBlocked(sf::Vector2i cell);
+  void setTargets(const std::vector<AutopilotTarget>& newTargets);
+  std::optional<Snake::Direction> decide(Snake::Direction currentDirection);
+
+  [[nodiscard]] uint64_t getSearchCount() const { return searchCount; }
+
+private:
+  static constexpr int32_t NEVER_ENTERED = -(1 << 30);
+  static constexpr int32_t NO_TARGET = -1;
+  static constexpr float DISTANCE_BIAS = 4.0f;
+
+  int cols;
+  int rows;
+  std::vector<int32_t> enteredAt;
+  std::vector<uint8_t> blocked;
+  std::vector<int32_t> targetAt;
+  std::vector<AutopilotTarget> targets;
+  float maxTargetValue = 0.0f;
+
+  int32_t moveCount = 0;
+  int length = 0;
+  int32_t headCell = 0;
+
+  // search scratch: a cell counts as visited only when its stamp equals the current generation,
+  // so starting a search never clears the board
+  std::vector<uint32_t> visitedGeneration;
+  std::vector<int32_t> parent;
+  std::vector<int32_t> distance;
+  std::vector<int32_t> queue;
+  uint32_t generation = 0;
+  uint64_t searchCount = 0;
+
+  // cells still to visit, the next step at the back
+  std::vector<int32_t> path;
+
+  bool tracking = false;
+  sf::Vector2i lastHead;
+  uint64_t wallsHash = 0;
+  uint64_t itemsHash = 0;
+
+  [[nodiscard]] int32_t toCell(sf::Vector2i position) const { return position.y * cols + position.x; }
+  [[nodiscard]] bool isInside(sf::Vector2i position) const {
+    return position.x >= 0 && position.y >= 0 && position.x < cols && position.y < rows;
+  }
+  [[nodiscard]] bool isOpenAfter(int32_t cell, int32_t moves) const {
+    return blocked[cell] == 0 && enteredAt[cell] + length - moveCount <= moves;
+  }
+
+  bool planPath();
+  int countReachable(int32_t start, int limit);
+  std::optional<Snake::Direction> chooseSurvivalMove(Snake::Direction currentDirection);
+  void beginSearch();
+  [[nodiscard]] Snake::Direction directionTo(int32_t cell) const;
+
+  void syncWalls(const WallManager& wallManager);
+  void syncItems(const GameItemManager& itemManager);
+  static float getItemValue(const GameItem& item);
+};
@@ -0,0 +1,384 @@
+#include "MctsBot.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include "../GameItem.hpp"
+#include "../TraceRecorder.hpp"
+
+namespace {
+constexpr sf::Vector2i NEIGHBOUR_OFFSETS[] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+Snake::Direction opposite(Snake::Direction direction) {
+  switch (direction) {
+    case Snake::Direction::Up:
+      return Snake::Direction::Down;
+    case Snake::Direction::Down:
+      return Snake::Direction::Up;
+    case Snake::Direction::Left:
+      return Snake::Direction::Right;
+    case Snake::Direction::Right:
+      return Snake::Direction::Left;
+  }
+  return direction;
+}
+
+// share of the horizon survived, plus the points scored on the way, both measured from the search root
+float computeReward(bool died, int moves, int points, int horizon, float fullPoints, float survivalWeight) {
+  const float survival = died ? static_cast<float>(moves) / static_cast<float>(horizon) : 1.0f;
+  const float gain = std::clamp(static_cast<float>(points) / fullPoints, 0.0f, 1.0f);
+  return survivalWeight * survival + (1.0f - survivalWeight) * gain;
+}
+}  // namespace
+
+MctsBot::MctsBot(unsigned threadCount)
+    : threadCount(threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())),
+      nodes(std::make_unique<Node[]>(MAX_NODES)),
+      workers(this->threadCount) {
+  for (unsigned i = 1; i < this->threadCount; ++i) {
+    threads.emplace_back(&MctsBot::runThread, this, i);
+  }
+}
+
+MctsBot::~MctsBot() {
+  {
+    std::lock_guard lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+std::optional<ReplayInput> MctsBot::update(const GameSimulation& simulation, std::chrono::microseconds budget) {
+  if (simulation.isCountdownActive() || simulation.isGameOver()) {
+    root = NO_NODE;
+    return std::nullopt;
+  }
+
+  prepareWorkers(simulation.getConfig());
+  advanceRoot(simulation);
+  if (root == NO_NODE || !simulation.saveSnapshot(rootSnapshot)) {
+    return std::nullopt;
+  }
+
+  const uint32_t nodesBefore = std::min(nodeCount.load(), MAX_NODES);
+  const auto start = std::chrono::steady_clock::now();
+  deadline = start + budget;
+  iterations = 0;
+  {
+    std::lock_guard lock(mutex);
+    activeWorkers = threadCount - 1;
+    searchGeneration++;
+  }
+  wake.notify_all();
+  search(workers[0]);
+  {
+    std::unique_lock lock(mutex);
+    finished.wait(lock, [this] { return activeWorkers == 0; });
+  }
+
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  lastSearch.iterations = iterations.load();
+  lastSearch.nodes = std::min(nodeCount.load(), MAX_NODES) - nodesBefore;
+  lastSearch.seconds = elapsed.count();
+  totalStats.iterations += lastSearch.iterations;
+  totalStats.nodes += lastSearch.nodes;
+  totalStats.seconds += lastSearch.seconds;
+
+  const Snake& snake = simulation.getSnake();
+  const auto direction = bestDirection(snake.getDirection());
+  if (!direction || *direction == pressedDirection) {
+    return std::nullopt;
+  }
+
+  pressedDirection = *direction;
+  const Snake::Direction pressed = snake.isDisoriented() ? opposite(*direction) : *direction;
+  return static_cast<ReplayInput>(pressed);
+}
+
+void MctsBot::runThread(unsigned index) {
+  TraceRecorder::nameThread("mcts worker");
+  uint64_t seenGeneration = 0;
+  while (true) {
+    {
+      std::unique_lock lock(mutex);
+      wake.wait(lock, [&] { return stopping || searchGeneration != seenGeneration; });
+      if (stopping) {
+        return;
+      }
+      seenGeneration = searchGeneration;
+    }
+
+    search(workers[index]);
+
+    std::lock_guard lock(mutex);
+    if (--activeWorkers == 0) {
+      finished.notify_one();
+    }
+  }
+}
+
+void MctsBot::search(Worker& worker) {
+  TRACE_SCOPE("mcts search");
+  uint64_t done = 0;
+  while (std::chrono::steady_clock::now() < deadline) {
+    runIteration(worker);
+    done++;
+  }
+  iterations.fetch_add(done, std::memory_order_relaxed);
+}
+
+void MctsBot::runIteration(Worker& worker) {
+  GameSimulation& simulation = *worker.simulation;
+  simulation.restoreSnapshot(rootSnapshot);
+  const int startScore = simulation.getScore();
+
+  worker.path.clear();
+  worker.path.push_back(root);
+  nodes[root].virtualLoss.fetch_add(1, std::memory_order_relaxed);
+
+  int moves = 0;
+  float reward = 0.0f;
+  uint32_t current = root;
+  while (true) {
+    const Node& node = nodes[current];
+    if (node.terminal || moves >= HORIZON_MOVES) {
+      reward = computeReward(node.terminal, moves, simulation.getScore() - startScore, HORIZON_MOVES,
+                             POINTS_FOR_FULL_REWARD, SURVIVAL_WEIGHT);
+      break;
+    }
+
+    const uint32_t slot = selectChild(node, simulation.getSnake().getDirection());
+    const bool died = stepMove(simulation, static_cast<Snake::Direction>(slot));
+    moves++;
+
+    uint32_t child = nodes[current].children[slot].load(std::memory_order_acquire);
+    const bool expanding = child == NO_NODE;
+    if (expanding) {
+      child = allocateNode(simulation.getZobristHash(), died);
+      uint32_t expected = NO_NODE;
+      // two workers can expand the same edge at once; the loser's node is wasted and it follows the winner's,
+      // which holds the same state because the simulation is deterministic
+      if (child != NO_NODE &&
+          !nodes[current].children[slot].compare_exchange_strong(expected, child, std::memory_order_acq_rel)) {
+        child = expected;
+      }
+    }
+
+    if (child == NO_NODE) {
+      reward = died ? computeReward(true, moves, simulation.getScore() - startScore, HORIZON_MOVES,
+                                    POINTS_FOR_FULL_REWARD, SURVIVAL_WEIGHT)
+                    : rollout(worker, moves, startScore);
+      break;
+    }
+
+    nodes[child].virtualLoss.fetch_add(1, std::memory_order_relaxed);
+    worker.path.push_back(child);
+    current = child;
+
+    if (expanding) {
+      reward = died ? computeReward(true, moves, simulation.getScore() - startScore, HORIZON_MOVES,
+                                    POINTS_FOR_FULL_REWARD, SURVIVAL_WEIGHT)
+                    : rollout(worker, moves, startScore);
+      break;
+    }
+  }
+
+  for (const uint32_t index : worker.path) {
+    Node& node = nodes[index];
+    node.valueSum.fetch_add(reward, std::memory_order_relaxed);
+    node.visits.fetch_add(1, std::memory_order_relaxed);
+    node.virtualLoss.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+float MctsBot::rollout(Worker& worker, int movesDone, int startScore) {
+  GameSimulation& simulation = *worker.simulation;
+  int moves = movesDone;
+  while (moves < HORIZON_MOVES && !simulation.isGameOver()) {
+    const Snake& snake = simulation.getSnake();
+    const Snake::Direction current = snake.getDirection();
+
+    std::array<Snake::Direction, 3> safe{};
+    size_t safeCount = 0;
+    for (int i = 0; i < 4; ++i) {
+      const auto direction = static_cast<Snake::Direction>(i);
+      if (direction != opposite(current) && isSafe(simulation, direction)) {
+        safe[safeCount++] = direction;
+      }
+    }
+
+    Snake::Direction chosen = current;
+    if (safeCount > 0) {
+      chosen = safe[boundedRandom(worker.random, static_cast<uint32_t>(safeCount))];
+
+      // half of the moves head for the nearest item, which keeps rollouts from wandering
+      const auto& items = simulation.getGameItemManager().getItems();
+      if (!items.empty() && (worker.random() & 1) != 0) {
+        const sf::Vector2i head = snake.getHead();
+        int bestDistance = std::numeric_limits<int>::max();
+        for (size_t i = 0; i < safeCount; ++i) {
+          const sf::Vector2i next = head + NEIGHBOUR_OFFSETS[static_cast<size_t>(safe[i])];
+          for (const auto& item : items) {
+            const sf::Vector2i delta = item->getPosition() - next;
+            const int distance = std::abs(delta.x) + std::abs(delta.y);
+            if (distance < bestDistance) {
+              bestDistance = distance;
+              chosen = safe[i];
+            }
+          }
+        }
+      }
+    }
+
+    stepMove(simulation, chosen);
+    moves++;
+  }
+
+  return computeReward(simulation.isGameOver(), moves, simulation.getScore() - startScore, HORIZON_MOVES,
+                       POINTS_FOR_FULL_REWARD, SURVIVAL_WEIGHT);
+}
+
+void MctsBot::prepareWorkers(const SimulationConfig& config) {
+  if (workerConfig && workerConfig->difficulty == config.difficulty) {
+    return;
+  }
+
+  // built here rather than on the worker threads, so constructing simulations never races
+  for (size_t i = 0; i < workers.size(); ++i) {
+    workers[i].simulation = std::make_unique<GameSimulation>(config);
+    workers[i].random.seed(config.seed + i);
+    workers[i].path.reserve(HORIZON_MOVES + 1);
+  }
+  workerConfig = config;
+  root = NO_NODE;
+}
+
+void MctsBot::advanceRoot(const GameSimulation& simulation) {
+  const Snake& snake = simulation.getSnake();
+  const sf::Vector2i head = snake.getHead();
+  const uint32_t tick = simulation.getTick();
+  const bool nextTick = root != NO_NODE && tick == rootTick + 1;
+
+  // the snake has not moved yet, so the tree still describes the coming move
+  if (nextTick && head == rootHead) {
+    rootTick = tick;
+    return;
+  }
+
+  uint32_t next = NO_NODE;
+  const uint64_t hash = simulation.getZobristHash();
+  if (nextTick) {
+    const uint32_t child = nodes[root].children[static_cast<size_t>(snake.getDirection())].load();
+    if (child != NO_NODE && nodes[child].hash == hash) {
+      next = child;
+    }
+  }
+
+  // discarded subtrees are never reclaimed, so the pool starts over before it runs dry
+  if (next == NO_NODE || nodeCount.load() > MAX_NODES - MAX_NODES / 4) {
+    nodeCount = 0;
+    next = allocateNode(hash, false);
+  }
+
+  root = next;
+  rootTick = tick;
+  rootHead = head;
+  pressedDirection = snake.getDirection();
+}
+
+uint32_t MctsBot::allocateNode(uint64_t hash, bool terminal) {
+  const uint32_t index = nodeCount.fetch_add(1, std::memory_order_relaxed);
+  if (index >= MAX_NODES) {
+    return NO_NODE;
+  }
+
+  Node& node = nodes[index];
+  for (auto& child : node.children) {
+    child.store(NO_NODE, std::memory_order_relaxed);
+  }
+  node.visits.store(0, std::memory_order_relaxed);
+  node.virtualLoss.store(0, std::memory_order_relaxed);
+  node.valueSum.store(0.0f, std::memory_order_relaxed);
+  node.hash = hash;
+  node.terminal = terminal;
+  return index;
+}
+
+uint32_t MctsBot::selectChild(const Node& node, Snake::Direction currentDirection) const {
+  const float parentVisits = static_cast<float>(node.visits.load(std::memory_order_relaxed) +
+                                                node.virtualLoss.load(std::memory_order_relaxed));
+  const float logParent = std::log(std::max(1.0f, parentVisits));
+
+  uint32_t best = static_cast<uint32_t>(currentDirection);
+  float bestScore = -std::numeric_limits<float>::infinity();
+  for (uint32_t slot = 0; slot < 4; ++slot) {
+    if (static_cast<Snake::Direction>(slot) == opposite(currentDirection)) {
+      continue;
+    }
+
+    const uint32_t child = node.children[slot].load(std::memory_order_acquire);
+    if (child == NO_NODE) {
+      return slot;
+    }
+
+    // a rollout in flight counts as a visit that scored nothing, steering other workers elsewhere
+    const Node& childNode = nodes[child];
+    const auto visits = static_cast<float>(childNode.visits.load(std::memory_order_relaxed) +
+                                           childNode.virtualLoss.load(std::memory_order_relaxed));
+    if (visits == 0.0f) {
+      return slot;
+    }
+
+    const float score = childNode.valueSum.load(std::memory_order_relaxed) / visits +
+                        EXPLORATION * std::sqrt(logParent / visits);
+    if (score > bestScore) {
+      bestScore = score;
+      best = slot;
+    }
+  }
+  return best;
+}
+
+std::optional<Snake::Direction> MctsBot::bestDirection(Snake::Direction currentDirection) const {
+  std::optional<Snake::Direction> best;
+  uint32_t bestVisits = 0;
+  for (uint32_t slot = 0; slot < 4; ++slot) {
+    const uint32_t child = nodes[root].children[slot].load();
+    if (child == NO_NODE || static_cast<Snake::Direction>(slot) == opposite(currentDirection)) {
+      continue;
+    }
+    const uint32_t visits = nodes[child].visits.load();
+    if (visits > bestVisits) {
+      bestVisits = visits;
+      best = static_cast<Snake::Direction>(slot);
+    }
+  }
+  return best;
+}
+
+bool MctsBot::stepMove(GameSimulation& simulation, Snake::Direction direction) {
+  const Snake& snake = simulation.getSnake();
+  simulation.setDirection(snake.isDisoriented() ? opposite(direction) : direction);
+
+  const sf::Vector2i head = snake.getHead();
+  for (int i = 0; i < MAX_TICKS_PER_MOVE && !simulation.isGameOver() && snake.getHead() == head; ++i) {
+    simulation.tick();
+  }
+  return simulation.isGameOver();
+}
+
+bool MctsBot::isSafe(const GameSimulation& simulation, Snake::Direction direction) {
+  const Snake& snake = simulation.getSnake();
+  const sf::Vector2i next = snake.getHead() + NEIGHBOUR_OFFSETS[static_cast<size_t>(direction)];
+  if (next.x < 0 || next.y < 0 || next.x >= GameSimulation::GRID_COLS || next.y >= GameSimulation::GRID_ROWS) {
+    return false;
+  }
+  if (snake.isInvincible()) {
+    return true;
+  }
+  return !simulation.getWallManager().checkWallCollision(next) &&
+         (next == snake.getTail() || !snake.checkCollisionWithPosition(next));
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "../../GameSimulation.hpp"
+#include "../replay/ReplayFile.hpp"
+
+struct MctsSearchStats {
+  uint64_t iterations = 0;
+  uint64_t nodes = 0;
+  double seconds = 0.0;
+};
+
+// Monte Carlo tree search over the headless simulation. One tree edge is the direction held until the snake's
+// next move; rollouts play a short horizon with a random policy that avoids immediate deaths and leans
+// towards the nearest item. Workers share one tree (tree parallelisation) and spread out through virtual
+// loss: a node on a path being searched looks like it just lost until that rollout returns. Every rollout
+// starts from a restore of the root snapshot into the worker's own simulation, so nothing but bytes is
+// copied. The tree is kept across ticks and the chosen child becomes the next root after a move, as long as
+// the game reached the state that child recorded.
+class MctsBot {
+public:
+  static constexpr std::chrono::microseconds DEFAULT_BUDGET{2000};
+
+  // threadCount 0 uses every hardware thread; the calling thread is one of the workers
+  explicit MctsBot(unsigned threadCount = 0);
+  ~MctsBot();
+
+  MctsBot(const MctsBot&) = delete;
+  MctsBot& operator=(const MctsBot&) = delete;
+
+  // Call once per tick. Searches for the budget, then returns an input when the best direction differs from
+  // the one already pressed for the coming move, already inverted when the snake is disoriented.
+  std::optional<ReplayInput> update(const GameSimulation& simulation,
+                                    std::chrono::microseconds budget = DEFAULT_BUDGET);
+
+  [[nodiscard]] unsigned getThreadCount() const { return threadCount; }
+  [[nodiscard]] const MctsSearchStats& getLastSearch() const { return lastSearch; }
+  [[nodiscard]] const MctsSearchStats& getTotalStats() const { return totalStats; }
+
+private:
+  static constexpr uint32_t NO_NODE = UINT32_MAX;
+  static constexpr uint32_t MAX_NODES = 1 << 17;
+  static constexpr int HORIZON_MOVES = 32;
+  static constexpr int MAX_TICKS_PER_MOVE = 10 * GameSimulation::TICKS_PER_SECOND;
+  static constexpr float POINTS_FOR_FULL_REWARD = 100.0f;
+  static constexpr float SURVIVAL_WEIGHT = 0.6f;
+  static constexpr float EXPLORATION = 0.7f;
+
+  // children are published with a release store after the creating worker filled in hash and terminal
+  struct Node {
+    std::array<std::atomic<uint32_t>, 4> children;
+    std::atomic<uint32_t> visits;
+    std::atomic<uint32_t> virtualLoss;
+    std::atomic<float> valueSum;
+    uint64_t hash = 0;
+    bool terminal = false;
+  };
+
+  struct Worker {
+    std::unique_ptr<GameSimulation> simulation;
+    Xoshiro256 random;
+    std::vector<uint32_t> path;
+  };
+
+  unsigned threadCount;
+  std::unique_ptr<Node[]> nodes;
+  std::atomic<uint32_t> nodeCount = 0;
+  uint32_t root = NO_NODE;
+
+  std::vector<Worker> workers;
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable finished;
+  uint64_t searchGeneration = 0;
+  unsigned activeWorkers = 0;
+  bool stopping = false;
+
+  // read-only while a search runs
+  GameSnapshot rootSnapshot;
+  std::chrono::steady_clock::time_point deadline;
+  std::atomic<uint64_t> iterations = 0;
+
+  std::optional<SimulationConfig> workerConfig;
+  sf::Vector2i rootHead;
+  uint32_t rootTick = 0;
+  Snake::Direction pressedDirection = Snake::Direction::Right;
+  MctsSearchStats lastSearch;
+  MctsSearchStats totalStats;
+
+  void runThread(unsigned index);
+  void search(Worker& worker);
+  void runIteration(Worker& worker);
+  float rollout(Worker& worker, int movesDone, int startScore);
+
+  void prepareWorkers(const SimulationConfig& config);
+  void advanceRoot(const GameSimulation& simulation);
+  uint32_t allocateNode(uint64_t hash, bool terminal);
+  [[nodiscard]] uint32_t selectChild(const Node& node, Snake::Direction currentDirection) const;
+  [[nodiscard]] std::optional<Snake::Direction> bestDirection(Snake::Direction currentDirection) const;
+
+  static bool stepMove(GameSimulation& simulation, Snake::Direction direction);
+  static bool isSafe(const GameSimulation& simulation, Snake::Direction direction);
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include <array>
+#include "DifficultySettings.hpp"
+
+// Generated by difficulty_tuner; rerun it with new targets rather than editing the numbers by hand.
+// Hand-tuned values that predate the tuner.
+
+// indexed by GameDifficultyLevel
+inline constexpr std::array<DifficultyPreset, 5> DIFFICULTY_PRESETS = {{
+    // Easy
+    {4.000f, 0.300f, 8.000f, 4.000f, 3, 1.500f, 0.200f, 0.700f, 0.150f, 0.100f, 0.050f, 2, 0.050f, 1.000f, 1.200f},
+    // HarderThanEasy
+    {5.000f, 0.400f, 7.000f, 3.500f, 4, 1.300f, 0.250f, 0.600f, 0.200f, 0.150f, 0.050f, 2, 0.050f, 1.100f, 1.100f},
+    // Middle
+    {6.000f, 0.500f, 6.000f, 3.000f, 5, 1.000f, 0.300f, 0.500f, 0.200f, 0.200f, 0.100f, 4, 0.100f, 1.200f, 1.000f},
+    // HarderThanMiddle
+    {7.500f, 0.600f, 5.000f, 2.500f, 6, 0.800f, 0.400f, 0.400f, 0.250f, 0.250f, 0.100f, 6, 0.150f, 1.500f, 0.900f},
+    // Hard
+    {9.000f, 0.800f, 4.000f, 2.000f, 8, 0.600f, 0.500f, 0.300f, 0.300f, 0.250f, 0.150f, 8, 0.200f, 2.000f, 0.800f},
+}};
@@ -78,6 +78,15 @@ void DifficultySettings::setMultipliers(float score, float effectDuration) {
   effectDurationMultiplier = effectDuration;
 }
 
+void DifficultySettings::applyPreset(const DifficultyPreset& preset) {
+  setSnakeParameters(preset.baseSnakeSpeed, preset.speedIncreaseRate, preset.speedIncreaseInterval);
+  setItemParameters(preset.itemSpawnInterval, preset.maxItemsOnBoard, preset.appleLifetimeMultiplier,
+                    preset.specialItemChance);
+  setAppleChances(preset.redAppleChance, preset.greenAppleChance, preset.waterBubbleChance, preset.fantomAppleChance);
+  setWallParameters(preset.wallCount, preset.wallDensity);
+  setMultipliers(preset.scoreMultiplier, preset.effectDurationMultiplier);
+}
+
 bool DifficultySettings::validate() const {
   if (baseSnakeSpeed <= 0.0f || speedIncreaseRate < 0.0f || speedIncreaseInterval <= 0.0f) {
     std::cerr << "Invalid snake parameters" << std::endl;
@@ -3,6 +3,25 @@
 
 #include <cstdint>
 
+// Every tunable number of one difficulty level as plain data, so presets can live in a generated table
+struct DifficultyPreset {
+  float baseSnakeSpeed;
+  float speedIncreaseRate;
+  float speedIncreaseInterval;
+  float itemSpawnInterval;
+  uint8_t maxItemsOnBoard;
+  float appleLifetimeMultiplier;
+  float specialItemChance;
+  float redAppleChance;
+  float greenAppleChance;
+  float waterBubbleChance;
+  float fantomAppleChance;
+  uint8_t wallCount;
+  float wallDensity;
+  float scoreMultiplier;
+  float effectDurationMultiplier;
+};
+
 class DifficultySettings {
 public:
   DifficultySettings() = default;
@@ -40,6 +59,9 @@ public:
 
   void setMultipliers(float score, float effectDuration);
 
+  // goes through the setters, so an out-of-range preset throws like a bad setter call
+  void applyPreset(const DifficultyPreset& preset);
+
   bool validate() const;
 
 private:
@@ -0,0 +1,139 @@
+#include "GameClient.hpp"
+#include <utility>
+
+GameClient::GameClient(Transport& transport, EndpointId server, bool spectator)
+    : transport(transport), server(server), spectator(spectator), history(NetProtocol::STATE_HISTORY) {
+  sendJoin();
+}
+
+bool GameClient::update() {
+  bool newState = false;
+  EndpointId from = 0;
+  while (transport.receive(from, receiveBuffer)) {
+    if (from == server) {
+      bytesReceived += receiveBuffer.size();
+      newState |= handleDatagram();
+    }
+  }
+
+  if (rejected) {
+    return newState;
+  }
+  if (++ticksSinceSend >= (isConnected() ? KEEP_ALIVE_TICKS : JOIN_RETRY_TICKS)) {
+    if (isConnected()) {
+      sendCurrentInput();
+    } else {
+      sendJoin();
+    }
+  }
+  return newState;
+}
+
+void GameClient::sendInput(Snake::Direction direction) {
+  input.sequence++;
+  input.direction = direction;
+  hasInput = true;
+  if (isConnected()) {
+    sendCurrentInput();
+  }
+}
+
+void GameClient::leave() {
+  if (isConnected()) {
+    PacketWriter writer(sendBuffer);
+    NetProtocol::writeLeave(writer);
+    send();
+    welcome.reset();
+  }
+}
+
+const NetPlayerState* GameClient::findOwnPlayer() const {
+  if (!welcome) {
+    return nullptr;
+  }
+  for (const NetPlayerState& player : getState().players) {
+    if (player.id == welcome->playerId) {
+      return &player;
+    }
+  }
+  return nullptr;
+}
+
+void GameClient::sendJoin() {
+  PacketWriter writer(sendBuffer);
+  NetProtocol::writeJoin(writer, spectator);
+  send();
+  ticksSinceSend = 0;
+}
+
+// a keep-alive repeats the last input under its own sequence number, which the server takes as already
+// applied; before the first turn it carries sequence 0, which the server never applies
+void GameClient::sendCurrentInput() {
+  PacketWriter writer(sendBuffer);
+  NetProtocol::writeInput(writer, hasInput ? input : NetInput{});
+  send();
+  ticksSinceSend = 0;
+}
+
+// an ack does not count as a keep-alive, which also resends an input the server may have missed
+void GameClient::sendAck(uint32_t tick) {
+  PacketWriter writer(sendBuffer);
+  NetProtocol::writeAck(writer, tick);
+  send();
+}
+
+void GameClient::send() {
+  if (transport.send(server, sendBuffer)) {
+    bytesSent += sendBuffer.size();
+  }
+}
+
+bool GameClient::handleDatagram() {
+  PacketReader reader(receiveBuffer);
+  const auto type = NetProtocol::readType(reader);
+  if (type == NetMessage::Welcome) {
+    if (!welcome) {
+      welcome = NetProtocol::readWelcome(reader);
+      // a turn made while joining goes out now that there is a player to turn
+      if (welcome && hasInput) {
+        sendCurrentInput();
+      }
+    }
+  } else if (type == NetMessage::Reject) {
+    rejected = !welcome;
+  } else if (type == NetMessage::State && welcome) {
+    return handleState(reader);
+  }
+  return false;
+}
+
+bool GameClient::handleState(PacketReader& reader) {
+  const auto header = NetProtocol::readStateHeader(reader);
+  // states can arrive out of order; an older one than the board shows is dropped
+  if (!header || (statesReceived > 0 && header->tick <= getState().tick)) {
+    return false;
+  }
+  const NetBoardState* baseline = findHistory(header->baselineTick);
+  if ((header->baselineTick != 0 && !baseline) || !NetProtocol::readState(reader, *header, baseline, incoming)) {
+    statesDropped++;
+    return false;
+  }
+
+  latest = (latest + 1) % history.size();
+  std::swap(history[latest], incoming);
+  statesReceived++;
+  sendAck(header->tick);
+  return true;
+}
+
+const NetBoardState* GameClient::findHistory(uint32_t tick) const {
+  if (tick == 0) {
+    return nullptr;
+  }
+  for (const NetBoardState& state : history) {
+    if (state.tick == tick) {
+      return &state;
+    }
+  }
+  return nullptr;
+}
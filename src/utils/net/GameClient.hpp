@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "NetProtocol.hpp"
+#include "Transport.hpp"
+
+// The player's side of a multiplayer game: joins the server, sends turns and rebuilds the board from the
+// states the server broadcasts, acknowledging each so the next can be sent as changes from it. A spectator
+// joins without a snake and only watches. update() is called once per tick; the client counts ticks by those
+// calls to repeat a Join that went unanswered and to keep its input alive.
+class GameClient {
+public:
+  static constexpr int JOIN_RETRY_TICKS = 30;
+  static constexpr int KEEP_ALIVE_TICKS = 60;
+
+  // the transport must outlive the client
+  GameClient(Transport& transport, EndpointId server, bool spectator = false);
+
+  // reads every waiting datagram; true when a newer state arrived
+  bool update();
+  void sendInput(Snake::Direction direction);
+  void leave();
+
+  [[nodiscard]] bool isConnected() const { return welcome.has_value(); }
+  [[nodiscard]] bool wasRejected() const { return rejected; }
+  [[nodiscard]] bool isSpectator() const { return spectator; }
+  [[nodiscard]] const std::optional<NetWelcome>& getWelcome() const { return welcome; }
+  [[nodiscard]] const NetBoardState& getState() const { return history[latest]; }
+  // the player's own entry in the state, nullptr before the first state with it
+  [[nodiscard]] const NetPlayerState* findOwnPlayer() const;
+
+  [[nodiscard]] uint64_t getBytesSent() const { return bytesSent; }
+  [[nodiscard]] uint64_t getBytesReceived() const { return bytesReceived; }
+  [[nodiscard]] uint64_t getStatesReceived() const { return statesReceived; }
+  // damaged states and ones encoded against a state this client no longer has
+  [[nodiscard]] uint64_t getStatesDropped() const { return statesDropped; }
+
+private:
+  Transport& transport;
+  EndpointId server;
+  bool spectator;
+  std::optional<NetWelcome> welcome;
+  bool rejected = false;
+  NetInput input;
+  bool hasInput = false;
+  int ticksSinceSend = 0;
+
+  // the states decoded lately, any of which the server may encode against; latest is the board shown
+  std::vector<NetBoardState> history;
+  size_t latest = 0;
+  // decoded into first, so a damaged packet never leaves the board half updated
+  NetBoardState incoming;
+  std::vector<uint8_t> receiveBuffer;
+  std::vector<uint8_t> sendBuffer;
+  uint64_t bytesSent = 0;
+  uint64_t bytesReceived = 0;
+  uint64_t statesReceived = 0;
+  uint64_t statesDropped = 0;
+
+  void sendJoin();
+  void sendCurrentInput();
+  void sendAck(uint32_t tick);
+  void send();
+  bool handleDatagram();
+  bool handleState(PacketReader& reader);
+  [[nodiscard]] const NetBoardState* findHistory(uint32_t tick) const;
+};
@@ -0,0 +1,194 @@
+#include "GameServer.hpp"
+#include <algorithm>
+#include <chrono>
+#include "../Logger.hpp"
+#include "NetProtocol.hpp"
+
+GameServer::GameServer(const MultiplayerConfig& config, Transport& transport, int broadcastInterval)
+    : simulation(config),
+      transport(transport),
+      broadcastInterval(std::max(1, broadcastInterval)),
+      history(NetProtocol::STATE_HISTORY) {
+  clients.reserve(static_cast<size_t>(simulation.getConfig().maxPlayers));
+}
+
+void GameServer::tick() {
+  const auto start = std::chrono::steady_clock::now();
+
+  receiveAll();
+  simulation.tick();
+  dropSilentClients();
+  if (simulation.getTick() % static_cast<uint32_t>(broadcastInterval) == 0) {
+    broadcastState();
+  }
+
+  const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  stats.ticks++;
+  stats.lastTickMs = elapsedMs;
+  stats.maxTickMs = std::max(stats.maxTickMs, elapsedMs);
+  stats.totalTickMs += elapsedMs;
+}
+
+void GameServer::receiveAll() {
+  EndpointId from = 0;
+  while (transport.receive(from, receiveBuffer)) {
+    stats.datagramsReceived++;
+    stats.bytesReceived += receiveBuffer.size();
+    handleDatagram(from);
+  }
+}
+
+void GameServer::handleDatagram(EndpointId from) {
+  PacketReader reader(receiveBuffer);
+  const auto type = NetProtocol::readType(reader);
+  if (type == NetMessage::Join) {
+    handleJoin(from, reader);
+    return;
+  }
+
+  const auto found = clientIndex.find(from);
+  if (!type || found == clientIndex.end()) {
+    stats.rejectedDatagrams++;
+    return;
+  }
+
+  Client& client = clients[found->second];
+  client.lastHeardTick = simulation.getTick();
+  if (type == NetMessage::Input) {
+    const auto input = NetProtocol::readInput(reader);
+    if (input && input->sequence > client.lastInputSequence && client.playerId != NetWelcome::SPECTATOR) {
+      client.lastInputSequence = input->sequence;
+      simulation.setDirection(client.playerId, input->direction);
+    }
+  } else if (type == NetMessage::Ack) {
+    // acks can arrive out of order; the newest state the client has is the best baseline
+    const auto tick = NetProtocol::readAck(reader);
+    if (tick && *tick > client.ackedTick && *tick <= simulation.getTick()) {
+      client.ackedTick = *tick;
+    }
+  } else if (type == NetMessage::Leave) {
+    removeClient(found->second);
+  } else {
+    stats.rejectedDatagrams++;
+  }
+}
+
+void GameServer::handleJoin(EndpointId from, PacketReader& reader) {
+  PacketWriter writer(sendBuffer);
+  const auto spectator = NetProtocol::readJoin(reader);
+  if (!spectator) {
+    NetProtocol::writeReject(writer);
+    sendTo(from, sendBuffer);
+    return;
+  }
+
+  // a repeated Join means the Welcome was lost, so the client gets it again rather than a second snake
+  auto found = clientIndex.find(from);
+  if (found == clientIndex.end()) {
+    std::optional<uint16_t> playerId;
+    if (!*spectator) {
+      playerId = simulation.addPlayer();
+    } else if (spectatorCount < MAX_SPECTATORS) {
+      playerId = NetWelcome::SPECTATOR;
+    }
+    if (!playerId) {
+      NetProtocol::writeReject(writer);
+      sendTo(from, sendBuffer);
+      return;
+    }
+    spectatorCount += *spectator ? 1 : 0;
+    clients.push_back(Client{from, *playerId, 0, simulation.getTick(), 0});
+    found = clientIndex.emplace(from, clients.size() - 1).first;
+    if (*spectator) {
+      LOG_DEBUG("Spectator joined, {} connected", clients.size());
+    } else {
+      LOG_DEBUG("Player {} joined, {} connected", *playerId, clients.size());
+    }
+  }
+
+  const Client& client = clients[found->second];
+  NetWelcome welcome;
+  welcome.playerId = client.playerId;
+  welcome.cols = static_cast<uint16_t>(simulation.getConfig().cols);
+  welcome.rows = static_cast<uint16_t>(simulation.getConfig().rows);
+  welcome.ticksPerSecond = static_cast<uint8_t>(MultiplayerSimulation::TICKS_PER_SECOND);
+  NetProtocol::writeWelcome(writer, welcome);
+  sendTo(from, sendBuffer);
+}
+
+void GameServer::removeClient(size_t index) {
+  if (clients[index].playerId == NetWelcome::SPECTATOR) {
+    LOG_DEBUG("Spectator left, {} connected", clients.size() - 1);
+    spectatorCount--;
+  } else {
+    LOG_DEBUG("Player {} left, {} connected", clients[index].playerId, clients.size() - 1);
+    simulation.removePlayer(clients[index].playerId);
+  }
+  clientIndex.erase(clients[index].endpoint);
+  if (index + 1 != clients.size()) {
+    clients[index] = clients.back();
+    clientIndex[clients[index].endpoint] = index;
+  }
+  clients.pop_back();
+}
+
+void GameServer::dropSilentClients() {
+  for (size_t i = clients.size(); i-- > 0;) {
+    if (simulation.getTick() - clients[i].lastHeardTick > CLIENT_TIMEOUT_TICKS) {
+      removeClient(i);
+    }
+  }
+}
+
+void GameServer::broadcastState() {
+  if (clients.empty()) {
+    return;
+  }
+
+  // broadcasts fall on multiples of the interval, so each has its own slot until the history wraps
+  const uint32_t tick = simulation.getTick();
+  NetBoardState& state = history[tick / static_cast<uint32_t>(broadcastInterval) % history.size()];
+  NetProtocol::captureState(simulation, state);
+
+  encodedCount = 0;
+  for (const Client& client : clients) {
+    const NetBoardState* baseline = findHistory(client.ackedTick);
+    sendTo(client.endpoint, encodeAgainst(state, baseline));
+    (baseline ? stats.deltaStatesSent : stats.fullStatesSent)++;
+  }
+}
+
+const NetBoardState* GameServer::findHistory(uint32_t tick) const {
+  if (tick == 0) {
+    return nullptr;
+  }
+  const NetBoardState& state = history[tick / static_cast<uint32_t>(broadcastInterval) % history.size()];
+  return state.tick == tick ? &state : nullptr;
+}
+
+const std::vector<uint8_t>& GameServer::encodeAgainst(const NetBoardState& state, const NetBoardState* baseline) {
+  const uint32_t baselineTick = baseline ? baseline->tick : 0;
+  for (size_t i = 0; i < encodedCount; ++i) {
+    if (encoded[i].baselineTick == baselineTick) {
+      return encoded[i].bytes;
+    }
+  }
+
+  if (encodedCount == encoded.size()) {
+    encoded.emplace_back();
+  }
+  EncodedState& entry = encoded[encodedCount++];
+  entry.baselineTick = baselineTick;
+  PacketWriter writer(entry.bytes);
+  NetProtocol::writeState(writer, baseline, state);
+  return entry.bytes;
+}
+
+void GameServer::sendTo(EndpointId endpoint, const std::vector<uint8_t>& bytes) {
+  if (!transport.send(endpoint, bytes)) {
+    stats.sendFailures++;
+    return;
+  }
+  stats.datagramsSent++;
+  stats.bytesSent += bytes.size();
+}
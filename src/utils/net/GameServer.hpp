@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "../../MultiplayerSimulation.hpp"
+#include "NetProtocol.hpp"
+#include "Packet.hpp"
+#include "Transport.hpp"
+
+struct ServerStats {
+  uint64_t ticks = 0;
+  // whole server ticks: reading the transport, simulating and broadcasting
+  double lastTickMs = 0.0;
+  double maxTickMs = 0.0;
+  double totalTickMs = 0.0;
+  uint64_t bytesSent = 0;
+  uint64_t bytesReceived = 0;
+  uint64_t datagramsSent = 0;
+  uint64_t datagramsReceived = 0;
+  // datagrams the transport refused, mostly states too large for one datagram
+  uint64_t sendFailures = 0;
+  // states sent as the whole board, to clients with no acknowledged state still in the history
+  uint64_t fullStatesSent = 0;
+  uint64_t deltaStatesSent = 0;
+  // datagrams that were not a message from a known client
+  uint64_t rejectedDatagrams = 0;
+};
+
+// The authoritative side of a multiplayer game. Each tick it reads every waiting datagram, applies the
+// clients' inputs, advances the MultiplayerSimulation by one tick and, every broadcastInterval ticks, sends
+// the board to every client in one datagram: as the changes since the newest state the client acknowledged,
+// or whole when that state has left the history. Clients that acknowledged the same state share one
+// encoding. It does not keep time itself: a real server calls tick() TICKS_PER_SECOND times a second, a load
+// run as fast as it can. Clients silent for CLIENT_TIMEOUT_TICKS lose their snake.
+class GameServer {
+public:
+  static constexpr uint32_t CLIENT_TIMEOUT_TICKS = 10 * MultiplayerSimulation::TICKS_PER_SECOND;
+  // 20 states a second, three ticks apart at 60 ticks per second
+  static constexpr int DEFAULT_BROADCAST_INTERVAL = 3;
+  static constexpr int MAX_SPECTATORS = 256;
+
+  // the transport must outlive the server
+  GameServer(const MultiplayerConfig& config, Transport& transport,
+             int broadcastInterval = DEFAULT_BROADCAST_INTERVAL);
+
+  void tick();
+
+  [[nodiscard]] const MultiplayerSimulation& getSimulation() const { return simulation; }
+  [[nodiscard]] const ServerStats& getStats() const { return stats; }
+  [[nodiscard]] int getClientCount() const { return static_cast<int>(clients.size()); }
+  [[nodiscard]] int getSpectatorCount() const { return spectatorCount; }
+
+private:
+  struct Client {
+    EndpointId endpoint = 0;
+    // NetWelcome::SPECTATOR for a client that only watches
+    uint16_t playerId = 0;
+    uint32_t lastInputSequence = 0;
+    uint32_t lastHeardTick = 0;
+    // the newest state the client acknowledged, 0 before the first
+    uint32_t ackedTick = 0;
+  };
+
+  // one broadcast's encoding against one baseline
+  struct EncodedState {
+    uint32_t baselineTick = 0;
+    std::vector<uint8_t> bytes;
+  };
+
+  MultiplayerSimulation simulation;
+  Transport& transport;
+  int broadcastInterval;
+  std::vector<Client> clients;
+  std::unordered_map<EndpointId, size_t> clientIndex;
+  int spectatorCount = 0;
+  ServerStats stats;
+
+  // the states broadcast lately, each in the slot of its broadcast number
+  std::vector<NetBoardState> history;
+  // kept across broadcasts for their capacity; the first encodedCount are this broadcast's
+  std::vector<EncodedState> encoded;
+  size_t encodedCount = 0;
+
+  std::vector<uint8_t> receiveBuffer;
+  std::vector<uint8_t> sendBuffer;
+
+  void receiveAll();
+  void handleDatagram(EndpointId from);
+  void handleJoin(EndpointId from, PacketReader& reader);
+  void removeClient(size_t index);
+  void dropSilentClients();
+  void broadcastState();
+  [[nodiscard]] const NetBoardState* findHistory(uint32_t tick) const;
+  const std::vector<uint8_t>& encodeAgainst(const NetBoardState& state, const NetBoardState* baseline);
+  void sendTo(EndpointId endpoint, const std::vector<uint8_t>& bytes);
+};
@@ -0,0 +1,70 @@
+#include "InProcessTransport.hpp"
+
+class InProcessNetwork::Endpoint final : public Transport {
+public:
+  Endpoint(InProcessNetwork& network, EndpointId id, Mailbox& mailbox) : network(network), id(id), mailbox(mailbox) {}
+
+  ~Endpoint() override {
+    const std::lock_guard lock(mailbox.mutex);
+    mailbox.open = false;
+    mailbox.datagrams.clear();
+  }
+
+  [[nodiscard]] EndpointId getLocalEndpoint() const override { return id; }
+
+  bool send(EndpointId to, std::span<const uint8_t> bytes) override { return network.deliver(id, to, bytes); }
+
+  bool receive(EndpointId& from, std::vector<uint8_t>& bytes) override {
+    const std::lock_guard lock(mailbox.mutex);
+    if (mailbox.datagrams.empty()) {
+      return false;
+    }
+
+    Datagram& datagram = mailbox.datagrams.front();
+    from = datagram.from;
+    bytes.swap(datagram.bytes);
+    mailbox.spareBuffers.push_back(std::move(datagram.bytes));
+    mailbox.datagrams.pop_front();
+    return true;
+  }
+
+private:
+  InProcessNetwork& network;
+  EndpointId id;
+  Mailbox& mailbox;
+};
+
+std::unique_ptr<Transport> InProcessNetwork::createEndpoint(size_t mailboxCapacity) {
+  const std::lock_guard lock(mailboxesMutex);
+  auto& mailbox = mailboxes.emplace_back(std::make_unique<Mailbox>());
+  mailbox->capacity = mailboxCapacity;
+  // endpoint 0 is never handed out, so it can stand for no endpoint
+  return std::make_unique<Endpoint>(*this, static_cast<EndpointId>(mailboxes.size()), *mailbox);
+}
+
+InProcessNetwork::Mailbox* InProcessNetwork::findMailbox(EndpointId endpoint) {
+  const std::lock_guard lock(mailboxesMutex);
+  return endpoint >= 1 && endpoint <= mailboxes.size() ? mailboxes[endpoint - 1].get() : nullptr;
+}
+
+bool InProcessNetwork::deliver(EndpointId from, EndpointId to, std::span<const uint8_t> bytes) {
+  Mailbox* mailbox = findMailbox(to);
+  if (!mailbox || bytes.size() > MAX_DATAGRAM_BYTES) {
+    return false;
+  }
+
+  const std::lock_guard lock(mailbox->mutex);
+  // like UDP, a datagram nobody takes is lost without the sender hearing of it
+  if (!mailbox->open || mailbox->datagrams.size() >= mailbox->capacity) {
+    return true;
+  }
+
+  Datagram& datagram = mailbox->datagrams.emplace_back();
+  datagram.from = from;
+  if (!mailbox->spareBuffers.empty()) {
+    datagram.bytes = std::move(mailbox->spareBuffers.back());
+    mailbox->spareBuffers.pop_back();
+  }
+  datagram.bytes.assign(bytes.begin(), bytes.end());
+  return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+#include "Transport.hpp"
+
+// Connects endpoints in one process through mailboxes, so a server and hundreds of clients can run
+// together without sockets. A datagram is copied into the receiver's mailbox on send; a full mailbox drops
+// it, as a full socket buffer would. Endpoints may send from any thread.
+class InProcessNetwork {
+public:
+  static constexpr size_t DEFAULT_MAILBOX_CAPACITY = 1024;
+  static constexpr size_t MAX_DATAGRAM_BYTES = 65507;
+
+  // the network must outlive its endpoints
+  std::unique_ptr<Transport> createEndpoint(size_t mailboxCapacity = DEFAULT_MAILBOX_CAPACITY);
+
+private:
+  struct Datagram {
+    EndpointId from = 0;
+    std::vector<uint8_t> bytes;
+  };
+
+  struct Mailbox {
+    std::mutex mutex;
+    std::deque<Datagram> datagrams;
+    // emptied datagrams kept for their capacity
+    std::vector<std::vector<uint8_t>> spareBuffers;
+    size_t capacity = 0;
+    // cleared when its endpoint is destroyed; datagrams sent to it after that are dropped
+    bool open = true;
+  };
+
+  class Endpoint;
+
+  std::mutex mailboxesMutex;
+  std::vector<std::unique_ptr<Mailbox>> mailboxes;
+
+  Mailbox* findMailbox(EndpointId endpoint);
+  bool deliver(EndpointId from, EndpointId to, std::span<const uint8_t> bytes);
+};
@@ -0,0 +1,163 @@
+#include "NetProtocol.hpp"
+#include "../../MultiplayerSimulation.hpp"
+#include "StateDelta.hpp"
+
+std::optional<NetMessage> NetProtocol::readType(PacketReader& reader) {
+  const auto type = reader.read<uint8_t>();
+  if (!reader.succeeded() || type > static_cast<uint8_t>(NetMessage::Ack)) {
+    return std::nullopt;
+  }
+  return static_cast<NetMessage>(type);
+}
+
+void NetProtocol::writeJoin(PacketWriter& writer, bool spectator) {
+  writer.write(NetMessage::Join);
+  writer.write(VERSION);
+  writer.write(static_cast<uint8_t>(spectator ? 1 : 0));
+}
+
+std::optional<bool> NetProtocol::readJoin(PacketReader& reader) {
+  const auto version = reader.read<uint16_t>();
+  const auto spectator = reader.read<uint8_t>();
+  if (!reader.succeeded() || version != VERSION) {
+    return std::nullopt;
+  }
+  return spectator != 0;
+}
+
+void NetProtocol::writeWelcome(PacketWriter& writer, const NetWelcome& welcome) {
+  writer.write(NetMessage::Welcome);
+  writer.write(welcome.playerId);
+  writer.write(welcome.cols);
+  writer.write(welcome.rows);
+  writer.write(welcome.ticksPerSecond);
+}
+
+std::optional<NetWelcome> NetProtocol::readWelcome(PacketReader& reader) {
+  NetWelcome welcome;
+  welcome.playerId = reader.read<uint16_t>();
+  welcome.cols = reader.read<uint16_t>();
+  welcome.rows = reader.read<uint16_t>();
+  welcome.ticksPerSecond = reader.read<uint8_t>();
+  if (!reader.succeeded()) {
+    return std::nullopt;
+  }
+  return welcome;
+}
+
+void NetProtocol::writeReject(PacketWriter& writer) {
+  writer.write(NetMessage::Reject);
+}
+
+void NetProtocol::writeLeave(PacketWriter& writer) {
+  writer.write(NetMessage::Leave);
+}
+
+void NetProtocol::writeInput(PacketWriter& writer, const NetInput& input) {
+  writer.write(NetMessage::Input);
+  writer.write(input.sequence);
+  writer.write(static_cast<uint8_t>(input.direction));
+}
+
+std::optional<NetInput> NetProtocol::readInput(PacketReader& reader) {
+  NetInput input;
+  input.sequence = reader.read<uint32_t>();
+  const auto direction = reader.read<uint8_t>();
+  if (!reader.succeeded() || direction > static_cast<uint8_t>(Snake::Direction::Right)) {
+    return std::nullopt;
+  }
+  input.direction = static_cast<Snake::Direction>(direction);
+  return input;
+}
+
+void NetProtocol::captureState(const MultiplayerSimulation& simulation, NetBoardState& state) {
+  state.tick = simulation.getTick();
+
+  size_t count = 0;
+  const auto& players = simulation.getPlayers();
+  state.players.resize(static_cast<size_t>(simulation.getPlayerCount()));
+  for (size_t id = 0; id < players.size() && count < state.players.size(); ++id) {
+    if (!players[id]) {
+      continue;
+    }
+    const MultiplayerPlayer& player = *players[id];
+    NetPlayerState& entry = state.players[count++];
+    entry.id = static_cast<uint16_t>(id);
+    entry.score = player.score;
+    entry.alive = player.snake.has_value();
+    if (!player.snake) {
+      entry.invincible = false;
+      entry.disoriented = false;
+      entry.direction = Snake::Direction::Right;
+      entry.snakeType = SnakeSprite::SnakeType::Purple;
+      entry.body.clear();
+      continue;
+    }
+    const Snake& snake = *player.snake;
+    entry.invincible = snake.isInvincible();
+    entry.disoriented = snake.isDisoriented();
+    entry.direction = snake.getDirection();
+    entry.snakeType = snake.getSnakeType();
+    entry.body.assign(snake.getBody().begin(), snake.getBody().end());
+  }
+  state.players.resize(count);
+
+  const auto& items = simulation.getGameItemManager().getItems();
+  state.items.resize(items.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    state.items[i].position = items[i]->getPosition();
+    state.items[i].type = items[i]->getType();
+  }
+
+  const auto& walls = simulation.getWallManager().getWalls();
+  state.walls.resize(walls.size());
+  for (size_t i = 0; i < walls.size(); ++i) {
+    state.walls[i].phase = walls[i]->getCurrentPhase();
+    state.walls[i].type = walls[i]->getType();
+    state.walls[i].cells.assign(walls[i]->getPositions().begin(), walls[i]->getPositions().end());
+  }
+
+  StateDelta::canonicalize(state);
+}
+
+void NetProtocol::writeState(PacketWriter& writer, const NetBoardState* baseline, const NetBoardState& state) {
+  static const NetBoardState EMPTY;
+  writer.write(NetMessage::State);
+  writer.writeVarint(state.tick);
+  // the baseline goes as how many ticks back it is, which takes a byte where its tick would take three
+  writer.writeVarint(baseline ? state.tick - baseline->tick : 0);
+  BitWriter bits(writer.getBytes());
+  StateDelta::encode(bits, baseline ? *baseline : EMPTY, state);
+}
+
+std::optional<NetStateHeader> NetProtocol::readStateHeader(PacketReader& reader) {
+  NetStateHeader header;
+  header.tick = reader.readVarint();
+  const uint32_t ticksBack = reader.readVarint();
+  if (!reader.succeeded() || ticksBack > header.tick) {
+    return std::nullopt;
+  }
+  header.baselineTick = ticksBack == 0 ? 0 : header.tick - ticksBack;
+  return header;
+}
+
+bool NetProtocol::readState(PacketReader& reader, const NetStateHeader& header, const NetBoardState* baseline,
+                            NetBoardState& state) {
+  static const NetBoardState EMPTY;
+  BitReader bits(reader.rest());
+  state.tick = header.tick;
+  return StateDelta::decode(bits, baseline ? *baseline : EMPTY, state);
+}
+
+void NetProtocol::writeAck(PacketWriter& writer, uint32_t tick) {
+  writer.write(NetMessage::Ack);
+  writer.write(tick);
+}
+
+std::optional<uint32_t> NetProtocol::readAck(PacketReader& reader) {
+  const auto tick = reader.read<uint32_t>();
+  if (!reader.succeeded()) {
+    return std::nullopt;
+  }
+  return tick;
+}
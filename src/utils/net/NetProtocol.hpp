@@ -0,0 +1,109 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+#include "../../Snake.hpp"
+#include "../GameItem.hpp"
+#include "../Wall.hpp"
+#include "Packet.hpp"
+
+class MultiplayerSimulation;
+
+// Every datagram starts with its message type. Clients send Join until they get Welcome or Reject, then
+// Input with a sequence number that only goes up, so a late or repeated datagram cannot undo a newer turn;
+// Input is repeated now and then as a keep-alive. The server answers with State on broadcast ticks, each
+// encoded against the newest state the client has answered with Ack, and spectators get the same States
+// without a snake of their own.
+enum class NetMessage : uint8_t { Join, Welcome, Reject, Input, State, Leave, Ack };
+
+struct NetWelcome {
+  static constexpr uint16_t SPECTATOR = UINT16_MAX;
+
+  // SPECTATOR for a client that only watches
+  uint16_t playerId = 0;
+  uint16_t cols = 0;
+  uint16_t rows = 0;
+  uint8_t ticksPerSecond = 0;
+};
+
+struct NetInput {
+  uint32_t sequence = 0;
+  Snake::Direction direction = Snake::Direction::Right;
+};
+
+// the board as a client rebuilds it from State
+struct NetPlayerState {
+  uint16_t id = 0;
+  bool alive = false;
+  bool invincible = false;
+  bool disoriented = false;
+  Snake::Direction direction = Snake::Direction::Right;
+  SnakeSprite::SnakeType snakeType = SnakeSprite::SnakeType::Purple;
+  int32_t score = 0;
+  // head first, empty while the player waits to spawn
+  std::vector<sf::Vector2i> body;
+};
+
+struct NetItemState {
+  sf::Vector2i position;
+  GameItemType type = GameItemType::RedApple;
+};
+
+struct NetWallState {
+  WallPhase phase = WallPhase::Appearing;
+  Wall::WallType type = Wall::WallType::Wall_1;
+  std::vector<sf::Vector2i> cells;
+};
+
+// the ticks a State was sent at and encoded against; baselineTick is 0 for a whole board
+struct NetStateHeader {
+  uint32_t tick = 0;
+  uint32_t baselineTick = 0;
+};
+
+struct NetBoardState {
+  uint32_t tick = 0;
+  std::vector<NetPlayerState> players;
+  std::vector<NetItemState> items;
+  std::vector<NetWallState> walls;
+};
+
+// Encoding and decoding of the messages. States go through StateDelta as bit-packed changes from a
+// baseline; everything else is fixed-size fields. Decoding reuses the vectors of the state it fills, so a
+// client stops allocating once they have grown.
+class NetProtocol {
+public:
+  static constexpr uint16_t VERSION = 2;
+  // states either side keeps to encode against or decode with, 1.6 s of broadcasts at 20 a second
+  static constexpr size_t STATE_HISTORY = 32;
+
+  static std::optional<NetMessage> readType(PacketReader& reader);
+
+  static void writeJoin(PacketWriter& writer, bool spectator);
+  // whether the client only watches, nullopt for a client speaking another version
+  static std::optional<bool> readJoin(PacketReader& reader);
+
+  static void writeWelcome(PacketWriter& writer, const NetWelcome& welcome);
+  static std::optional<NetWelcome> readWelcome(PacketReader& reader);
+
+  static void writeReject(PacketWriter& writer);
+  static void writeLeave(PacketWriter& writer);
+
+  static void writeInput(PacketWriter& writer, const NetInput& input);
+  static std::optional<NetInput> readInput(PacketReader& reader);
+
+  // the board as clients see it, in the canonical order StateDelta encodes
+  static void captureState(const MultiplayerSimulation& simulation, NetBoardState& state);
+
+  // baseline nullptr sends the whole board
+  static void writeState(PacketWriter& writer, const NetBoardState* baseline, const NetBoardState& state);
+  static std::optional<NetStateHeader> readStateHeader(PacketReader& reader);
+  // after readStateHeader, with the baseline it names; state is left partly filled when the packet turns out
+  // damaged
+  static bool readState(PacketReader& reader, const NetStateHeader& header, const NetBoardState* baseline,
+                        NetBoardState& state);
+
+  static void writeAck(PacketWriter& writer, uint32_t tick);
+  static std::optional<uint32_t> readAck(PacketReader& reader);
+};
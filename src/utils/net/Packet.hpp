@@ -0,0 +1,216 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+static_assert(std::endian::native == std::endian::little, "Packets are sent in little-endian order");
+
+// Appends values to a datagram, the way SnapshotWriter fills a snapshot; the vector keeps its capacity
+// between packets, so encoding the same state every tick stops allocating once it has grown.
+class PacketWriter {
+public:
+  explicit PacketWriter(std::vector<uint8_t>& bytes) : bytes(bytes) { bytes.clear(); }
+
+  template <typename T>
+  void write(T value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(T));
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+  }
+
+  void writePosition(sf::Vector2i position) {
+    write(static_cast<int16_t>(position.x));
+    write(static_cast<int16_t>(position.y));
+  }
+
+  // seven bits a byte, the high bit set while more follow; small numbers take one byte
+  void writeVarint(uint32_t value) {
+    while (value >= 0x80) {
+      bytes.push_back(static_cast<uint8_t>(value | 0x80));
+      value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+  }
+
+  // reserves a value to fill in once it is known, like a count written before the entries
+  template <typename T>
+  size_t reserve() {
+    const size_t offset = bytes.size();
+    write(T{});
+    return offset;
+  }
+  template <typename T>
+  void writeAt(size_t offset, T value) {
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+  }
+
+  [[nodiscard]] size_t size() const { return bytes.size(); }
+  // for a BitWriter to carry on after the byte-aligned fields
+  [[nodiscard]] std::vector<uint8_t>& getBytes() { return bytes; }
+
+private:
+  std::vector<uint8_t>& bytes;
+};
+
+class PacketReader {
+public:
+  explicit PacketReader(std::span<const uint8_t> bytes) : bytes(bytes) {}
+
+  // a failed read returns a zero value and makes succeeded() false for the rest of the packet
+  template <typename T>
+  T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value{};
+    if (offset + sizeof(T) > bytes.size()) {
+      failed = true;
+      return value;
+    }
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+  }
+
+  sf::Vector2i readPosition() {
+    const auto x = read<int16_t>();
+    const auto y = read<int16_t>();
+    return sf::Vector2i(x, y);
+  }
+
+  uint32_t readVarint() {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+      const auto byte = read<uint8_t>();
+      value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+      if ((byte & 0x80) == 0) {
+        return value;
+      }
+    }
+    failed = true;
+    return 0;
+  }
+
+  // the bytes not read yet, for a BitReader to take over the rest of the packet
+  [[nodiscard]] std::span<const uint8_t> rest() const { return bytes.subspan(offset); }
+
+  void fail() { failed = true; }
+
+  [[nodiscard]] bool succeeded() const { return !failed; }
+  [[nodiscard]] bool atEnd() const { return offset == bytes.size(); }
+  [[nodiscard]] size_t remaining() const { return bytes.size() - offset; }
+
+private:
+  std::span<const uint8_t> bytes;
+  size_t offset = 0;
+  bool failed = false;
+};
+
+// Packs values at bit granularity after whatever the vector already holds. Numbers too varied for a fixed
+// width go as varints of groupBits-wide groups, each followed by a bit saying whether another group comes,
+// so the group width can be picked for the values a field usually takes.
+class BitWriter {
+public:
+  explicit BitWriter(std::vector<uint8_t>& bytes) : bytes(bytes) {}
+
+  // count is at most 32
+  void writeBits(uint32_t value, int count) {
+    pending |= static_cast<uint64_t>(value & mask(count)) << pendingBits;
+    pendingBits += count;
+    while (pendingBits >= 8) {
+      bytes.push_back(static_cast<uint8_t>(pending));
+      pending >>= 8;
+      pendingBits -= 8;
+    }
+  }
+
+  void writeBool(bool value) { writeBits(value ? 1 : 0, 1); }
+
+  void writeVarint(uint32_t value, int groupBits) {
+    while (true) {
+      const bool more = (value >> groupBits) != 0;
+      writeBits(value, groupBits);
+      writeBool(more);
+      if (!more) {
+        return;
+      }
+      value >>= groupBits;
+    }
+  }
+
+  // zigzag first, so small negative numbers stay small
+  void writeSignedVarint(int32_t value, int groupBits) {
+    writeVarint((static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31), groupBits);
+  }
+
+  // pads the last byte with zeros; call once, after the last value
+  void flush() {
+    if (pendingBits > 0) {
+      bytes.push_back(static_cast<uint8_t>(pending));
+    }
+    pending = 0;
+    pendingBits = 0;
+  }
+
+private:
+  std::vector<uint8_t>& bytes;
+  uint64_t pending = 0;
+  int pendingBits = 0;
+
+  static uint32_t mask(int count) { return count >= 32 ? ~0u : (1u << count) - 1; }
+};
+
+class BitReader {
+public:
+  explicit BitReader(std::span<const uint8_t> bytes) : bytes(bytes) {}
+
+  // as with PacketReader, reading past the end returns zeros and makes succeeded() false
+  uint32_t readBits(int count) {
+    while (bufferedBits < count) {
+      if (offset == bytes.size()) {
+        failed = true;
+        return 0;
+      }
+      buffer |= static_cast<uint64_t>(bytes[offset++]) << bufferedBits;
+      bufferedBits += 8;
+    }
+    const auto value = static_cast<uint32_t>(buffer & ((uint64_t{1} << count) - 1));
+    buffer >>= count;
+    bufferedBits -= count;
+    return value;
+  }
+
+  bool readBool() { return readBits(1) != 0; }
+
+  uint32_t readVarint(int groupBits) {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 32; shift += groupBits) {
+      value |= readBits(groupBits) << shift;
+      if (!readBool()) {
+        return value;
+      }
+    }
+    failed = true;
+    return 0;
+  }
+
+  int32_t readSignedVarint(int groupBits) {
+    const uint32_t value = readVarint(groupBits);
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+  }
+
+  [[nodiscard]] bool succeeded() const { return !failed; }
+  [[nodiscard]] size_t remainingBits() const { return (bytes.size() - offset) * 8 + static_cast<size_t>(bufferedBits); }
+  // only the padding of the last byte left
+  [[nodiscard]] bool atEnd() const { return offset == bytes.size() && bufferedBits < 8; }
+
+private:
+  std::span<const uint8_t> bytes;
+  size_t offset = 0;
+  uint64_t buffer = 0;
+  int bufferedBits = 0;
+  bool failed = false;
+};
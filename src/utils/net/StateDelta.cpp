@@ -0,0 +1,478 @@
+#include "StateDelta.hpp"
+#include <algorithm>
+#include "../../PackedSnakeBody.hpp"
+
+namespace {
+// every list is walked as runs of entries the baseline already has, each run ended by one of these
+enum class PlayerOp : uint8_t { Remove, Change, Add };
+enum class ItemOp : uint8_t { Remove, Add };
+enum class WallOp : uint8_t { Remove, Add, Phase };
+
+bool cellLess(sf::Vector2i a, sf::Vector2i b) {
+  return a.y != b.y ? a.y < b.y : a.x < b.x;
+}
+
+// items and walls have no id; one is the same as another when everything but a wall's phase matches
+bool itemLess(const NetItemState& a, const NetItemState& b) {
+  return a.position != b.position ? cellLess(a.position, b.position) : a.type < b.type;
+}
+
+bool wallLess(const NetWallState& a, const NetWallState& b) {
+  if (a.cells != b.cells) {
+    return std::lexicographical_compare(a.cells.begin(), a.cells.end(), b.cells.begin(), b.cells.end(), cellLess);
+  }
+  return a.type < b.type;
+}
+
+template <typename T>
+T& nextSlot(std::vector<T>& entries, size_t& count) {
+  if (count == entries.size()) {
+    entries.emplace_back();
+  }
+  return entries[count++];
+}
+
+void writeRecord(BitWriter& writer, uint32_t& unchanged, uint8_t op, int opBits, int groupBits) {
+  writer.writeBool(true);
+  writer.writeVarint(unchanged, groupBits);
+  writer.writeBits(op, opBits);
+  unchanged = 0;
+}
+}  // namespace
+
+void StateDelta::canonicalize(NetBoardState& state) {
+  std::sort(state.players.begin(), state.players.end(), [](const auto& a, const auto& b) { return a.id < b.id; });
+  std::sort(state.items.begin(), state.items.end(), itemLess);
+  std::sort(state.walls.begin(), state.walls.end(), wallLess);
+}
+
+void StateDelta::encode(BitWriter& writer, const NetBoardState& baseline, const NetBoardState& state) {
+  encodePlayers(writer, baseline, state);
+  encodeItems(writer, baseline, state);
+  encodeWalls(writer, baseline, state);
+  writer.flush();
+}
+
+bool StateDelta::decode(BitReader& reader, const NetBoardState& baseline, NetBoardState& state) {
+  return decodePlayers(reader, baseline, state) && decodeItems(reader, baseline, state) &&
+         decodeWalls(reader, baseline, state) && reader.atEnd();
+}
+
+uint8_t StateDelta::packFlags(const NetPlayerState& player) {
+  return static_cast<uint8_t>((player.alive ? ALIVE : 0) | (player.invincible ? INVINCIBLE : 0) |
+                              (player.disoriented ? DISORIENTED : 0) |
+                              static_cast<uint8_t>(player.direction) << DIRECTION_SHIFT |
+                              static_cast<uint8_t>(player.snakeType) << SNAKE_TYPE_SHIFT);
+}
+
+bool StateDelta::unpackFlags(uint8_t flags, NetPlayerState& player) {
+  const int snakeType = flags >> SNAKE_TYPE_SHIFT;
+  if (snakeType > static_cast<int>(SnakeSprite::SnakeType::Black)) {
+    return false;
+  }
+  player.alive = (flags & ALIVE) != 0;
+  player.invincible = (flags & INVINCIBLE) != 0;
+  player.disoriented = (flags & DISORIENTED) != 0;
+  player.direction = static_cast<Snake::Direction>(flags >> DIRECTION_SHIFT & 3);
+  player.snakeType = static_cast<SnakeSprite::SnakeType>(snakeType);
+  return true;
+}
+
+bool StateDelta::samePlayer(const NetPlayerState& a, const NetPlayerState& b) {
+  return packFlags(a) == packFlags(b) && a.score == b.score && a.body == b.body;
+}
+
+void StateDelta::encodePlayers(BitWriter& writer, const NetBoardState& baseline, const NetBoardState& state) {
+  const auto& before = baseline.players;
+  const auto& after = state.players;
+  size_t b = 0;
+  size_t a = 0;
+  uint32_t unchanged = 0;
+  int previousId = -1;
+  while (b < before.size() || a < after.size()) {
+    if (a == after.size() || (b < before.size() && before[b].id < after[a].id)) {
+      writeRecord(writer, unchanged, static_cast<uint8_t>(PlayerOp::Remove), 2, SMALL_GROUP);
+      b++;
+    } else if (b == before.size() || after[a].id < before[b].id) {
+      writeRecord(writer, unchanged, static_cast<uint8_t>(PlayerOp::Add), 2, SMALL_GROUP);
+      writer.writeVarint(static_cast<uint32_t>(after[a].id - previousId - 1), SMALL_GROUP);
+      encodePlayer(writer, nullptr, after[a]);
+      previousId = after[a++].id;
+    } else {
+      if (samePlayer(before[b], after[a])) {
+        unchanged++;
+      } else {
+        writeRecord(writer, unchanged, static_cast<uint8_t>(PlayerOp::Change), 2, SMALL_GROUP);
+        encodePlayer(writer, &before[b], after[a]);
+      }
+      previousId = after[a].id;
+      b++;
+      a++;
+    }
+  }
+  writer.writeBool(false);
+}
+
+void StateDelta::encodePlayer(BitWriter& writer, const NetPlayerState* baseline, const NetPlayerState& player) {
+  const uint8_t flags = packFlags(player);
+  if (!baseline) {
+    writer.writeBits(flags, 8);
+    writer.writeSignedVarint(player.score, LARGE_GROUP);
+    if (player.alive) {
+      encodeBody(writer, player.body);
+    }
+    return;
+  }
+
+  const bool flagsChanged = flags != packFlags(*baseline);
+  writer.writeBool(flagsChanged);
+  if (flagsChanged) {
+    writer.writeBits(flags, 8);
+  }
+  writer.writeBool(player.score != baseline->score);
+  if (player.score != baseline->score) {
+    writer.writeSignedVarint(player.score - baseline->score, LARGE_GROUP);
+  }
+  if (!player.alive) {
+    return;
+  }
+
+  const auto steps = baseline->alive ? findMoveSteps(baseline->body, player.body) : std::nullopt;
+  writer.writeBool(steps.has_value());
+  if (!steps) {
+    encodeBody(writer, player.body);
+    return;
+  }
+  // the new head cells, walked from the baseline's head forward to the current one
+  writer.writeVarint(static_cast<uint32_t>(*steps), SMALL_GROUP);
+  sf::Vector2i cell = baseline->body.front();
+  for (size_t i = *steps; i-- > 0;) {
+    writer.writeBits(static_cast<uint32_t>(*PackedSnakeBody::stepBetween(cell, player.body[i])), 2);
+    cell = player.body[i];
+  }
+  writer.writeSignedVarint(static_cast<int32_t>(player.body.size()) - static_cast<int32_t>(baseline->body.size()),
+                           SMALL_GROUP);
+}
+
+std::optional<size_t> StateDelta::findMoveSteps(const std::vector<sf::Vector2i>& baseline,
+                                                const std::vector<sf::Vector2i>& body) {
+  if (baseline.empty() || body.empty()) {
+    return std::nullopt;
+  }
+  const size_t maxSteps = std::min(body.size() - 1, static_cast<size_t>(MAX_DELTA_STEPS));
+  for (size_t steps = 0; steps <= maxSteps; ++steps) {
+    const size_t kept = body.size() - steps;
+    if (body[steps] != baseline.front() || kept > baseline.size() ||
+        !std::equal(body.begin() + static_cast<std::ptrdiff_t>(steps), body.end(), baseline.begin())) {
+      continue;
+    }
+    bool adjacent = true;
+    for (size_t i = steps; i > 0 && adjacent; --i) {
+      adjacent = PackedSnakeBody::stepBetween(body[i], body[i - 1]).has_value();
+    }
+    if (adjacent) {
+      return steps;
+    }
+  }
+  return std::nullopt;
+}
+
+void StateDelta::encodeBody(BitWriter& writer, const std::vector<sf::Vector2i>& body) {
+  writer.writeVarint(static_cast<uint32_t>(body.size()), LARGE_GROUP);
+  if (body.empty()) {
+    return;
+  }
+  writeCell(writer, body.front());
+  for (size_t i = 1; i < body.size(); ++i) {
+    // segments are always neighbours; should one not be, it is sent as a step up rather than breaking the packet
+    const auto step = PackedSnakeBody::stepBetween(body[i - 1], body[i]).value_or(PackedSnakeBody::Step::Up);
+    writer.writeBits(static_cast<uint32_t>(step), 2);
+  }
+}
+
+void StateDelta::encodeItems(BitWriter& writer, const NetBoardState& baseline, const NetBoardState& state) {
+  const auto& before = baseline.items;
+  const auto& after = state.items;
+  size_t b = 0;
+  size_t a = 0;
+  uint32_t unchanged = 0;
+  while (b < before.size() || a < after.size()) {
+    if (a == after.size() || (b < before.size() && itemLess(before[b], after[a]))) {
+      writeRecord(writer, unchanged, static_cast<uint8_t>(ItemOp::Remove), 1, SMALL_GROUP);
+      b++;
+    } else if (b == before.size() || itemLess(after[a], before[b])) {
+      writeRecord(writer, unchanged, static_cast<uint8_t>(ItemOp::Add), 1, SMALL_GROUP);
+      writeCell(writer, after[a].position);
+      writer.writeBits(static_cast<uint32_t>(after[a].type), 2);
+      a++;
+    } else {
+      unchanged++;
+      b++;
+      a++;
+    }
+  }
+  writer.writeBool(false);
+}
+
+void StateDelta::encodeWalls(BitWriter& writer, const NetBoardState& baseline, const NetBoardState& state) {
+  const auto& before = baseline.walls;
+  const auto& after = state.walls;
+  size_t b = 0;
+  size_t a = 0;
+  uint32_t unchanged = 0;
+  while (b < before.size() || a < after.size()) {
+    if (a == after.size() || (b < before.size() && wallLess(before[b], after[a]))) {
+      writeRecord(writer, unchanged, static_cast<uint8_t>(WallOp::Remove), 2, SMALL_GROUP);
+      b++;
+    } else if (b == before.size() || wallLess(after[a], before[b])) {
+      const NetWallState& wall = after[a++];
+      writeRecord(writer, unchanged, static_cast<uint8_t>(WallOp::Add), 2, SMALL_GROUP);
+      writer.writeBits(static_cast<uint32_t>(wall.type), 2);
+      writer.writeBits(static_cast<uint32_t>(wall.phase), 2);
+      writer.writeVarint(static_cast<uint32_t>(wall.cells.size()), SMALL_GROUP);
+      for (size_t i = 0; i < wall.cells.size(); ++i) {
+        if (i == 0) {
+          writeCell(writer, wall.cells[0]);
+          continue;
+        }
+        writer.writeSignedVarint(wall.cells[i].x - wall.cells[i - 1].x, SMALL_GROUP);
+        writer.writeSignedVarint(wall.cells[i].y - wall.cells[i - 1].y, SMALL_GROUP);
+      }
+    } else {
+      if (before[b].phase == after[a].phase) {
+        unchanged++;
+      } else {
+        writeRecord(writer, unchanged, static_cast<uint8_t>(WallOp::Phase), 2, SMALL_GROUP);
+        writer.writeBits(static_cast<uint32_t>(after[a].phase), 2);
+      }
+      b++;
+      a++;
+    }
+  }
+  writer.writeBool(false);
+}
+
+bool StateDelta::decodePlayers(BitReader& reader, const NetBoardState& baseline, NetBoardState& state) {
+  const auto& before = baseline.players;
+  size_t b = 0;
+  size_t count = 0;
+  int previousId = -1;
+  const auto keep = [&](size_t run) {
+    for (; run > 0; --run) {
+      nextSlot(state.players, count) = before[b];
+      previousId = before[b++].id;
+    }
+  };
+
+  while (reader.readBool()) {
+    const uint32_t run = reader.readVarint(SMALL_GROUP);
+    if (run > before.size() - b) {
+      return false;
+    }
+    keep(run);
+
+    const auto op = static_cast<PlayerOp>(reader.readBits(2));
+    if (op == PlayerOp::Remove && b < before.size()) {
+      b++;
+    } else if (op == PlayerOp::Change && b < before.size()) {
+      NetPlayerState& player = nextSlot(state.players, count);
+      if (!decodePlayer(reader, &before[b], player)) {
+        return false;
+      }
+      player.id = before[b].id;
+      previousId = before[b++].id;
+    } else if (op == PlayerOp::Add) {
+      const int64_t id = static_cast<int64_t>(previousId) + 1 + reader.readVarint(SMALL_GROUP);
+      // ids only go up, and one the baseline has would be a Change
+      if (id > UINT16_MAX || (b < before.size() && id >= before[b].id)) {
+        return false;
+      }
+      NetPlayerState& player = nextSlot(state.players, count);
+      if (!decodePlayer(reader, nullptr, player)) {
+        return false;
+      }
+      player.id = static_cast<uint16_t>(id);
+      previousId = player.id;
+    } else {
+      return false;
+    }
+    if (!reader.succeeded()) {
+      return false;
+    }
+  }
+  keep(before.size() - b);
+  state.players.resize(count);
+  return reader.succeeded();
+}
+
+bool StateDelta::decodePlayer(BitReader& reader, const NetPlayerState* baseline, NetPlayerState& player) {
+  if (!baseline) {
+    if (!unpackFlags(static_cast<uint8_t>(reader.readBits(8)), player)) {
+      return false;
+    }
+    player.score = reader.readSignedVarint(LARGE_GROUP);
+    player.body.clear();
+    return !player.alive || decodeBody(reader, player.body);
+  }
+
+  const bool flagsChanged = reader.readBool();
+  if (!unpackFlags(flagsChanged ? static_cast<uint8_t>(reader.readBits(8)) : packFlags(*baseline), player)) {
+    return false;
+  }
+  player.score = baseline->score + (reader.readBool() ? reader.readSignedVarint(LARGE_GROUP) : 0);
+  if (!player.alive) {
+    player.body.clear();
+    return reader.succeeded();
+  }
+  if (!reader.readBool()) {
+    return decodeBody(reader, player.body);
+  }
+
+  const std::vector<sf::Vector2i>& before = baseline->body;
+  const uint32_t steps = reader.readVarint(SMALL_GROUP);
+  if (before.empty() || steps > MAX_DELTA_STEPS || reader.remainingBits() < steps * 2) {
+    return false;
+  }
+  // the new cells come first, then the length, so they are read into the front of the body once it is sized
+  sf::Vector2i cells[MAX_DELTA_STEPS];
+  sf::Vector2i cell = before.front();
+  for (uint32_t i = steps; i-- > 0;) {
+    cell += PackedSnakeBody::offset(static_cast<PackedSnakeBody::Step>(reader.readBits(2)));
+    cells[i] = cell;
+  }
+  const int64_t length = static_cast<int64_t>(before.size()) + reader.readSignedVarint(SMALL_GROUP);
+  if (!reader.succeeded() || length <= steps || length - steps > static_cast<int64_t>(before.size())) {
+    return false;
+  }
+  player.body.resize(static_cast<size_t>(length));
+  std::copy(cells, cells + steps, player.body.begin());
+  std::copy(before.begin(), before.begin() + (length - steps), player.body.begin() + steps);
+  return true;
+}
+
+bool StateDelta::decodeBody(BitReader& reader, std::vector<sf::Vector2i>& body) {
+  const uint32_t length = reader.readVarint(LARGE_GROUP);
+  const sf::Vector2i head = readCell(reader);
+  // two bits per segment after the head, so a damaged length cannot claim more than the packet holds
+  if (!reader.succeeded() || length == 0 || reader.remainingBits() < (static_cast<size_t>(length) - 1) * 2) {
+    return false;
+  }
+  body.resize(length);
+  body[0] = head;
+  for (size_t i = 1; i < length; ++i) {
+    body[i] = body[i - 1] + PackedSnakeBody::offset(static_cast<PackedSnakeBody::Step>(reader.readBits(2)));
+  }
+  return reader.succeeded();
+}
+
+bool StateDelta::decodeItems(BitReader& reader, const NetBoardState& baseline, NetBoardState& state) {
+  const auto& before = baseline.items;
+  size_t b = 0;
+  size_t count = 0;
+  const auto keep = [&](size_t run) {
+    for (; run > 0; --run) {
+      nextSlot(state.items, count) = before[b++];
+    }
+  };
+
+  while (reader.readBool()) {
+    const uint32_t run = reader.readVarint(SMALL_GROUP);
+    if (run > before.size() - b) {
+      return false;
+    }
+    keep(run);
+
+    if (static_cast<ItemOp>(reader.readBits(1)) == ItemOp::Remove) {
+      if (b == before.size()) {
+        return false;
+      }
+      b++;
+    } else {
+      NetItemState& item = nextSlot(state.items, count);
+      item.position = readCell(reader);
+      item.type = static_cast<GameItemType>(reader.readBits(2));
+    }
+    if (!reader.succeeded()) {
+      return false;
+    }
+  }
+  keep(before.size() - b);
+  state.items.resize(count);
+  return reader.succeeded();
+}
+
+bool StateDelta::decodeWalls(BitReader& reader, const NetBoardState& baseline, NetBoardState& state) {
+  const auto& before = baseline.walls;
+  size_t b = 0;
+  size_t count = 0;
+  const auto keep = [&](size_t run) {
+    for (; run > 0; --run) {
+      nextSlot(state.walls, count) = before[b++];
+    }
+  };
+  const auto readPhase = [&reader](WallPhase& phase) {
+    const uint32_t value = reader.readBits(2);
+    phase = static_cast<WallPhase>(value);
+    return value <= static_cast<uint32_t>(WallPhase::Disappearing);
+  };
+
+  while (reader.readBool()) {
+    const uint32_t run = reader.readVarint(SMALL_GROUP);
+    if (run > before.size() - b) {
+      return false;
+    }
+    keep(run);
+
+    const auto op = static_cast<WallOp>(reader.readBits(2));
+    if (op == WallOp::Remove && b < before.size()) {
+      b++;
+    } else if (op == WallOp::Phase && b < before.size()) {
+      NetWallState& wall = nextSlot(state.walls, count);
+      wall = before[b++];
+      if (!readPhase(wall.phase)) {
+        return false;
+      }
+    } else if (op == WallOp::Add) {
+      NetWallState& wall = nextSlot(state.walls, count);
+      wall.type = static_cast<Wall::WallType>(reader.readBits(2));
+      size_t cellCount = 0;
+      if (!readPhase(wall.phase) || !readCount(reader, cellCount)) {
+        return false;
+      }
+      wall.cells.resize(cellCount);
+      for (size_t i = 0; i < cellCount; ++i) {
+        if (i == 0) {
+          wall.cells[0] = readCell(reader);
+          continue;
+        }
+        const int32_t dx = reader.readSignedVarint(SMALL_GROUP);
+        const int32_t dy = reader.readSignedVarint(SMALL_GROUP);
+        wall.cells[i] = wall.cells[i - 1] + sf::Vector2i(dx, dy);
+      }
+    } else {
+      return false;
+    }
+    if (!reader.succeeded()) {
+      return false;
+    }
+  }
+  keep(before.size() - b);
+  state.walls.resize(count);
+  return reader.succeeded();
+}
+
+void StateDelta::writeCell(BitWriter& writer, sf::Vector2i cell) {
+  writer.writeVarint(static_cast<uint32_t>(cell.x), LARGE_GROUP);
+  writer.writeVarint(static_cast<uint32_t>(cell.y), LARGE_GROUP);
+}
+
+sf::Vector2i StateDelta::readCell(BitReader& reader) {
+  const auto x = static_cast<int32_t>(reader.readVarint(LARGE_GROUP));
+  const auto y = static_cast<int32_t>(reader.readVarint(LARGE_GROUP));
+  return sf::Vector2i(x, y);
+}
+
+bool StateDelta::readCount(BitReader& reader, size_t& count) {
+  count = reader.readVarint(SMALL_GROUP);
+  return reader.succeeded() && count <= reader.remainingBits();
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include "NetProtocol.hpp"
+#include "Packet.hpp"
+
+// Encodes a board as the changes from a baseline the client already has: players that joined, left or
+// changed, and for a snake that only moved, the steps its head took and how much its length changed, since
+// the rest of the body is the baseline's. Items go as the ones that expired and the ones that spawned, walls
+// the same plus their phase changes. An empty baseline gives the whole board, so full states and deltas
+// share one format. Both states must be in canonical order (players by id, items and walls as canonicalize
+// sorts them) so the client, merging the changes into its baseline, ends with the state the server encoded.
+class StateDelta {
+public:
+  // a snake further than this from its baseline goes whole
+  static constexpr int MAX_DELTA_STEPS = 64;
+
+  static void canonicalize(NetBoardState& state);
+
+  static void encode(BitWriter& writer, const NetBoardState& baseline, const NetBoardState& state);
+  // state must not be the baseline; state.tick is left as it was, the caller has it from the message header
+  static bool decode(BitReader& reader, const NetBoardState& baseline, NetBoardState& state);
+
+private:
+  static constexpr uint8_t ALIVE = 1;
+  static constexpr uint8_t INVINCIBLE = 2;
+  static constexpr uint8_t DISORIENTED = 4;
+  static constexpr int DIRECTION_SHIFT = 3;
+  static constexpr int SNAKE_TYPE_SHIFT = 5;
+
+  // varint group widths: counts, gaps and steps are usually tiny, coordinates and scores are not
+  static constexpr int SMALL_GROUP = 3;
+  static constexpr int LARGE_GROUP = 7;
+
+  static uint8_t packFlags(const NetPlayerState& player);
+  static bool unpackFlags(uint8_t flags, NetPlayerState& player);
+  static bool samePlayer(const NetPlayerState& a, const NetPlayerState& b);
+
+  static void encodePlayers(BitWriter& writer, const NetBoardState& baseline, const NetBoardState& state);
+  static void encodePlayer(BitWriter& writer, const NetPlayerState* baseline, const NetPlayerState& player);
+  // how many steps the head took since the baseline, nullopt when the body is not the baseline's moved on
+  static std::optional<size_t> findMoveSteps(const std::vector<sf::Vector2i>& baseline,
+                                             const std::vector<sf::Vector2i>& body);
+  static void encodeBody(BitWriter& writer, const std::vector<sf::Vector2i>& body);
+  static void encodeItems(BitWriter& writer, const NetBoardState& baseline, const NetBoardState& state);
+  static void encodeWalls(BitWriter& writer, const NetBoardState& baseline, const NetBoardState& state);
+
+  static bool decodePlayers(BitReader& reader, const NetBoardState& baseline, NetBoardState& state);
+  static bool decodePlayer(BitReader& reader, const NetPlayerState* baseline, NetPlayerState& player);
+  static bool decodeBody(BitReader& reader, std::vector<sf::Vector2i>& body);
+  static bool decodeItems(BitReader& reader, const NetBoardState& baseline, NetBoardState& state);
+  static bool decodeWalls(BitReader& reader, const NetBoardState& baseline, NetBoardState& state);
+
+  static void writeCell(BitWriter& writer, sf::Vector2i cell);
+  static sf::Vector2i readCell(BitReader& reader);
+  // a count or index list read from a damaged packet must not claim more entries than bits remain
+  static bool readCount(BitReader& reader, size_t& count);
+};
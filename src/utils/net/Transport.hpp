@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Address of one end of a transport: a mailbox number in process, an IPv4 address and port over UDP
+using EndpointId = uint64_t;
+
+// Unreliable, unordered datagrams between endpoints, like UDP: a send may be dropped, and receive never
+// blocks. The game server and clients only talk through this, so the same code runs in one process for
+// tests and load runs and across machines over sockets.
+class Transport {
+public:
+  virtual ~Transport() = default;
+
+  [[nodiscard]] virtual EndpointId getLocalEndpoint() const = 0;
+
+  // false when the datagram was not sent, for being too large or the network refusing it
+  virtual bool send(EndpointId to, std::span<const uint8_t> bytes) = 0;
+
+  // the next waiting datagram into bytes, reusing its capacity; false when nothing is waiting
+  virtual bool receive(EndpointId& from, std::vector<uint8_t>& bytes) = 0;
+};
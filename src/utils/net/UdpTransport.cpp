@@ -0,0 +1,157 @@
+#include "UdpTransport.hpp"
+#include "../Logger.hpp"
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+constexpr SocketHandle NO_SOCKET = INVALID_SOCKET;
+
+// Winsock is started once for the process and left running until it exits
+bool startSockets() {
+  static const bool started = [] {
+    WSADATA data;
+    return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+  }();
+  return started;
+}
+
+void closeSocket(SocketHandle handle) {
+  closesocket(handle);
+}
+
+bool setNonBlocking(SocketHandle handle) {
+  u_long enabled = 1;
+  return ioctlsocket(handle, FIONBIO, &enabled) == 0;
+}
+
+int lastSocketError() {
+  return WSAGetLastError();
+}
+#else
+using SocketHandle = int;
+constexpr SocketHandle NO_SOCKET = -1;
+
+bool startSockets() {
+  return true;
+}
+
+void closeSocket(SocketHandle handle) {
+  close(handle);
+}
+
+bool setNonBlocking(SocketHandle handle) {
+  const int flags = fcntl(handle, F_GETFL, 0);
+  return flags >= 0 && fcntl(handle, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+int lastSocketError() {
+  return errno;
+}
+#endif
+
+EndpointId toEndpoint(const sockaddr_in& address) {
+  return static_cast<EndpointId>(ntohl(address.sin_addr.s_addr)) << 16 | ntohs(address.sin_port);
+}
+
+sockaddr_in toAddress(EndpointId endpoint) {
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(static_cast<uint32_t>(endpoint >> 16));
+  address.sin_port = htons(static_cast<uint16_t>(endpoint & 0xFFFF));
+  return address;
+}
+}  // namespace
+
+std::unique_ptr<UdpTransport> UdpTransport::open(uint16_t port, bool allInterfaces) {
+  if (!startSockets()) {
+    LOG_ERROR("Failed to start the socket library");
+    return nullptr;
+  }
+
+  const SocketHandle handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (handle == NO_SOCKET) {
+    LOG_ERROR("Failed to open a UDP socket: error {}", lastSocketError());
+    return nullptr;
+  }
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(allInterfaces ? INADDR_ANY : INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  socklen_t addressSize = sizeof(address);
+  if (bind(handle, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+      getsockname(handle, reinterpret_cast<sockaddr*>(&address), &addressSize) != 0 || !setNonBlocking(handle)) {
+    LOG_ERROR("Failed to bind a UDP socket to port {}: error {}", port, lastSocketError());
+    closeSocket(handle);
+    return nullptr;
+  }
+
+  // a server broadcasting to hundreds of clients would otherwise drop datagrams in bursts
+  const int bufferBytes = 4 * 1024 * 1024;
+  setsockopt(handle, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&bufferBytes), sizeof(bufferBytes));
+  setsockopt(handle, SOL_SOCKET, SO_RCVBUF, reinterpret_cast<const char*>(&bufferBytes), sizeof(bufferBytes));
+
+  return std::unique_ptr<UdpTransport>(new UdpTransport(static_cast<intptr_t>(handle), toEndpoint(address)));
+}
+
+std::optional<EndpointId> UdpTransport::makeEndpoint(const std::string& host, uint16_t port) {
+  in_addr address{};
+  if (inet_pton(AF_INET, host.c_str(), &address) != 1) {
+    return std::nullopt;
+  }
+  return static_cast<EndpointId>(ntohl(address.s_addr)) << 16 | port;
+}
+
+EndpointId UdpTransport::loopbackEndpoint(uint16_t port) {
+  return static_cast<EndpointId>(INADDR_LOOPBACK) << 16 | port;
+}
+
+UdpTransport::~UdpTransport() {
+  closeSocket(static_cast<SocketHandle>(socketHandle));
+}
+
+bool UdpTransport::send(EndpointId to, std::span<const uint8_t> bytes) {
+  if (bytes.size() > MAX_DATAGRAM_BYTES) {
+    return false;
+  }
+
+  const sockaddr_in address = toAddress(to);
+  const auto sent = sendto(static_cast<SocketHandle>(socketHandle), reinterpret_cast<const char*>(bytes.data()),
+                           static_cast<int>(bytes.size()), 0, reinterpret_cast<const sockaddr*>(&address),
+                           sizeof(address));
+  return sent == static_cast<decltype(sent)>(bytes.size());
+}
+
+bool UdpTransport::receive(EndpointId& from, std::vector<uint8_t>& bytes) {
+  sockaddr_in address{};
+  while (true) {
+    socklen_t addressSize = sizeof(address);
+    const auto received =
+        recvfrom(static_cast<SocketHandle>(socketHandle), reinterpret_cast<char*>(receiveBuffer.data()),
+                 static_cast<int>(receiveBuffer.size()), 0, reinterpret_cast<sockaddr*>(&address), &addressSize);
+    if (received >= 0) {
+      bytes.assign(receiveBuffer.begin(), receiveBuffer.begin() + received);
+      from = toEndpoint(address);
+      return true;
+    }
+#ifdef _WIN32
+    // Windows reports a datagram an earlier send could not deliver as a reset on the next receive
+    if (WSAGetLastError() == WSAECONNRESET) {
+      continue;
+    }
+#endif
+    // would-block, or an error that leaves nothing to read either
+    return false;
+  }
+}
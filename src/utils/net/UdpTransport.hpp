@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "Transport.hpp"
+
+// Transport over a non-blocking IPv4 UDP socket. Endpoints are the address in the high bits and the port in
+// the low 16. By default the socket is bound to the loopback interface, which is what tests and load runs
+// use; a server meant for other machines listens on all interfaces.
+class UdpTransport final : public Transport {
+public:
+  static constexpr size_t MAX_DATAGRAM_BYTES = 65507;
+
+  // port 0 takes any free port; nullptr when the socket cannot be opened or bound
+  static std::unique_ptr<UdpTransport> open(uint16_t port, bool allInterfaces = false);
+
+  // nullopt unless host is a dotted IPv4 address
+  static std::optional<EndpointId> makeEndpoint(const std::string& host, uint16_t port);
+  static EndpointId loopbackEndpoint(uint16_t port);
+
+  UdpTransport(const UdpTransport&) = delete;
+  UdpTransport& operator=(const UdpTransport&) = delete;
+  ~UdpTransport() override;
+
+  [[nodiscard]] EndpointId getLocalEndpoint() const override { return localEndpoint; }
+  [[nodiscard]] uint16_t getPort() const { return static_cast<uint16_t>(localEndpoint & 0xFFFF); }
+
+  bool send(EndpointId to, std::span<const uint8_t> bytes) override;
+  bool receive(EndpointId& from, std::vector<uint8_t>& bytes) override;
+
+private:
+  // a SOCKET on Windows and a file descriptor elsewhere
+  intptr_t socketHandle;
+  EndpointId localEndpoint;
+  std::vector<uint8_t> receiveBuffer;
+
+  UdpTransport(intptr_t socketHandle, EndpointId localEndpoint)
+      : socketHandle(socketHandle), localEndpoint(localEndpoint), receiveBuffer(MAX_DATAGRAM_BYTES) {}
+};
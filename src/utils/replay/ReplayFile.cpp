@@ -0,0 +1,274 @@
+#include "ReplayFile.hpp"
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include "../Logger.hpp"
+#include "../ScoreLog.hpp"
+
+namespace {
+constexpr std::array<uint8_t, 4> REPLAY_MAGIC = {'S', 'N', 'K', 'R'};
+constexpr int INPUT_BITS = 3;
+constexpr size_t CHECKSUM_SIZE = 4;
+
+void writeLittleEndian(std::vector<uint8_t>& out, uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i) {
+    out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t checksum(const uint8_t* data, size_t size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+class ByteReader {
+public:
+  ByteReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+  bool readLittleEndian(uint64_t& value, size_t bytes) {
+    if (size - offset < bytes) {
+      return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < bytes; ++i) {
+      value |= static_cast<uint64_t>(data[offset++]) << (8 * i);
+    }
+    return true;
+  }
+
+  bool readVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (offset == size) {
+        return false;
+      }
+      const uint8_t byte = data[offset++];
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool readBytes(uint8_t* out, size_t count) {
+    if (size - offset < count) {
+      return false;
+    }
+    std::copy_n(data + offset, count, out);
+    offset += count;
+    return true;
+  }
+
+  [[nodiscard]] bool atEnd() const { return offset == size; }
+
+private:
+  const uint8_t* data;
+  size_t size;
+  size_t offset = 0;
+};
+}  // namespace
+
+std::vector<uint8_t> ReplayFile::encode(const Replay& replay) {
+  std::vector<uint8_t> out(REPLAY_MAGIC.begin(), REPLAY_MAGIC.end());
+  writeLittleEndian(out, FORMAT_VERSION, 2);
+  writeLittleEndian(out, replay.config.seed, 8);
+  out.push_back(static_cast<uint8_t>(replay.config.difficulty));
+  out.push_back(static_cast<uint8_t>(replay.config.snakeType));
+  writeVarint(out, static_cast<uint64_t>(std::max(0, replay.config.countdownSeconds)));
+
+  writeVarint(out, replay.events.size());
+  uint32_t previousTick = 0;
+  for (const auto& event : replay.events) {
+    const uint64_t delta = event.tick - previousTick;
+    writeVarint(out, (delta << INPUT_BITS) | static_cast<uint8_t>(event.input));
+    previousTick = event.tick;
+  }
+
+  writeVarint(out, replay.keyframes.size());
+  previousTick = 0;
+  for (const auto& keyframe : replay.keyframes) {
+    writeVarint(out, keyframe.tick - previousTick);
+    writeVarint(out, keyframe.state.size());
+    out.insert(out.end(), keyframe.state.begin(), keyframe.state.end());
+    previousTick = keyframe.tick;
+  }
+
+  writeVarint(out, replay.finalTick);
+  writeLittleEndian(out, replay.finalStateHash, 8);
+  writeLittleEndian(out, checksum(out.data(), out.size()), CHECKSUM_SIZE);
+  return out;
+}
+
+std::optional<Replay> ReplayFile::decode(const std::vector<uint8_t>& bytes) {
+  if (bytes.size() < REPLAY_MAGIC.size() + CHECKSUM_SIZE ||
+      !std::equal(REPLAY_MAGIC.begin(), REPLAY_MAGIC.end(), bytes.begin())) {
+    return std::nullopt;
+  }
+
+  const size_t payloadSize = bytes.size() - CHECKSUM_SIZE;
+  ByteReader checksumReader(bytes.data() + payloadSize, CHECKSUM_SIZE);
+  uint64_t storedChecksum = 0;
+  if (!checksumReader.readLittleEndian(storedChecksum, CHECKSUM_SIZE) ||
+      storedChecksum != checksum(bytes.data(), payloadSize)) {
+    return std::nullopt;
+  }
+
+  ByteReader reader(bytes.data() + REPLAY_MAGIC.size(), payloadSize - REPLAY_MAGIC.size());
+  uint64_t version = 0;
+  uint64_t difficulty = 0;
+  uint64_t snakeType = 0;
+  uint64_t countdownSeconds = 0;
+  Replay replay;
+
+  if (!reader.readLittleEndian(version, 2) || version != FORMAT_VERSION ||
+      !reader.readLittleEndian(replay.config.seed, 8) || !reader.readLittleEndian(difficulty, 1) ||
+      !reader.readLittleEndian(snakeType, 1) || !reader.readVarint(countdownSeconds)) {
+    return std::nullopt;
+  }
+  if (difficulty > static_cast<uint64_t>(GameDifficultyLevel::Hard) ||
+      snakeType > static_cast<uint64_t>(SnakeSprite::SnakeType::Black)) {
+    return std::nullopt;
+  }
+  replay.config.difficulty = static_cast<GameDifficultyLevel>(difficulty);
+  replay.config.snakeType = static_cast<SnakeSprite::SnakeType>(snakeType);
+  replay.config.countdownSeconds = static_cast<int>(countdownSeconds);
+
+  uint64_t eventCount = 0;
+  if (!reader.readVarint(eventCount) || eventCount > payloadSize) {
+    return std::nullopt;
+  }
+
+  replay.events.reserve(eventCount);
+  uint64_t tick = 0;
+  for (uint64_t i = 0; i < eventCount; ++i) {
+    uint64_t packed = 0;
+    if (!reader.readVarint(packed)) {
+      return std::nullopt;
+    }
+    const uint64_t input = packed & ((1u << INPUT_BITS) - 1);
+    if (input > static_cast<uint64_t>(ReplayInput::Countdown)) {
+      return std::nullopt;
+    }
+    tick += packed >> INPUT_BITS;
+    replay.events.push_back(ReplayEvent{static_cast<uint32_t>(tick), static_cast<ReplayInput>(input)});
+  }
+
+  uint64_t keyframeCount = 0;
+  if (!reader.readVarint(keyframeCount) || keyframeCount > payloadSize) {
+    return std::nullopt;
+  }
+
+  replay.keyframes.resize(keyframeCount);
+  tick = 0;
+  for (uint64_t i = 0; i < keyframeCount; ++i) {
+    uint64_t delta = 0;
+    uint64_t stateSize = 0;
+    if (!reader.readVarint(delta) || (i > 0 && delta == 0) || !reader.readVarint(stateSize) ||
+        stateSize > GameSnapshot::CAPACITY) {
+      return std::nullopt;
+    }
+    tick += delta;
+    replay.keyframes[i].tick = static_cast<uint32_t>(tick);
+    replay.keyframes[i].state.resize(stateSize);
+    if (!reader.readBytes(replay.keyframes[i].state.data(), stateSize)) {
+      return std::nullopt;
+    }
+  }
+
+  uint64_t finalTick = 0;
+  if (!reader.readVarint(finalTick) || !reader.readLittleEndian(replay.finalStateHash, 8) || !reader.atEnd()) {
+    return std::nullopt;
+  }
+  replay.finalTick = static_cast<uint32_t>(finalTick);
+  return replay;
+}
+
+bool ReplayFile::save(const Replay& replay, const std::string& path) {
+  const std::vector<uint8_t> bytes = encode(replay);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open()) {
+    LOG_WARN("Failed to create replay '{}'", path);
+    return false;
+  }
+  file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  return static_cast<bool>(file.flush());
+}
+
+std::optional<Replay> ReplayFile::load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    LOG_WARN("Failed to open replay '{}'", path);
+    return std::nullopt;
+  }
+
+  const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  auto replay = decode(bytes);
+  if (!replay) {
+    LOG_WARN("Replay '{}' is corrupt or has an unknown format", path);
+  }
+  return replay;
+}
+
+std::optional<std::string> ReplayFile::saveSession(const Replay& replay) {
+  std::error_code error;
+  std::filesystem::create_directories(DIRECTORY, error);
+
+  const std::string path =
+      std::string(DIRECTORY) + "/" + std::to_string(ScoreLog::currentTimestamp()) + EXTENSION;
+  if (!save(replay, path)) {
+    return std::nullopt;
+  }
+
+  pruneDirectory();
+  return path;
+}
+
+void ReplayFile::captureKeyframe(Replay& replay, const GameSimulation& simulation) {
+  const uint32_t tick = simulation.getTick();
+  if (tick == 0 || tick % KEYFRAME_INTERVAL_TICKS != 0 ||
+      (!replay.keyframes.empty() && replay.keyframes.back().tick >= tick)) {
+    return;
+  }
+
+  GameSnapshot snapshot;
+  if (!simulation.saveSnapshot(snapshot)) {
+    return;
+  }
+  replay.keyframes.push_back(
+      ReplayKeyframe{tick, std::vector<uint8_t>(snapshot.bytes.begin(), snapshot.bytes.begin() + snapshot.size)});
+}
+
+void ReplayFile::pruneDirectory() {
+  std::error_code error;
+  std::vector<std::filesystem::path> replays;
+  for (const auto& entry : std::filesystem::directory_iterator(DIRECTORY, error)) {
+    if (entry.is_regular_file() && entry.path().extension() == EXTENSION) {
+      replays.push_back(entry.path());
+    }
+  }
+  if (replays.size() <= MAX_KEPT_REPLAYS) {
+    return;
+  }
+
+  // names are unix timestamps of equal width, so name order is age order
+  std::sort(replays.begin(), replays.end());
+  for (size_t i = 0; i + MAX_KEPT_REPLAYS < replays.size(); ++i) {
+    std::filesystem::remove(replays[i], error);
+  }
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../../GameSimulation.hpp"
+
+enum class ReplayInput : uint8_t { Up, Down, Left, Right, Countdown };
+
+struct ReplayEvent {
+  uint32_t tick = 0;
+  ReplayInput input = ReplayInput::Up;
+};
+
+// full simulation state at a tick, taken before that tick's inputs are applied
+struct ReplayKeyframe {
+  uint32_t tick = 0;
+  std::vector<uint8_t> state;
+};
+
+struct Replay {
+  SimulationConfig config;
+  std::vector<ReplayEvent> events;
+  std::vector<ReplayKeyframe> keyframes;
+  uint32_t finalTick = 0;
+  uint64_t finalStateHash = 0;
+};
+
+// A replay stores only what the simulation cannot derive itself: the seed, the settings that shape
+// the rules and the inputs. Each event is one varint of (tick delta << 3 | input), so a key press a
+// few seconds after the previous one costs two bytes. A snapshot of the whole state is added every
+// KEYFRAME_INTERVAL_TICKS so a player can seek without simulating from the first tick; at one per
+// minute they cost about as much as the inputs and bound a seek to a minute of headless simulation.
+class ReplayFile {
+public:
+  // also bumped when the rules change, since old inputs no longer reproduce the game they were recorded in
+  static constexpr uint16_t FORMAT_VERSION = 5;
+  static constexpr uint32_t KEYFRAME_INTERVAL_TICKS = 60 * GameSimulation::TICKS_PER_SECOND;
+  static constexpr const char* DIRECTORY = "replays";
+  static constexpr const char* EXTENSION = ".snkr";
+  static constexpr size_t MAX_KEPT_REPLAYS = 20;
+
+  static std::vector<uint8_t> encode(const Replay& replay);
+  static std::optional<Replay> decode(const std::vector<uint8_t>& bytes);
+
+  static bool save(const Replay& replay, const std::string& path);
+  static std::optional<Replay> load(const std::string& path);
+
+  // writes replays/<timestamp>.snkr and drops the oldest files beyond MAX_KEPT_REPLAYS
+  static std::optional<std::string> saveSession(const Replay& replay);
+
+  // appends a keyframe when the simulation has just reached a multiple of KEYFRAME_INTERVAL_TICKS
+  static void captureKeyframe(Replay& replay, const GameSimulation& simulation);
+
+private:
+  static void pruneDirectory();
+};
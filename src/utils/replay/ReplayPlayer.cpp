@@ -0,0 +1,113 @@
+#include "ReplayPlayer.hpp"
+#include <algorithm>
+#include <cstring>
+
+ReplayPlayer::ReplayPlayer(const Replay& replay, std::pmr::memory_resource* resource)
+    : replay(replay), resource(resource) {
+  keyframeEvents.reserve(replay.keyframes.size());
+  for (const auto& keyframe : replay.keyframes) {
+    const auto event = std::lower_bound(replay.events.begin(), replay.events.end(), keyframe.tick,
+                                        [](const ReplayEvent& e, uint32_t tick) { return e.tick < tick; });
+    keyframeEvents.push_back(static_cast<size_t>(event - replay.events.begin()));
+  }
+  restart();
+}
+
+void ReplayPlayer::restart() {
+  simulation = std::make_unique<GameSimulation>(replay.config, resource);
+  nextEvent = 0;
+}
+
+bool ReplayPlayer::isFinished() const {
+  return simulation->getTick() >= replay.finalTick || simulation->isGameOver();
+}
+
+void ReplayPlayer::seek(uint32_t tick) {
+  tick = std::min(tick, replay.finalTick);
+
+  const auto after = std::upper_bound(replay.keyframes.begin(), replay.keyframes.end(), tick,
+                                      [](uint32_t t, const ReplayKeyframe& keyframe) { return t < keyframe.tick; });
+  const size_t keyframeIndex = static_cast<size_t>(after - replay.keyframes.begin());
+  const uint32_t keyframeTick = keyframeIndex > 0 ? replay.keyframes[keyframeIndex - 1].tick : 0;
+
+  // going forward from the current tick is cheaper than restoring whenever no keyframe lies in between
+  const uint32_t current = simulation->getTick();
+  if (current > tick || current < keyframeTick) {
+    if (keyframeIndex == 0 || !restoreKeyframe(keyframeIndex - 1)) {
+      restart();
+    }
+  }
+
+  advance(tick - simulation->getTick());
+}
+
+void ReplayPlayer::advance(uint32_t ticks) {
+  for (uint32_t i = 0; i < ticks && !isFinished(); ++i) {
+    while (nextEvent < replay.events.size() && replay.events[nextEvent].tick <= simulation->getTick()) {
+      applyInput(*simulation, replay.events[nextEvent].input);
+      nextEvent++;
+    }
+    simulation->tick();
+  }
+}
+
+bool ReplayPlayer::restoreKeyframe(size_t index) {
+  const ReplayKeyframe& keyframe = replay.keyframes[index];
+  scratch.size = static_cast<uint32_t>(keyframe.state.size());
+  std::copy(keyframe.state.begin(), keyframe.state.end(), scratch.bytes.begin());
+
+  // a keyframe that fails half way leaves the simulation undefined, so it is rebuilt from scratch
+  if (!simulation->restoreSnapshot(scratch) || simulation->getTick() != keyframe.tick) {
+    return false;
+  }
+  nextEvent = keyframeEvents[index];
+  return true;
+}
+
+bool ReplayPlayer::matchesKeyframe(const ReplayKeyframe& keyframe) {
+  return simulation->saveSnapshot(scratch) && scratch.size == keyframe.state.size() &&
+         std::memcmp(scratch.bytes.data(), keyframe.state.data(), scratch.size) == 0;
+}
+
+void ReplayPlayer::applyInput(GameSimulation& simulation, ReplayInput input) {
+  switch (input) {
+    case ReplayInput::Up:
+      simulation.setDirection(Snake::Direction::Up);
+      break;
+    case ReplayInput::Down:
+      simulation.setDirection(Snake::Direction::Down);
+      break;
+    case ReplayInput::Left:
+      simulation.setDirection(Snake::Direction::Left);
+      break;
+    case ReplayInput::Right:
+      simulation.setDirection(Snake::Direction::Right);
+      break;
+    case ReplayInput::Countdown:
+      simulation.startCountdown();
+      break;
+  }
+}
+
+ReplayResult ReplayPlayer::play(const Replay& replay) {
+  ReplayPlayer player(replay);
+  ReplayResult result;
+
+  for (const auto& keyframe : replay.keyframes) {
+    player.advance(keyframe.tick - std::min(keyframe.tick, player.getTick()));
+    if (player.getTick() != keyframe.tick) {
+      break;
+    }
+    if (!result.divergedAtTick && !player.matchesKeyframe(keyframe)) {
+      result.divergedAtTick = keyframe.tick;
+    }
+  }
+  player.advance(replay.finalTick - std::min(replay.finalTick, player.getTick()));
+
+  const GameSimulation& simulation = player.getSimulation();
+  result.ticks = simulation.getTick();
+  result.score = simulation.getScore();
+  result.stateHash = simulation.computeStateHash();
+  result.matches = result.ticks == replay.finalTick && result.stateHash == replay.finalStateHash;
+  return result;
+}
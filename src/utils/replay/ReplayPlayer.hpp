@@ -0,0 +1,53 @@
+#pragma once
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include "ReplayFile.hpp"
+
+struct ReplayResult {
+  uint32_t ticks = 0;
+  int score = 0;
+  uint64_t stateHash = 0;
+  bool matches = false;
+  // first keyframe whose recorded state differs from the re-simulated one
+  std::optional<uint32_t> divergedAtTick;
+};
+
+// Drives a simulation through a replay without a window. Seeking restores the closest keyframe at or
+// before the target and simulates the rest, so its cost is bounded by the keyframe interval rather
+// than by the length of the replay. The replay must outlive the player.
+class ReplayPlayer {
+public:
+  // the simulation allocates its walls and items from resource
+  explicit ReplayPlayer(const Replay& replay, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+  void seek(uint32_t tick);
+
+  // simulates up to ticks more, stopping early at the end of the replay
+  void advance(uint32_t ticks);
+
+  [[nodiscard]] uint32_t getTick() const { return simulation->getTick(); }
+  [[nodiscard]] bool isFinished() const;
+
+  [[nodiscard]] GameSimulation& getSimulation() { return *simulation; }
+  [[nodiscard]] const GameSimulation& getSimulation() const { return *simulation; }
+
+  // the one place that turns a recorded input into a simulation call, shared by live play and replays
+  static void applyInput(GameSimulation& simulation, ReplayInput input);
+
+  // runs the whole replay, checking every keyframe on the way, and compares the end state with the recorded hash
+  static ReplayResult play(const Replay& replay);
+
+private:
+  const Replay& replay;
+  std::pmr::memory_resource* resource;
+  std::unique_ptr<GameSimulation> simulation;
+  size_t nextEvent = 0;
+  // index of the first event at or after each keyframe, built once so a seek needs no event scan
+  std::vector<size_t> keyframeEvents;
+  GameSnapshot scratch;
+
+  void restart();
+  bool restoreKeyframe(size_t index);
+  bool matchesKeyframe(const ReplayKeyframe& keyframe);
+};
@@ -0,0 +1,201 @@
+// Keeps game_bench runs by git commit and checks a run against a baseline for regressions. For every
+// benchmark in both runs the per-sample timings are compared with a Mann-Whitney U test, and the change is
+// estimated as a Hodges-Lehmann ratio with a confidence interval (see BenchStats.hpp). A benchmark counts
+// as a regression when the runs differ at --alpha and the estimated slowdown exceeds --threshold percent.
+// Run from the repository root:
+//
+//   bench_compare store <run.json> <commit> [--history dir]
+//   bench_compare compare <baseline> <candidate> [--filter regex] [--threshold percent] [--alpha p]
+//                 [--confidence c] [--history dir]
+//
+// A baseline or candidate is either a JSON file or a commit stored earlier. The default filter keeps the
+// game loop's hot paths in Snake, WallManager and GameItemManager. compare exits 1 on a regression and 2 on
+// bad arguments or an unreadable run.
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <regex>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "BenchStats.hpp"
+
+namespace {
+constexpr const char* DEFAULT_HISTORY = "bench_history";
+constexpr const char* DEFAULT_FILTER = "^(Snake|WallManager|GameItemManager)::";
+
+struct Options {
+  std::string command;
+  std::vector<std::string> positional;
+  std::string history = DEFAULT_HISTORY;
+  std::string filter = DEFAULT_FILTER;
+  double thresholdPercent = 5.0;
+  double alpha = 0.01;
+  double confidence = 0.99;
+};
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+  if (argc < 2) {
+    return false;
+  }
+  options.command = argv[1];
+  for (int i = 2; i < argc; ++i) {
+    const std::string argument = argv[i];
+    if (argument.rfind("--", 0) != 0) {
+      options.positional.push_back(argument);
+      continue;
+    }
+    if (i + 1 >= argc) {
+      return false;
+    }
+    const std::string value = argv[++i];
+    if (argument == "--history") {
+      options.history = value;
+    } else if (argument == "--filter") {
+      options.filter = value;
+    } else if (argument == "--threshold") {
+      options.thresholdPercent = std::stod(value);
+    } else if (argument == "--alpha") {
+      options.alpha = std::stod(value);
+    } else if (argument == "--confidence") {
+      options.confidence = std::stod(value);
+    } else {
+      return false;
+    }
+  }
+  return (options.command == "store" || options.command == "compare") && options.positional.size() == 2;
+}
+
+std::string historyPath(const Options& options, const std::string& commit) {
+  return (std::filesystem::path(options.history) / (commit + ".json")).string();
+}
+
+std::optional<nlohmann::json> loadRun(const Options& options, const std::string& fileOrCommit) {
+  const std::string path = std::filesystem::is_regular_file(fileOrCommit) ? fileOrCommit
+                                                                           : historyPath(options, fileOrCommit);
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    std::fprintf(stderr, "No benchmark run at %s\n", path.c_str());
+    return std::nullopt;
+  }
+
+  try {
+    nlohmann::json run = nlohmann::json::parse(file);
+    if (!run.contains("benchmarks") || !run["benchmarks"].is_array()) {
+      std::fprintf(stderr, "%s has no benchmarks array\n", path.c_str());
+      return std::nullopt;
+    }
+    return run;
+  } catch (const nlohmann::json::exception& e) {
+    std::fprintf(stderr, "Failed to parse %s: %s\n", path.c_str(), e.what());
+    return std::nullopt;
+  }
+}
+
+int store(const Options& options) {
+  const std::string& runPath = options.positional[0];
+  const std::string& commit = options.positional[1];
+  auto run = loadRun(options, runPath);
+  if (!run) {
+    return 2;
+  }
+
+  std::error_code error;
+  std::filesystem::create_directories(options.history, error);
+  const std::string path = historyPath(options, commit);
+  if (std::filesystem::exists(path)) {
+    std::printf("Replacing the run stored for %s\n", commit.c_str());
+  }
+
+  (*run)["commit"] = commit;
+  std::ofstream file(path, std::ios::trunc);
+  file << run->dump(2) << '\n';
+  if (!file) {
+    std::fprintf(stderr, "Failed to write %s\n", path.c_str());
+    return 2;
+  }
+  std::printf("Stored %zu benchmarks for %s in %s\n", (*run)["benchmarks"].size(), commit.c_str(), path.c_str());
+  return 0;
+}
+
+const nlohmann::json* findBenchmark(const nlohmann::json& run, const std::string& name) {
+  for (const auto& benchmark : run["benchmarks"]) {
+    if (benchmark.value("name", "") == name) {
+      return &benchmark;
+    }
+  }
+  return nullptr;
+}
+
+std::vector<double> getSamples(const nlohmann::json& benchmark) {
+  return benchmark.value("samples_ns", std::vector<double>{});
+}
+
+int compare(const Options& options) {
+  const auto baseline = loadRun(options, options.positional[0]);
+  const auto candidate = loadRun(options, options.positional[1]);
+  if (!baseline || !candidate) {
+    return 2;
+  }
+
+  const std::regex filter(options.filter);
+  const double regressionRatio = 1.0 + options.thresholdPercent / 100.0;
+  int compared = 0;
+  int regressions = 0;
+
+  std::printf("%-48s %11s %11s %8s %19s %9s  %s\n", "benchmark", "base ns", "new ns", "change", "interval", "p",
+              "verdict");
+  for (const auto& benchmark : (*candidate)["benchmarks"]) {
+    const std::string name = benchmark.value("name", "");
+    if (!std::regex_search(name, filter)) {
+      continue;
+    }
+
+    const nlohmann::json* base = findBenchmark(*baseline, name);
+    const std::vector<double> candidateSamples = getSamples(benchmark);
+    const std::vector<double> baselineSamples = base ? getSamples(*base) : std::vector<double>{};
+    if (baselineSamples.empty() || candidateSamples.empty()) {
+      std::printf("%-48s %11s %11.1f %8s %19s %9s  %s\n", name.c_str(), "-", benchmark.value("median_ns", 0.0), "-",
+                  "-", "-", base ? "no samples" : "new");
+      continue;
+    }
+
+    const BenchComparison result = benchstats::compare(baselineSamples, candidateSamples, options.confidence);
+    const bool significant = result.pValue < options.alpha;
+    const bool regression = significant && result.ratio > regressionRatio;
+    const char* verdict = regression ? "REGRESSION" : !significant ? "same" : result.ratio > 1.0 ? "slower" : "faster";
+    compared++;
+    regressions += regression ? 1 : 0;
+
+    char interval[32];
+    std::snprintf(interval, sizeof(interval), "[%+.1f%%, %+.1f%%]", (result.ratioLower - 1.0) * 100.0,
+                  (result.ratioUpper - 1.0) * 100.0);
+    std::printf("%-48s %11.1f %11.1f %+7.1f%% %19s %9.2g  %s\n", name.c_str(), base->value("median_ns", 0.0),
+                benchmark.value("median_ns", 0.0), (result.ratio - 1.0) * 100.0, interval, result.pValue, verdict);
+  }
+
+  std::printf("%d compared, %d regression(s) above %.1f%% at alpha %.3g, intervals at %.0f%% confidence\n", compared,
+              regressions, options.thresholdPercent, options.alpha, options.confidence * 100.0);
+  return regressions > 0 ? 1 : 0;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  bool valid = false;
+  try {
+    valid = parseOptions(argc, argv, options);
+    (void)std::regex(options.filter);
+  } catch (const std::exception&) {
+    valid = false;
+  }
+  if (!valid) {
+    std::fprintf(stderr, "usage: bench_compare store <run.json> <commit> [--history dir]\n"
+                         "       bench_compare compare <baseline> <candidate> [--filter regex] "
+                         "[--threshold percent] [--alpha p] [--confidence c] [--history dir]\n");
+    return 2;
+  }
+
+  return options.command == "store" ? store(options) : compare(options);
+}
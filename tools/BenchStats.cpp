@@ -0,0 +1,133 @@
+#include "BenchStats.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+constexpr double MIN_SAMPLE_NS = 1e-3;
+
+double normalCdf(double x) {
+  return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+std::vector<double> logSamples(const std::vector<double>& samples) {
+  std::vector<double> logs;
+  logs.reserve(samples.size());
+  for (const double sample : samples) {
+    logs.push_back(std::log(std::max(sample, MIN_SAMPLE_NS)));
+  }
+  return logs;
+}
+
+double selectNth(std::vector<double>& values, size_t index) {
+  std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+  return values[index];
+}
+}  // namespace
+
+namespace benchstats {
+
+double mannWhitneyPValue(const std::vector<double>& baseline, const std::vector<double>& candidate) {
+  const size_t n1 = baseline.size();
+  const size_t n2 = candidate.size();
+  if (n1 == 0 || n2 == 0) {
+    return 1.0;
+  }
+
+  std::vector<std::pair<double, bool>> pooled;
+  pooled.reserve(n1 + n2);
+  for (const double value : baseline) {
+    pooled.emplace_back(value, true);
+  }
+  for (const double value : candidate) {
+    pooled.emplace_back(value, false);
+  }
+  std::sort(pooled.begin(), pooled.end());
+
+  // average ranks across ties; the tie term shrinks the variance of U accordingly
+  double baselineRankSum = 0.0;
+  double tieTerm = 0.0;
+  for (size_t start = 0; start < pooled.size();) {
+    size_t end = start + 1;
+    while (end < pooled.size() && pooled[end].first == pooled[start].first) {
+      end++;
+    }
+    const double rank = (static_cast<double>(start + 1) + static_cast<double>(end)) / 2.0;
+    for (size_t i = start; i < end; ++i) {
+      if (pooled[i].second) {
+        baselineRankSum += rank;
+      }
+    }
+    const auto tied = static_cast<double>(end - start);
+    tieTerm += tied * tied * tied - tied;
+    start = end;
+  }
+
+  const auto a = static_cast<double>(n1);
+  const auto b = static_cast<double>(n2);
+  const double n = a + b;
+  const double u = baselineRankSum - a * (a + 1.0) / 2.0;
+  const double mean = a * b / 2.0;
+  const double variance = a * b / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0)));
+  if (variance <= 0.0) {
+    return 1.0;
+  }
+
+  const double z = std::max(0.0, std::abs(u - mean) - 0.5) / std::sqrt(variance);
+  return std::min(1.0, 2.0 * (1.0 - normalCdf(z)));
+}
+
+double normalQuantile(double probability) {
+  double low = -40.0;
+  double high = 40.0;
+  for (int i = 0; i < 200; ++i) {
+    const double middle = (low + high) / 2.0;
+    if (normalCdf(middle) < probability) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return (low + high) / 2.0;
+}
+
+BenchComparison compare(const std::vector<double>& baseline, const std::vector<double>& candidate,
+                        double confidence) {
+  BenchComparison comparison;
+  if (baseline.empty() || candidate.empty()) {
+    return comparison;
+  }
+
+  const std::vector<double> baselineLogs = logSamples(baseline);
+  const std::vector<double> candidateLogs = logSamples(candidate);
+  comparison.pValue = mannWhitneyPValue(baselineLogs, candidateLogs);
+
+  // Hodges-Lehmann: the median of all pairwise differences, and the order statistics of those differences
+  // that bound it at the requested confidence
+  std::vector<double> differences;
+  differences.reserve(baselineLogs.size() * candidateLogs.size());
+  for (const double c : candidateLogs) {
+    for (const double b : baselineLogs) {
+      differences.push_back(c - b);
+    }
+  }
+
+  const auto pairs = static_cast<double>(differences.size());
+  const auto a = static_cast<double>(baselineLogs.size());
+  const auto b = static_cast<double>(candidateLogs.size());
+  const double z = normalQuantile(1.0 - (1.0 - confidence) / 2.0);
+  const double bound = std::floor(pairs / 2.0 - z * std::sqrt(a * b * (a + b + 1.0) / 12.0));
+  const auto lowerIndex = static_cast<size_t>(std::clamp(bound, 0.0, pairs - 1.0));
+  const size_t upperIndex = differences.size() - 1 - lowerIndex;
+
+  const double median = differences.size() % 2 == 1
+                            ? selectNth(differences, differences.size() / 2)
+                            : (selectNth(differences, differences.size() / 2 - 1) +
+                               selectNth(differences, differences.size() / 2)) /
+                                  2.0;
+  comparison.ratio = std::exp(median);
+  comparison.ratioLower = std::exp(selectNth(differences, lowerIndex));
+  comparison.ratioUpper = std::exp(selectNth(differences, upperIndex));
+  return comparison;
+}
+
+}  // namespace benchstats
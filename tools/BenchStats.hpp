@@ -0,0 +1,26 @@
+#pragma once
+#include <vector>
+
+// Distribution-free comparison of two benchmark sample sets. Timings are skewed and heavy-tailed, so no
+// normality is assumed: the Mann-Whitney U test decides whether the runs differ at all, and the
+// Hodges-Lehmann estimator gives the size of the change with a confidence interval. Both work on log
+// timings, which turns the shift into a ratio between the runs.
+struct BenchComparison {
+  double ratio = 1.0;  // candidate / baseline, so above 1 is slower
+  double ratioLower = 1.0;
+  double ratioUpper = 1.0;
+  double pValue = 1.0;  // two-sided
+};
+
+namespace benchstats {
+
+// two-sided p-value of the U test, normal approximation with tie and continuity corrections
+double mannWhitneyPValue(const std::vector<double>& baseline, const std::vector<double>& candidate);
+
+// quantile of the standard normal distribution
+double normalQuantile(double probability);
+
+BenchComparison compare(const std::vector<double>& baseline, const std::vector<double>& candidate,
+                        double confidence);
+
+}  // namespace benchstats
@@ -0,0 +1,198 @@
+#include "CmaEs.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+constexpr double PI = 3.14159265358979323846;
+constexpr int MAX_JACOBI_SWEEPS = 50;
+}  // namespace
+
+CmaEs::CmaEs(const Vector& initialMean, double initialSigma, int populationSize, uint64_t seed)
+    : dimension(initialMean.size()),
+      lambda(populationSize),
+      mu(populationSize / 2),
+      mean(initialMean),
+      sigma(initialSigma),
+      pathC(dimension, 0.0),
+      pathSigma(dimension, 0.0),
+      covariance(dimension * dimension, 0.0),
+      eigenVectors(dimension * dimension, 0.0),
+      eigenValuesSqrt(dimension, 1.0),
+      population(static_cast<size_t>(populationSize), Vector(dimension)),
+      steps(static_cast<size_t>(populationSize), Vector(dimension)),
+      random(seed) {
+  for (size_t i = 0; i < dimension; ++i) {
+    covariance[i * dimension + i] = 1.0;
+    eigenVectors[i * dimension + i] = 1.0;
+  }
+
+  for (int i = 0; i < mu; ++i) {
+    weights.push_back(std::log(mu + 0.5) - std::log(i + 1.0));
+  }
+  const double weightSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+  double squareSum = 0.0;
+  for (auto& weight : weights) {
+    weight /= weightSum;
+    squareSum += weight * weight;
+  }
+  muEffective = 1.0 / squareSum;
+
+  const auto n = static_cast<double>(dimension);
+  cc = (4.0 + muEffective / n) / (n + 4.0 + 2.0 * muEffective / n);
+  cs = (muEffective + 2.0) / (n + muEffective + 5.0);
+  c1 = 2.0 / ((n + 1.3) * (n + 1.3) + muEffective);
+  cmu = std::min(1.0 - c1, 2.0 * (muEffective - 2.0 + 1.0 / muEffective) / ((n + 2.0) * (n + 2.0) + muEffective));
+  damps = 1.0 + 2.0 * std::max(0.0, std::sqrt((muEffective - 1.0) / (n + 1.0)) - 1.0) + cs;
+  chiN = std::sqrt(n) * (1.0 - 1.0 / (4.0 * n) + 1.0 / (21.0 * n * n));
+}
+
+const std::vector<CmaEs::Vector>& CmaEs::sample() {
+  Vector z(dimension);
+  for (int k = 0; k < lambda; ++k) {
+    for (size_t i = 0; i < dimension; ++i) {
+      z[i] = eigenValuesSqrt[i] * nextGaussian();
+    }
+    for (size_t row = 0; row < dimension; ++row) {
+      double step = 0.0;
+      for (size_t column = 0; column < dimension; ++column) {
+        step += eigenVectors[row * dimension + column] * z[column];
+      }
+      steps[k][row] = step;
+      population[k][row] = mean[row] + sigma * step;
+    }
+  }
+  return population;
+}
+
+void CmaEs::update(const std::vector<double>& losses) {
+  std::vector<size_t> order(static_cast<size_t>(lambda));
+  std::iota(order.begin(), order.end(), 0);
+  // ties broken by index so the ranking never depends on the sort implementation
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return losses[a] < losses[b] || (losses[a] == losses[b] && a < b);
+  });
+
+  Vector meanStep(dimension, 0.0);
+  for (int i = 0; i < mu; ++i) {
+    for (size_t d = 0; d < dimension; ++d) {
+      meanStep[d] += weights[i] * steps[order[i]][d];
+    }
+  }
+  for (size_t d = 0; d < dimension; ++d) {
+    mean[d] += sigma * meanStep[d];
+  }
+
+  // C^-1/2 * meanStep = B * D^-1 * B^T * meanStep
+  Vector projected(dimension, 0.0);
+  for (size_t column = 0; column < dimension; ++column) {
+    double sum = 0.0;
+    for (size_t row = 0; row < dimension; ++row) {
+      sum += eigenVectors[row * dimension + column] * meanStep[row];
+    }
+    projected[column] = sum / eigenValuesSqrt[column];
+  }
+  const double sigmaRate = std::sqrt(cs * (2.0 - cs) * muEffective);
+  for (size_t row = 0; row < dimension; ++row) {
+    double sum = 0.0;
+    for (size_t column = 0; column < dimension; ++column) {
+      sum += eigenVectors[row * dimension + column] * projected[column];
+    }
+    pathSigma[row] = (1.0 - cs) * pathSigma[row] + sigmaRate * sum;
+  }
+
+  generation++;
+  double pathSigmaNorm = 0.0;
+  for (const double value : pathSigma) {
+    pathSigmaNorm += value * value;
+  }
+  pathSigmaNorm = std::sqrt(pathSigmaNorm);
+  const double stallCorrection = std::sqrt(1.0 - std::pow(1.0 - cs, 2.0 * generation));
+  const bool stepIsTrusted =
+      pathSigmaNorm / stallCorrection / chiN < 1.4 + 2.0 / (static_cast<double>(dimension) + 1.0);
+
+  const double covarianceRate = std::sqrt(cc * (2.0 - cc) * muEffective);
+  for (size_t d = 0; d < dimension; ++d) {
+    pathC[d] = (1.0 - cc) * pathC[d] + (stepIsTrusted ? covarianceRate * meanStep[d] : 0.0);
+  }
+
+  const double keep = 1.0 - c1 - cmu + (stepIsTrusted ? 0.0 : c1 * cc * (2.0 - cc));
+  for (size_t row = 0; row < dimension; ++row) {
+    for (size_t column = 0; column <= row; ++column) {
+      double rankMu = 0.0;
+      for (int i = 0; i < mu; ++i) {
+        rankMu += weights[i] * steps[order[i]][row] * steps[order[i]][column];
+      }
+      const double value = keep * covariance[row * dimension + column] + c1 * pathC[row] * pathC[column] + cmu * rankMu;
+      covariance[row * dimension + column] = value;
+      covariance[column * dimension + row] = value;
+    }
+  }
+
+  sigma *= std::exp((cs / damps) * (pathSigmaNorm / chiN - 1.0));
+  decompose();
+}
+
+double CmaEs::nextGaussian() {
+  // 1 - u keeps the logarithm away from zero
+  const double u = 1.0 - static_cast<double>(random() >> 11) * (1.0 / 9007199254740992.0);
+  const double v = static_cast<double>(random() >> 11) * (1.0 / 9007199254740992.0);
+  return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * PI * v);
+}
+
+// cyclic Jacobi rotations; the matrices here are a dozen rows, where this is exact enough and simple
+void CmaEs::decompose() {
+  Vector matrix = covariance;
+  std::fill(eigenVectors.begin(), eigenVectors.end(), 0.0);
+  for (size_t i = 0; i < dimension; ++i) {
+    eigenVectors[i * dimension + i] = 1.0;
+  }
+
+  for (int sweep = 0; sweep < MAX_JACOBI_SWEEPS; ++sweep) {
+    double offDiagonal = 0.0;
+    for (size_t p = 0; p < dimension; ++p) {
+      for (size_t q = p + 1; q < dimension; ++q) {
+        offDiagonal += matrix[p * dimension + q] * matrix[p * dimension + q];
+      }
+    }
+    if (offDiagonal < 1e-30) {
+      break;
+    }
+
+    for (size_t p = 0; p < dimension; ++p) {
+      for (size_t q = p + 1; q < dimension; ++q) {
+        const double apq = matrix[p * dimension + q];
+        if (std::abs(apq) < 1e-300) {
+          continue;
+        }
+        const double theta = (matrix[q * dimension + q] - matrix[p * dimension + p]) / (2.0 * apq);
+        const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+        const double c = 1.0 / std::sqrt(t * t + 1.0);
+        const double s = t * c;
+
+        for (size_t k = 0; k < dimension; ++k) {
+          const double akp = matrix[k * dimension + p];
+          const double akq = matrix[k * dimension + q];
+          matrix[k * dimension + p] = c * akp - s * akq;
+          matrix[k * dimension + q] = s * akp + c * akq;
+        }
+        for (size_t k = 0; k < dimension; ++k) {
+          const double apk = matrix[p * dimension + k];
+          const double aqk = matrix[q * dimension + k];
+          matrix[p * dimension + k] = c * apk - s * aqk;
+          matrix[q * dimension + k] = s * apk + c * aqk;
+        }
+        for (size_t k = 0; k < dimension; ++k) {
+          const double vkp = eigenVectors[k * dimension + p];
+          const double vkq = eigenVectors[k * dimension + q];
+          eigenVectors[k * dimension + p] = c * vkp - s * vkq;
+          eigenVectors[k * dimension + q] = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+
+  for (size_t i = 0; i < dimension; ++i) {
+    eigenValuesSqrt[i] = std::sqrt(std::max(matrix[i * dimension + i], 1e-20));
+  }
+}
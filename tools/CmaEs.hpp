@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "utils/GameRandom.hpp"
+
+// Covariance matrix adaptation evolution strategy, the (mu/mu_w, lambda) variant of Hansen's tutorial with
+// rank-one and rank-mu updates and cumulative step-size control. Minimises a noisy black-box loss through
+// ask (sample) and tell (update). Normal draws come from Box-Muller over Xoshiro256 rather than
+// std::normal_distribution, whose output differs between standard libraries, so a seed reproduces a run.
+class CmaEs {
+public:
+  using Vector = std::vector<double>;
+
+  CmaEs(const Vector& initialMean, double initialSigma, int populationSize, uint64_t seed);
+
+  const std::vector<Vector>& sample();
+  // losses in the order of the last sample()
+  void update(const std::vector<double>& losses);
+
+  [[nodiscard]] const Vector& getMean() const { return mean; }
+  [[nodiscard]] double getSigma() const { return sigma; }
+  [[nodiscard]] int getGeneration() const { return generation; }
+
+private:
+  size_t dimension;
+  int lambda;
+  int mu;
+  Vector weights;
+  double muEffective = 0.0;
+  double cc = 0.0;
+  double cs = 0.0;
+  double c1 = 0.0;
+  double cmu = 0.0;
+  double damps = 0.0;
+  double chiN = 0.0;
+
+  Vector mean;
+  double sigma;
+  Vector pathC;
+  Vector pathSigma;
+  // row-major dimension x dimension; C = B * diag(D^2) * B^T
+  Vector covariance;
+  Vector eigenVectors;
+  Vector eigenValuesSqrt;
+
+  std::vector<Vector> population;
+  std::vector<Vector> steps;
+  int generation = 0;
+  Xoshiro256 random;
+
+  double nextGaussian();
+  void decompose();
+};
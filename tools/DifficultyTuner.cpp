@@ -0,0 +1,401 @@
+// Tunes the difficulty presets against survival targets. A bot player (the autopilot, with its inputs delayed
+// by a human-like reaction time) plays batches of games on every core; CMA-ES searches the gameplay parameters
+// of each level until the median survival meets the level's target, with a pull towards the current preset
+// since one target leaves most parameters free. The result is written as DifficultyPresets.hpp. Game seeds
+// and the search are derived from --seed and results are collected by index, so a run reproduces exactly on
+// any thread count. Run from the repository root:
+//
+//   difficulty_tuner [--seed N] [--games N] [--generations N] [--population N] [--threads N]
+//                    [--reaction-ms N] [--max-seconds N] [--target level=seconds]... [--output path]
+//   difficulty_tuner --evaluate     survival quantiles of the current presets, nothing written
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CmaEs.hpp"
+#include "utils/autopilot/Autopilot.hpp"
+#include "utils/difficulty/DifficultyPresets.hpp"
+#include "utils/replay/ReplayPlayer.hpp"
+
+namespace {
+constexpr size_t LEVEL_COUNT = DIFFICULTY_PRESETS.size();
+constexpr std::array<const char*, LEVEL_COUNT> LEVEL_NAMES = {"easy", "harder-than-easy", "middle",
+                                                             "harder-than-middle", "hard"};
+constexpr std::array<const char*, LEVEL_COUNT> LEVEL_IDENTIFIERS = {"Easy", "HarderThanEasy", "Middle",
+                                                                   "HarderThanMiddle", "Hard"};
+constexpr std::array<double, LEVEL_COUNT> DEFAULT_TARGET_SECONDS = {90.0, 70.0, 55.0, 40.0, 30.0};
+
+constexpr double INITIAL_SIGMA = 0.15;
+constexpr double PRIOR_WEIGHT = 0.05;
+constexpr double BOUNDARY_WEIGHT = 10.0;
+constexpr int VALIDATION_GAMES_FACTOR = 4;
+
+struct ParameterRange {
+  const char* name;
+  double min;
+  double max;
+};
+
+// the searched parameters; score and effect-duration multipliers are a design choice and stay as they are
+constexpr std::array<ParameterRange, 13> PARAMETERS = {{
+    {"baseSnakeSpeed", 2.0, 14.0},
+    {"speedIncreaseRate", 0.0, 1.5},
+    {"speedIncreaseInterval", 2.0, 12.0},
+    {"itemSpawnInterval", 1.0, 8.0},
+    {"maxItemsOnBoard", 1.0, 10.0},
+    {"appleLifetimeMultiplier", 0.3, 2.5},
+    {"specialItemChance", 0.0, 1.0},
+    {"redAppleWeight", 0.02, 1.0},
+    {"greenAppleWeight", 0.02, 1.0},
+    {"waterBubbleWeight", 0.02, 1.0},
+    {"fantomAppleWeight", 0.02, 1.0},
+    {"wallCount", 0.0, 12.0},
+    {"wallDensity", 0.0, 0.3},
+}};
+
+struct Options {
+  uint64_t seed = 1;
+  int games = 32;
+  int generations = 25;
+  int population = 12;
+  unsigned threads = 0;
+  int reactionMs = 100;
+  int maxSeconds = 600;
+  std::array<double, LEVEL_COUNT> targets = DEFAULT_TARGET_SECONDS;
+  std::string output = "src/utils/difficulty/DifficultyPresets.hpp";
+  bool evaluateOnly = false;
+};
+
+struct LevelResult {
+  DifficultyPreset preset;
+  double medianSeconds = 0.0;
+  int games = 0;
+};
+
+double roundTo(double value, double step) {
+  return std::round(value / step) * step;
+}
+
+double toUnit(double value, const ParameterRange& range) {
+  return (value - range.min) / (range.max - range.min);
+}
+
+double fromUnit(double unit, const ParameterRange& range) {
+  return range.min + std::clamp(unit, 0.0, 1.0) * (range.max - range.min);
+}
+
+CmaEs::Vector encode(const DifficultyPreset& preset) {
+  const std::array<double, PARAMETERS.size()> values = {preset.baseSnakeSpeed,
+                                                         preset.speedIncreaseRate,
+                                                         preset.speedIncreaseInterval,
+                                                         preset.itemSpawnInterval,
+                                                         static_cast<double>(preset.maxItemsOnBoard),
+                                                         preset.appleLifetimeMultiplier,
+                                                         preset.specialItemChance,
+                                                         preset.redAppleChance,
+                                                         preset.greenAppleChance,
+                                                         preset.waterBubbleChance,
+                                                         preset.fantomAppleChance,
+                                                         static_cast<double>(preset.wallCount),
+                                                         preset.wallDensity};
+  CmaEs::Vector unit(PARAMETERS.size());
+  for (size_t i = 0; i < PARAMETERS.size(); ++i) {
+    unit[i] = toUnit(values[i], PARAMETERS[i]);
+  }
+  return unit;
+}
+
+// rounded to what the generated header prints, so the games measure exactly the preset that gets written
+DifficultyPreset decode(const CmaEs::Vector& unit, const DifficultyPreset& base) {
+  std::array<double, PARAMETERS.size()> values{};
+  for (size_t i = 0; i < PARAMETERS.size(); ++i) {
+    values[i] = fromUnit(unit[i], PARAMETERS[i]);
+  }
+
+  DifficultyPreset preset = base;
+  preset.baseSnakeSpeed = static_cast<float>(roundTo(values[0], 0.001));
+  preset.speedIncreaseRate = static_cast<float>(roundTo(values[1], 0.001));
+  preset.speedIncreaseInterval = static_cast<float>(roundTo(values[2], 0.001));
+  preset.itemSpawnInterval = static_cast<float>(roundTo(values[3], 0.001));
+  preset.maxItemsOnBoard = static_cast<uint8_t>(std::lround(values[4]));
+  preset.appleLifetimeMultiplier = static_cast<float>(roundTo(values[5], 0.001));
+  preset.specialItemChance = static_cast<float>(roundTo(values[6], 0.001));
+
+  const double weightSum = values[7] + values[8] + values[9] + values[10];
+  const double red = roundTo(values[7] / weightSum, 0.001);
+  const double green = roundTo(values[8] / weightSum, 0.001);
+  const double water = roundTo(values[9] / weightSum, 0.001);
+  preset.redAppleChance = static_cast<float>(red);
+  preset.greenAppleChance = static_cast<float>(green);
+  preset.waterBubbleChance = static_cast<float>(water);
+  preset.fantomAppleChance = static_cast<float>(roundTo(1.0 - red - green - water, 0.001));
+
+  preset.wallCount = static_cast<uint8_t>(std::lround(values[11]));
+  preset.wallDensity = static_cast<float>(roundTo(values[12], 0.001));
+  return preset;
+}
+
+uint64_t gameSeed(uint64_t runSeed, size_t level, int generation, int game) {
+  uint64_t state = runSeed ^ (static_cast<uint64_t>(level) << 56) ^ (static_cast<uint64_t>(generation) << 24) ^
+                   static_cast<uint64_t>(game);
+  return Xoshiro256::splitMix64(state);
+}
+
+// gameplay seconds until the bot died, or maxSeconds if it never did
+double playGame(const DifficultySettings& settings, GameDifficultyLevel level, uint64_t seed, const Options& options) {
+  SimulationConfig config;
+  config.seed = seed;
+  config.difficulty = level;
+  config.countdownSeconds = 0;
+
+  GameSimulation simulation(config, settings);
+  Autopilot autopilot(GameSimulation::GRID_COLS, GameSimulation::GRID_ROWS);
+  const auto reactionTicks = static_cast<uint32_t>(options.reactionMs * GameSimulation::TICKS_PER_SECOND / 1000);
+  const auto maxTicks = static_cast<uint32_t>(options.maxSeconds * GameSimulation::TICKS_PER_SECOND);
+
+  std::deque<ReplayEvent> pending;
+  while (!simulation.isGameOver() && simulation.getTick() < maxTicks) {
+    if (const auto input = autopilot.update(simulation)) {
+      pending.push_back(ReplayEvent{simulation.getTick() + reactionTicks, *input});
+    }
+    while (!pending.empty() && pending.front().tick <= simulation.getTick()) {
+      ReplayPlayer::applyInput(simulation, pending.front().input);
+      pending.pop_front();
+    }
+    simulation.tick();
+  }
+  return simulation.getGameplaySeconds();
+}
+
+// plays games for every preset on all threads; results[preset][game]
+std::vector<std::vector<double>> playGames(const std::vector<DifficultyPreset>& presets, GameDifficultyLevel level,
+                                           const std::vector<uint64_t>& seeds, const Options& options) {
+  std::vector<DifficultySettings> settings(presets.size());
+  for (size_t i = 0; i < presets.size(); ++i) {
+    settings[i].applyPreset(presets[i]);
+  }
+
+  std::vector<std::vector<double>> results(presets.size(), std::vector<double>(seeds.size()));
+  const size_t taskCount = presets.size() * seeds.size();
+  std::atomic<size_t> nextTask = 0;
+  const auto work = [&] {
+    for (size_t task = nextTask++; task < taskCount; task = nextTask++) {
+      const size_t preset = task / seeds.size();
+      const size_t game = task % seeds.size();
+      results[preset][game] = playGame(settings[preset], level, seeds[game], options);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < options.threads; ++i) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return results;
+}
+
+double quantile(std::vector<double> values, double q) {
+  std::sort(values.begin(), values.end());
+  const double position = q * static_cast<double>(values.size() - 1);
+  const auto lower = static_cast<size_t>(position);
+  const size_t upper = std::min(lower + 1, values.size() - 1);
+  return values[lower] + (values[upper] - values[lower]) * (position - static_cast<double>(lower));
+}
+
+void printSurvival(const char* name, const std::vector<double>& seconds) {
+  std::printf("%-20s p10 %6.1f  p25 %6.1f  median %6.1f  p75 %6.1f  p90 %6.1f s\n", name, quantile(seconds, 0.1),
+              quantile(seconds, 0.25), quantile(seconds, 0.5), quantile(seconds, 0.75), quantile(seconds, 0.9));
+}
+
+double computeLoss(const CmaEs::Vector& unit, const CmaEs::Vector& start, double medianSeconds, double target) {
+  const double miss = std::log(std::max(medianSeconds, 1.0) / target);
+  double prior = 0.0;
+  double boundary = 0.0;
+  for (size_t i = 0; i < unit.size(); ++i) {
+    const double clamped = std::clamp(unit[i], 0.0, 1.0);
+    prior += (clamped - start[i]) * (clamped - start[i]);
+    boundary += (unit[i] - clamped) * (unit[i] - clamped);
+  }
+  return miss * miss + PRIOR_WEIGHT * prior / static_cast<double>(unit.size()) + BOUNDARY_WEIGHT * boundary;
+}
+
+LevelResult tuneLevel(size_t level, const Options& options) {
+  const auto difficulty = static_cast<GameDifficultyLevel>(level);
+  const DifficultyPreset& current = DIFFICULTY_PRESETS[level];
+  const CmaEs::Vector start = encode(current);
+  const double target = options.targets[level];
+  CmaEs search(start, INITIAL_SIGMA, options.population, gameSeed(options.seed, level, -1, 0));
+
+  for (int generation = 0; generation < options.generations; ++generation) {
+    std::vector<uint64_t> seeds;
+    for (int game = 0; game < options.games; ++game) {
+      seeds.push_back(gameSeed(options.seed, level, generation, game));
+    }
+
+    const auto& candidates = search.sample();
+    std::vector<DifficultyPreset> presets;
+    for (const auto& candidate : candidates) {
+      presets.push_back(decode(candidate, current));
+    }
+    const auto survival = playGames(presets, difficulty, seeds, options);
+
+    std::vector<double> losses;
+    double bestMedian = 0.0;
+    double bestLoss = INFINITY;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+      const double median = quantile(survival[i], 0.5);
+      losses.push_back(computeLoss(candidates[i], start, median, target));
+      if (losses.back() < bestLoss) {
+        bestLoss = losses.back();
+        bestMedian = median;
+      }
+    }
+    search.update(losses);
+    std::printf("%-20s generation %3d: best median %6.1f s (target %.0f), loss %.4f, sigma %.3f\n", LEVEL_NAMES[level],
+                generation, bestMedian, target, bestLoss, search.getSigma());
+  }
+
+  // the final mean is checked on games none of the generations saw
+  std::vector<uint64_t> seeds;
+  for (int game = 0; game < options.games * VALIDATION_GAMES_FACTOR; ++game) {
+    seeds.push_back(gameSeed(options.seed, level, options.generations, game));
+  }
+  LevelResult result;
+  result.preset = decode(search.getMean(), current);
+  const auto survival = playGames({result.preset}, difficulty, seeds, options);
+  result.medianSeconds = quantile(survival[0], 0.5);
+  result.games = static_cast<int>(seeds.size());
+  printSurvival(LEVEL_NAMES[level], survival[0]);
+  return result;
+}
+
+void evaluateCurrent(const Options& options) {
+  std::vector<uint64_t> seeds;
+  for (int game = 0; game < options.games * VALIDATION_GAMES_FACTOR; ++game) {
+    seeds.push_back(gameSeed(options.seed, 0, 0, game));
+  }
+  for (size_t level = 0; level < LEVEL_COUNT; ++level) {
+    const auto survival =
+        playGames({DIFFICULTY_PRESETS[level]}, static_cast<GameDifficultyLevel>(level), seeds, options);
+    printSurvival(LEVEL_NAMES[level], survival[0]);
+  }
+}
+
+bool writeHeader(const std::array<LevelResult, LEVEL_COUNT>& results, const Options& options) {
+  std::ofstream file(options.output, std::ios::trunc);
+  if (!file.is_open()) {
+    std::fprintf(stderr, "cannot write %s\n", options.output.c_str());
+    return false;
+  }
+
+  char line[256];
+  file << "#pragma once\n#include <array>\n#include \"DifficultySettings.hpp\"\n\n";
+  file << "// Generated by difficulty_tuner; rerun it with new targets rather than editing the numbers by hand.\n";
+  std::snprintf(line, sizeof(line),
+                "// --seed %llu --games %d --generations %d --population %d --reaction-ms %d --max-seconds %d\n\n",
+                static_cast<unsigned long long>(options.seed), options.games, options.generations, options.population,
+                options.reactionMs, options.maxSeconds);
+  file << line;
+  file << "// indexed by GameDifficultyLevel\n";
+  file << "inline constexpr std::array<DifficultyPreset, " << LEVEL_COUNT << "> DIFFICULTY_PRESETS = {{\n";
+  for (size_t level = 0; level < LEVEL_COUNT; ++level) {
+    const DifficultyPreset& p = results[level].preset;
+    std::snprintf(line, sizeof(line), "    // %s: median survival %.1f s over %d games, target %.0f s\n",
+                  LEVEL_IDENTIFIERS[level], results[level].medianSeconds, results[level].games,
+                  options.targets[level]);
+    file << line;
+    std::snprintf(line, sizeof(line),
+                  "    {%.3ff, %.3ff, %.3ff, %.3ff, %d, %.3ff, %.3ff, %.3ff, %.3ff, %.3ff, %.3ff, %d, %.3ff, %.3ff, "
+                  "%.3ff},\n",
+                  p.baseSnakeSpeed, p.speedIncreaseRate, p.speedIncreaseInterval, p.itemSpawnInterval,
+                  p.maxItemsOnBoard, p.appleLifetimeMultiplier, p.specialItemChance, p.redAppleChance,
+                  p.greenAppleChance, p.waterBubbleChance, p.fantomAppleChance, p.wallCount, p.wallDensity,
+                  p.scoreMultiplier, p.effectDurationMultiplier);
+    file << line;
+  }
+  file << "}};\n";
+  return static_cast<bool>(file.flush());
+}
+
+bool parseTarget(const std::string& argument, Options& options) {
+  const size_t separator = argument.find('=');
+  if (separator == std::string::npos) {
+    return false;
+  }
+  const std::string name = argument.substr(0, separator);
+  for (size_t level = 0; level < LEVEL_COUNT; ++level) {
+    if (name == LEVEL_NAMES[level]) {
+      options.targets[level] = std::stod(argument.substr(separator + 1));
+      return options.targets[level] > 0.0;
+    }
+  }
+  return false;
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const std::string flag = argv[i];
+    if (flag == "--evaluate") {
+      options.evaluateOnly = true;
+      continue;
+    }
+    if (i + 1 == argc) {
+      return false;
+    }
+    const std::string value = argv[++i];
+    if (flag == "--seed") {
+      options.seed = std::stoull(value);
+    } else if (flag == "--games") {
+      options.games = std::max(1, std::stoi(value));
+    } else if (flag == "--generations") {
+      options.generations = std::max(1, std::stoi(value));
+    } else if (flag == "--population") {
+      options.population = std::max(4, std::stoi(value));
+    } else if (flag == "--threads") {
+      options.threads = static_cast<unsigned>(std::stoul(value));
+    } else if (flag == "--reaction-ms") {
+      options.reactionMs = std::max(0, std::stoi(value));
+    } else if (flag == "--max-seconds") {
+      options.maxSeconds = std::max(1, std::stoi(value));
+    } else if (flag == "--output") {
+      options.output = value;
+    } else if (flag != "--target" || !parseTarget(value, options)) {
+      return false;
+    }
+  }
+  if (options.threads == 0) {
+    options.threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  return true;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::fprintf(stderr, "usage: difficulty_tuner [--evaluate] [--seed N] [--games N] [--generations N] "
+                         "[--population N] [--threads N] [--reaction-ms N] [--max-seconds N] "
+                         "[--target level=seconds]... [--output path]\n");
+    return 2;
+  }
+
+  if (options.evaluateOnly) {
+    evaluateCurrent(options);
+    return 0;
+  }
+
+  std::array<LevelResult, LEVEL_COUNT> results;
+  for (size_t level = 0; level < LEVEL_COUNT; ++level) {
+    results[level] = tuneLevel(level, options);
+  }
+  return writeHeader(results, options) ? 0 : 1;
+}